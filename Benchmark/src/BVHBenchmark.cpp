@@ -0,0 +1,115 @@
+#include "Benchmark.h"
+
+#include <random>
+#include <vector>
+#include <cstdint>
+
+#include "Scene/Bounds.h"
+#include "Scene/Frustum.h"
+#include "Scene/FrustumCuller.h"
+#include "Scene/BVH.h"
+
+namespace {
+  constexpr std::size_t objectCount   = 100000;
+  constexpr std::size_t buildCount    = 10;
+  constexpr std::size_t refitCount    = 50;
+  constexpr std::size_t movedPerFrame = 1000;
+  constexpr std::size_t queryCount    = 200;
+  constexpr std::size_t rayCount      = 100000;
+}
+
+void RunBVHBenchmark()
+{
+  // movement and rays
+  std::mt19937 random{ 1338 };
+  std::uniform_real_distribution<float> position{ -fixtureWorldExtent, fixtureWorldExtent };
+  std::uniform_real_distribution<float> jitter{ -1.0f, 1.0f };
+
+  std::vector<AABB> bounds = RandomAABBs(objectCount, 1337);
+  std::vector<std::uint32_t> objects(objectCount);
+  std::vector<BVH::Handle> handles(objectCount);
+  AABBArray boxes{};
+  boxes.Reserve(objectCount);
+  for (std::size_t i = 0; i < objectCount; ++i)
+  {
+    objects[i] = static_cast<std::uint32_t>(i);
+    boxes.Add(bounds[i]);
+  }
+
+  BVH bvh{};
+  Measure("BVH SAH build 100k", buildCount, [&](std::size_t)
+  {
+    bvh.Build(bounds.data(), objects.data(), objectCount, handles.data());
+  });
+
+  BVH::Statistics statistics = bvh.GetStatistics();
+  Logger::Instance(std::cout).Log() << "[BENCH] BVH SAH build 100k : depth " << statistics.maxDepth << ", SAH cost " << statistics.sahCost;
+
+  Measure("BVH SetBounds all + Refit 100k", refitCount, [&](std::size_t)
+  {
+    for (std::size_t i = 0; i < objectCount; ++i)
+    {
+      glm::vec3 offset{ jitter(random), jitter(random), jitter(random) };
+      bvh.SetBounds(handles[i], AABB{ bounds[i].min + offset, bounds[i].max + offset });
+    }
+    bvh.Refit();
+  });
+
+  Measure("BVH Update 1k moving of 100k", refitCount, [&](std::size_t)
+  {
+    for (std::size_t i = 0; i < movedPerFrame; ++i)
+    {
+      std::size_t index = random() % objectCount;
+      glm::vec3 offset{ jitter(random) * 10.0f, jitter(random) * 10.0f, jitter(random) * 10.0f };
+      bvh.Update(handles[index], AABB{ bounds[index].min + offset, bounds[index].max + offset });
+    }
+  });
+
+  Measure("BVH Remove + Insert 1k of 100k", refitCount, [&](std::size_t)
+  {
+    for (std::size_t i = 0; i < movedPerFrame; ++i)
+    {
+      std::size_t index = random() % objectCount;
+      bvh.Remove(handles[index]);
+      handles[index] = bvh.Insert(bounds[index], objects[index]);
+    }
+  });
+
+  statistics = bvh.GetStatistics();
+  Logger::Instance(std::cout).Log() << "[BENCH] BVH after incremental updates : depth " << statistics.maxDepth << ", SAH cost " << statistics.sahCost;
+
+  Frustum frustum = TestFrustum();
+
+  std::vector<std::uint32_t> visible{};
+  visible.reserve(objectCount);
+  Measure("BVH frustum query 100k", queryCount, [&](std::size_t)
+  {
+    visible.clear();
+    bvh.Query(frustum, visible);
+  });
+  Logger::Instance(std::cout).Log() << "[BENCH] BVH frustum query 100k : " << visible.size() << " visible";
+
+  // brute force reference over the same boxes
+  std::vector<std::uint8_t> visibleFlags(objectCount);
+  std::vector<std::uint32_t> indices(objectCount);
+  Measure("CullAABBs + CompactVisible 100k", queryCount, [&](std::size_t)
+  {
+    CullAABBs(frustum, boxes, 0, objectCount, visibleFlags.data());
+    CompactVisible(visibleFlags.data(), 0, objectCount, indices.data());
+  });
+
+  std::vector<Ray> rays(rayCount);
+  for (Ray& ray : rays)
+  {
+    ray.origin    = glm::vec3{ position(random), position(random), position(random) };
+    ray.direction = glm::normalize(glm::vec3{ jitter(random), jitter(random), jitter(random) });
+  }
+
+  std::size_t hits = 0;
+  Measure("BVH raycast 100k", rayCount, [&](std::size_t i)
+  {
+    BVH::RayHit hit{};
+    hits += bvh.Raycast(rays[i], 2.0f * fixtureWorldExtent, hit);
+  });
+  Logger::Instance(std::cout).Log() << "[BENCH] BVH raycast 100k : " << hits << " hits";
+}
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <chrono>
+#include <random>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include "Logging/Logger.h"
+
+#include "Scene/Bounds.h"
+#include "Scene/Frustum.h"
+
+struct BenchmarkResult {
+  const char* name                = nullptr;
+  std::size_t iterations          = 0;
+  double totalMilliseconds        = 0.0;
+  double nanosecondsPerIteration  = 0.0;
+};
+
+// runs body(i) for iterations / 10 warm up rounds, then times iterations rounds
+template <typename Body>
+BenchmarkResult Measure(const char* name, std::size_t iterations, Body&& body)
+{
+  for (std::size_t i = 0; i < iterations / 10; ++i)
+  {
+    body(i);
+  }
+
+  auto start = std::chrono::steady_clock::now();
+  for (std::size_t i = 0; i < iterations; ++i)
+  {
+    body(i);
+  }
+  auto end = std::chrono::steady_clock::now();
+
+  BenchmarkResult result{};
+  result.name                    = name;
+  result.iterations              = iterations;
+  result.totalMilliseconds       = std::chrono::duration<double, std::milli>(end - start).count();
+  result.nanosecondsPerIteration = result.totalMilliseconds * 1.0e6 / static_cast<double>(iterations);
+
+  Logger::Instance(std::cout).Log()
+    << "[BENCH] " << name << " : " << result.nanosecondsPerIteration << " ns/iteration ("
+    << iterations << " iterations, " << result.totalMilliseconds << " ms)";
+  return result;
+}
+
+// FIXTURES, the culling suites share one scene so their numbers compare
+constexpr float fixtureWorldExtent = 500.0f;
+
+// boxes centered anywhere in the world cube, half extents between 0.25 and 4, the same for the same seed
+inline std::vector<AABB> RandomAABBs(std::size_t count, std::uint32_t seed)
+{
+  std::mt19937 random{ seed };
+  std::uniform_real_distribution<float> position{ -fixtureWorldExtent, fixtureWorldExtent };
+  std::uniform_real_distribution<float> extent{ 0.25f, 4.0f };
+
+  std::vector<AABB> boxes(count);
+  for (AABB& box : boxes)
+  {
+    glm::vec3 center{ position(random), position(random), position(random) };
+    glm::vec3 halfExtent{ extent(random), extent(random), extent(random) };
+    box = AABB{ center - halfExtent, center + halfExtent };
+  }
+  return boxes;
+}
+
+// from the origin into the world cube, reaching its far side
+inline Frustum TestFrustum()
+{
+  glm::mat4 projection = glm::perspective(glm::radians(45.0f), 16.0f / 9.0f, 0.1f, fixtureWorldExtent);
+  glm::mat4 view       = glm::lookAt(glm::vec3{ 0.0f }, glm::vec3{ 1.0f, 0.2f, -1.0f }, glm::vec3{ 0.0f, 1.0f, 0.0f });
+  return Frustum::FromMatrix(projection * view);
+}
+
+// SUITES
+void RunErrorCheckBenchmark();
+void RunCullingBenchmark();
+void RunBVHBenchmark();
+void RunOcclusionBenchmark();
+void RunTransformBenchmark();
+void RunJobBenchmark();
+void RunProfilerBenchmark();
+void RunStreamingBenchmark();
@@ -0,0 +1,74 @@
+#include "Benchmark.h"
+
+#include <algorithm>
+#include <vector>
+#include <cstdint>
+
+#include "Scene/Bounds.h"
+#include "Scene/Frustum.h"
+#include "Scene/FrustumCuller.h"
+
+namespace {
+  constexpr std::size_t boxCount  = 1000000;
+  constexpr std::size_t cullCount = 50;
+}
+
+void RunCullingBenchmark()
+{
+  AABBArray boxes{};
+  SphereArray spheres{};
+  boxes.Reserve(boxCount);
+  spheres.Reserve(boxCount);
+  for (const AABB& box : RandomAABBs(boxCount, 1337))
+  {
+    glm::vec3 halfExtent = 0.5f * (box.max - box.min);
+    boxes.Add(box);
+    spheres.Add(BoundingSphere{ box.min + halfExtent, glm::length(halfExtent) });
+  }
+
+  Frustum frustum = TestFrustum();
+
+  std::vector<std::uint8_t> visible(boxCount);
+  std::vector<std::uint32_t> indices(boxCount);
+
+  const std::pair<CullKernel, const char*> kernels[]{
+    { CullKernel::SCALAR, "CullAABBs 1M, SCALAR" },
+    { CullKernel::SSE,    "CullAABBs 1M, SSE"    },
+    { CullKernel::AVX2,   "CullAABBs 1M, AVX2"   },
+  };
+
+  for (const auto& kernel : kernels)
+  {
+    if (kernel.first == CullKernel::AVX2 && GetBestCullKernel() != CullKernel::AVX2)
+    {
+      Logger::Instance(std::cout).Log() << "[BENCH] " << kernel.second << " : not supported by this CPU";
+      continue;
+    }
+
+    Measure(kernel.second, cullCount, [&](std::size_t)
+    {
+      CullAABBs(frustum, boxes, 0, boxCount, visible.data(), kernel.first);
+    });
+    Logger::Instance(std::cout).Log() << "[BENCH] " << kernel.second << " : " << CompactVisible(visible.data(), 0, boxCount, indices.data()) << " visible";
+  }
+
+  Measure("CullSpheres 1M, AUTO", cullCount, [&](std::size_t)
+  {
+    CullSpheres(frustum, spheres, 0, boxCount, visible.data());
+  });
+
+  // the culler writes disjoint ranges, chunking is what a job system would hand to each worker
+  Measure("CullAABBs 1M, AUTO, 64 chunks", cullCount, [&](std::size_t)
+  {
+    constexpr std::size_t chunkSize = boxCount / 64;
+    for (std::size_t begin = 0; begin < boxCount; begin += chunkSize)
+    {
+      CullAABBs(frustum, boxes, begin, std::min(begin + chunkSize, boxCount), visible.data());
+    }
+  });
+
+  Measure("CompactVisible 1M", cullCount, [&](std::size_t)
+  {
+    CompactVisible(visible.data(), 0, boxCount, indices.data());
+  });
+}
@@ -0,0 +1,57 @@
+#include "Benchmark.h"
+
+#include <GL/glew.h>
+#include <GLFW/glfw3.h>
+
+#include "Core/Core.h"
+#include "Core/Window.h"
+
+namespace {
+  constexpr std::size_t callCount      = 1000000;
+  constexpr std::size_t callsPerFrame  = 1000;
+}
+
+void RunErrorCheckBenchmark()
+{
+  Window window{ "Benchmark", 64, 64 };
+  window.SetHint(GLFW_VISIBLE, GLFW_FALSE);
+  window.Initialize();
+
+  unsigned int buffers[2]{};
+  glGenBuffers(2, buffers);
+
+  // alternate between two buffers so the driver cannot drop the bind as redundant
+  Measure("glBindBuffer, no CALL", callCount, [&](std::size_t i)
+  {
+    glBindBuffer(GL_ARRAY_BUFFER, buffers[i & 1]);
+  });
+
+  const std::pair<ErrorCheckMode, const char*> modes[]{
+    { ErrorCheckMode::OFF,          "CALL(glBindBuffer), OFF"          },
+    { ErrorCheckMode::PER_FRAME,    "CALL(glBindBuffer), PER_FRAME"    },
+    { ErrorCheckMode::PER_CALL,     "CALL(glBindBuffer), PER_CALL"     },
+    { ErrorCheckMode::DEBUG_OUTPUT, "CALL(glBindBuffer), DEBUG_OUTPUT" },
+  };
+
+  for (const auto& mode : modes)
+  {
+    if (SetErrorCheckMode(mode.first) != mode.first)
+    {
+      Logger::Instance(std::cout).Log() << "[BENCH] " << mode.second << " : not available in this build";
+      continue;
+    }
+
+    Measure(mode.second, callCount, [&](std::size_t i)
+    {
+      CALL(glBindBuffer(GL_ARRAY_BUFFER, buffers[i & 1]));
+      if (i % callsPerFrame == callsPerFrame - 1)
+      {
+        CheckFrameErrors();
+      }
+    });
+  }
+
+  SetErrorCheckMode(ErrorCheckMode::OFF);
+  glBindBuffer(GL_ARRAY_BUFFER, 0);
+  glDeleteBuffers(2, buffers);
+}
@@ -0,0 +1,89 @@
+#include "Benchmark.h"
+
+#include <cmath>
+#include <string>
+#include <vector>
+#include <thread>
+#include <cstdint>
+
+#include "Jobs/JobSystem.h"
+
+#include "Scene/Bounds.h"
+#include "Scene/Frustum.h"
+#include "Scene/FrustumCuller.h"
+
+namespace {
+  constexpr std::size_t jobsPerBatch  = 1024;
+  constexpr std::size_t batchCount    = 200;
+  constexpr std::size_t workloadSize  = 4 * 1024 * 1024;
+  constexpr std::size_t workloadCount = 20;
+  constexpr std::size_t boxCount      = 1000000;
+}
+
+void RunJobBenchmark()
+{
+  std::vector<float> workload(workloadSize);
+  for (std::size_t i = 0; i < workloadSize; ++i)
+  {
+    workload[i] = static_cast<float>(i % 1000);
+  }
+
+  AABBArray boxes{};
+  boxes.Reserve(boxCount);
+  for (const AABB& box : RandomAABBs(boxCount, 1337))
+  {
+    boxes.Add(box);
+  }
+  std::vector<std::uint8_t> visible(boxCount);
+  Frustum frustum = TestFrustum();
+
+  const unsigned int hardwareThreads = std::max(1u, std::thread::hardware_concurrency());
+  for (unsigned int workers = 1; workers <= hardwareThreads; workers *= 2)
+  {
+    JobSystem& jobs = JobSystem::Instance();
+    if (workers > 1)
+    {
+      jobs.Initialize(workers - 1);
+    }
+
+    const std::string suffix = ", " + std::to_string(workers) + " workers";
+
+    std::string name = "Run + Wait " + std::to_string(jobsPerBatch) + " empty jobs" + suffix;
+    BenchmarkResult empty = Measure(name.c_str(), batchCount, [&](std::size_t)
+    {
+      JobCounter counter{};
+      for (std::size_t i = 0; i < jobsPerBatch; ++i)
+      {
+        jobs.Run([]() {}, &counter);
+      }
+      jobs.Wait(counter);
+    });
+    Logger::Instance(std::cout).Log() << "[BENCH] " << name << " : " << empty.nanosecondsPerIteration / jobsPerBatch << " ns/job";
+
+    name = "ParallelFor sqrt 4M" + suffix;
+    float sink = 0.0f;
+    Measure(name.c_str(), workloadCount, [&](std::size_t)
+    {
+      jobs.ParallelFor(workloadSize, 16 * 1024, [&](std::size_t begin, std::size_t end)
+      {
+        for (std::size_t i = begin; i < end; ++i)
+        {
+          workload[i] = std::sqrt(workload[i] * workload[i] + 1.0f);
+        }
+      });
+      sink += workload[0];
+    });
+
+    name = "CullAABBsParallel 1M" + suffix;
+    Measure(name.c_str(), workloadCount, [&](std::size_t)
+    {
+      CullAABBsParallel(frustum, boxes, visible.data());
+    });
+
+    jobs.Shutdown();
+    if (sink < 0.0f)
+    {
+      Logger::Instance(std::cout).Log() << sink;
+    }
+  }
+}
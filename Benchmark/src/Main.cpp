@@ -0,0 +1,53 @@
+#include <map>
+#include <string>
+#include <iostream>
+
+#include "Benchmark.h"
+
+#include "Logging/Logger.h"
+
+const std::map<std::string, void(*)()> suites{
+  { "errorcheck", RunErrorCheckBenchmark },
+  { "culling",    RunCullingBenchmark    },
+  { "bvh",        RunBVHBenchmark        },
+  { "occlusion",  RunOcclusionBenchmark  },
+  { "transform",  RunTransformBenchmark  },
+  { "jobs",       RunJobBenchmark        },
+  { "profiler",   RunProfilerBenchmark   },
+  { "streaming",  RunStreamingBenchmark  },
+};
+
+int main(int argc, char** argv)
+{
+  try
+  {
+    if (argc < 2)
+    {
+      for (const auto& suite : suites)
+      {
+        Logger::Instance(std::cout).Log() << "[BENCH] suite : " << suite.first;
+        suite.second();
+      }
+    }
+
+    for (int i = 1; i < argc; ++i)
+    {
+      auto it = suites.find(argv[i]);
+      if (it == std::end(suites))
+      {
+        Logger::Instance(std::cerr).Log() << "[ERROR] Unknown benchmark suite : " << argv[i];
+        return EXIT_FAILURE;
+      }
+
+      Logger::Instance(std::cout).Log() << "[BENCH] suite : " << it->first;
+      it->second();
+    }
+  }
+  catch (const std::exception& err)
+  {
+    Logger::Instance(std::cerr).Log() << err.what();
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,212 @@
+#include "Benchmark.h"
+
+#include <random>
+#include <vector>
+#include <string>
+#include <sstream>
+#include <cstdint>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include "Scene/Bounds.h"
+#include "Scene/Frustum.h"
+#include "Scene/BVH.h"
+#include "Scene/OcclusionBuffer.h"
+
+namespace {
+  constexpr int   frameCount  = 60;
+  constexpr float aspect      = 16.0f / 9.0f;
+  constexpr float nearPlane   = 0.1f;
+  constexpr float farPlane    = 300.0f;
+
+  // scenes are generated from a fixed seed so every run culls exactly the same frames
+  struct BakedScene {
+    std::string name{};
+    std::vector<AABB> occluders{};
+    std::vector<AABB> objects{};
+    glm::vec3 cameraStart{ 0.0f };
+    glm::vec3 cameraEnd{ 0.0f };
+    glm::vec3 cameraDirection{ 0.0f, 0.0f, -1.0f };
+    // checked against the first frame, one box in the open and one right behind an occluder
+    AABB visibleProbe{};
+    AABB occludedProbe{};
+  };
+
+  AABB Box(glm::vec3 center, glm::vec3 halfExtent)
+  {
+    return AABB{ center - halfExtent, center + halfExtent };
+  }
+
+  // a corridor along -z lined with solid walls, rooms full of props on both sides
+  BakedScene BakeCorridor()
+  {
+    BakedScene scene{};
+    scene.name = "corridor";
+
+    std::mt19937 random{ 7 };
+    std::uniform_real_distribution<float> unit{ 0.0f, 1.0f };
+    for (int room = 0; room < 20; ++room)
+    {
+      float z = -10.0f * room - 5.0f;
+      for (float side : { -1.0f, 1.0f })
+      {
+        scene.occluders.push_back(Box(glm::vec3{ side * 2.0f, 1.5f, z }, glm::vec3{ 0.1f, 1.5f, 5.0f }));
+        for (int prop = 0; prop < 50; ++prop)
+        {
+          glm::vec3 center{ side * (3.0f + 8.0f * unit(random)), 0.25f + 2.0f * unit(random), z - 4.5f + 9.0f * unit(random) };
+          scene.objects.push_back(Box(center, glm::vec3{ 0.25f }));
+        }
+      }
+
+      // a few props in the corridor itself stay visible
+      scene.objects.push_back(Box(glm::vec3{ 0.0f, 0.25f, z }, glm::vec3{ 0.25f }));
+    }
+
+    scene.cameraStart   = glm::vec3{ 0.0f, 1.5f, 2.0f };
+    scene.cameraEnd     = glm::vec3{ 0.0f, 1.5f, -180.0f };
+    scene.visibleProbe  = Box(glm::vec3{ 0.0f, 0.25f, -5.0f }, glm::vec3{ 0.25f });
+    scene.occludedProbe = Box(glm::vec3{ 6.0f, 1.0f, -5.0f }, glm::vec3{ 0.25f });
+    return scene;
+  }
+
+  // city blocks as occluders, small props scattered over streets and rooftops
+  BakedScene BakeCity()
+  {
+    BakedScene scene{};
+    scene.name = "city";
+
+    std::mt19937 random{ 11 };
+    std::uniform_real_distribution<float> unit{ 0.0f, 1.0f };
+    for (int z = 0; z < 16; ++z)
+    {
+      for (int x = 0; x < 16; ++x)
+      {
+        glm::vec3 blockCenter{ (x - 8) * 20.0f + 10.0f, 0.0f, -z * 20.0f - 10.0f };
+        float height = 10.0f + 30.0f * unit(random);
+        scene.occluders.push_back(Box(blockCenter + glm::vec3{ 0.0f, height * 0.5f, 0.0f }, glm::vec3{ 7.0f, height * 0.5f, 7.0f }));
+
+        for (int prop = 0; prop < 40; ++prop)
+        {
+          glm::vec3 center{ blockCenter.x - 10.0f + 20.0f * unit(random), 0.5f, blockCenter.z - 10.0f + 20.0f * unit(random) };
+          scene.objects.push_back(Box(center, glm::vec3{ 0.5f }));
+        }
+      }
+    }
+
+    scene.cameraStart   = glm::vec3{ 0.0f, 1.7f, 0.0f };
+    scene.cameraEnd     = glm::vec3{ 0.0f, 1.7f, -300.0f };
+    scene.visibleProbe  = Box(glm::vec3{ 0.0f, 0.5f, -30.0f }, glm::vec3{ 0.5f });
+    scene.occludedProbe = Box(glm::vec3{ 10.0f, 0.5f, -25.0f }, glm::vec3{ 0.5f });
+    return scene;
+  }
+
+  struct FrameCounts {
+    std::size_t frustumVisible  = 0;
+    std::size_t occluded        = 0;
+    std::size_t visible         = 0;
+  };
+
+  FrameCounts CullFrame(const BakedScene& scene, const BVH& bvh, OcclusionBuffer& occlusion, int frame, std::vector<std::uint32_t>& candidates)
+  {
+    float t = static_cast<float>(frame) / (frameCount - 1);
+    glm::vec3 eye = glm::mix(scene.cameraStart, scene.cameraEnd, t);
+    glm::mat4 viewProjection = glm::perspective(glm::radians(60.0f), aspect, nearPlane, farPlane) *
+                               glm::lookAt(eye, eye + scene.cameraDirection, glm::vec3{ 0.0f, 1.0f, 0.0f });
+
+    Frustum frustum = Frustum::FromMatrix(viewProjection);
+
+    occlusion.Begin(viewProjection);
+    for (const AABB& occluder : scene.occluders)
+    {
+      if (frustum.Intersects(occluder))
+      {
+        occlusion.AddOccluder(occluder);
+      }
+    }
+    occlusion.End();
+
+    candidates.clear();
+    bvh.Query(frustum, candidates);
+
+    FrameCounts counts{};
+    counts.frustumVisible = candidates.size();
+    for (std::uint32_t object : candidates)
+    {
+      if (occlusion.IsVisible(scene.objects[object]))
+      {
+        ++counts.visible;
+      }
+      else
+      {
+        ++counts.occluded;
+      }
+    }
+    return counts;
+  }
+
+  void Check(bool condition, const BakedScene& scene, int frame, const char* message)
+  {
+    if (!condition)
+    {
+      std::ostringstream outStream{};
+      outStream << "[ERROR::BENCH] occlusion " << scene.name << " frame " << frame << " : " << message;
+      throw std::exception{ outStream.str().c_str() };
+    }
+  }
+}
+
+void RunOcclusionBenchmark()
+{
+  const BakedScene scenes[]{ BakeCorridor(), BakeCity() };
+  for (const BakedScene& scene : scenes)
+  {
+    std::vector<std::uint32_t> ids(scene.objects.size());
+    std::vector<BVH::Handle> handles(scene.objects.size());
+    for (std::size_t i = 0; i < ids.size(); ++i)
+    {
+      ids[i] = static_cast<std::uint32_t>(i);
+    }
+
+    BVH bvh{};
+    bvh.Build(scene.objects.data(), ids.data(), scene.objects.size(), handles.data());
+
+    OcclusionBuffer occlusion{};
+    std::vector<std::uint32_t> candidates{};
+
+    FrameCounts total{};
+    for (int frame = 0; frame < frameCount; ++frame)
+    {
+      FrameCounts counts = CullFrame(scene, bvh, occlusion, frame, candidates);
+      Logger::Instance(std::cout).Log()
+        << "[BENCH] occlusion " << scene.name << " frame " << frame << " : "
+        << counts.visible << " visible, " << counts.occluded << " occluded, "
+        << scene.objects.size() - counts.frustumVisible << " outside frustum, "
+        << occlusion.GetOccluderTriangleCount() << " occluder triangles";
+
+      // every frame of both scenes has objects in the open and objects behind occluders, a rasterizer or
+      // HiZ regression tends to turn one of the two counts to zero
+      Check(counts.visible > 0, scene, frame, "no object visible");
+      Check(counts.occluded > 0, scene, frame, "no object occluded");
+      if (frame == 0)
+      {
+        Check(occlusion.IsVisible(scene.visibleProbe), scene, frame, "probe in the open reported occluded");
+        Check(!occlusion.IsVisible(scene.occludedProbe), scene, frame, "probe behind an occluder reported visible");
+      }
+
+      total.frustumVisible += counts.frustumVisible;
+      total.occluded       += counts.occluded;
+      total.visible        += counts.visible;
+    }
+
+    Logger::Instance(std::cout).Log()
+      << "[BENCH] occlusion " << scene.name << " : " << scene.objects.size() << " objects, " << scene.occluders.size() << " occluders, "
+      << total.occluded * 100.0 / std::max<std::size_t>(total.frustumVisible, 1) << "% of frustum survivors occluded";
+
+    std::string name = "occlusion " + scene.name + " frame (raster + HiZ + tests)";
+    Measure(name.c_str(), frameCount, [&](std::size_t frame)
+    {
+      CullFrame(scene, bvh, occlusion, static_cast<int>(frame % frameCount), candidates);
+    });
+  }
+}
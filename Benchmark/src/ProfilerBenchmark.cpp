@@ -0,0 +1,49 @@
+#include "Benchmark.h"
+
+#include <cstdint>
+
+#include "Profiling/Profiler.h"
+
+namespace {
+  constexpr std::size_t scopeCount     = 10000000;
+  constexpr std::size_t scopesPerFrame = 16 * 1024; // drained before the ring fills up
+}
+
+void RunProfilerBenchmark()
+{
+  // ProfileScope directly, the macros may be compiled out in this configuration
+  Profiler& profiler = Profiler::Instance();
+  profiler.SetThreadName("Benchmark");
+
+  volatile std::uint64_t sink = 0;
+  Measure("Profiler::Now", scopeCount, [&](std::size_t)
+  {
+    sink = sink + Profiler::Now();
+  });
+
+  Measure("ProfileScope, empty scope", scopeCount, [&](std::size_t i)
+  {
+    { ProfileScope scope{ "Empty" };
+    }
+
+    if ((i & (scopesPerFrame - 1)) == scopesPerFrame - 1)
+    {
+      profiler.EndFrame();
+    }
+  });
+  profiler.EndFrame();
+
+  Measure("Profiler::EndFrame after 16k scopes", 100, [&](std::size_t)
+  {
+    for (std::size_t i = 0; i < scopesPerFrame; ++i)
+    {
+      ProfileScope scope{ "Empty" };
+    }
+    profiler.EndFrame();
+  });
+
+  if (profiler.GetDroppedEvents() > 0)
+  {
+    Logger::Instance(std::cerr).Log() << "[WARN::BENCH] Profiler dropped " << profiler.GetDroppedEvents() << " events";
+  }
+}
@@ -0,0 +1,139 @@
+#include "Benchmark.h"
+
+#include <string>
+#include <vector>
+#include <sstream>
+#include <cstdint>
+
+#include <GL/glew.h>
+#include <GLFW/glfw3.h>
+
+#include "Core/Window.h"
+#include "Core/Texture.h"
+#include "Core/SamplerCache.h"
+#include "Core/TextureStreamer.h"
+
+namespace {
+  constexpr int         textureCount  = 16;
+  constexpr int         textureSize   = 1024;
+  constexpr int         settleUpdates = 60;
+  constexpr std::size_t updateCount   = 60;
+  constexpr std::size_t tightBudget   = 24 * 1024 * 1024;
+  constexpr std::size_t looseBudget   = 128 * 1024 * 1024;
+
+  void Check(bool condition, const char* phase, const std::string& message)
+  {
+    if (!condition)
+    {
+      std::ostringstream outStream{};
+      outStream << "[ERROR::BENCH] streaming " << phase << " : " << message;
+      throw std::exception{ outStream.str().c_str() };
+    }
+  }
+
+  // the resident range and the Texture behind every handle have to agree, and the Texture must be the one
+  // handed out when the handle was added
+  void CheckTextures(const TextureStreamer& streamer, const std::vector<const Texture*>& textures, const char* phase)
+  {
+    for (int i = 0; i < textureCount; ++i)
+    {
+      const Texture& texture = streamer.GetTexture(i);
+      int level = streamer.GetResidentLevel(i);
+      Check(&texture == textures[i], phase, "texture " + std::to_string(i) + " was replaced");
+      Check(texture.GetWidth() == (textureSize >> level), phase, "texture " + std::to_string(i) + " storage does not match its resident level");
+    }
+  }
+}
+
+void RunStreamingBenchmark()
+{
+  Window window{ "Benchmark", 64, 64 };
+  window.SetHint(GLFW_VISIBLE, GLFW_FALSE);
+  window.Initialize();
+
+  {
+    TextureStreamer streamer{ tightBudget };
+
+    // a different checker size per texture, contents do not matter beyond being distinct
+    std::vector<unsigned char> pixels(static_cast<std::size_t>(textureSize) * textureSize * 4);
+    std::vector<const Texture*> textures{};
+    for (int i = 0; i < textureCount; ++i)
+    {
+      for (int y = 0; y < textureSize; ++y)
+      {
+        for (int x = 0; x < textureSize; ++x)
+        {
+          unsigned char value = ((x >> (i % 6 + 1)) + (y >> (i % 6 + 1))) % 2 ? 255 : 0;
+          unsigned char* texel = &pixels[(static_cast<std::size_t>(y) * textureSize + x) * 4];
+          texel[0] = value;
+          texel[1] = static_cast<unsigned char>(i * 16);
+          texel[2] = static_cast<unsigned char>(x);
+          texel[3] = 255;
+        }
+      }
+      TextureStreamer::Handle handle = streamer.Add(pixels.data(), textureSize, textureSize, 4);
+      textures.push_back(&streamer.GetTexture(handle));
+    }
+
+    // everything wants full resolution, twice what the budget holds
+    for (int update = 0; update < settleUpdates; ++update)
+    {
+      for (int i = 0; i < textureCount; ++i)
+      {
+        streamer.RequestScreenSize(i, static_cast<float>(textureSize));
+      }
+      streamer.Update();
+      TextureStreamer::Statistics statistics = streamer.GetStatistics();
+      Check(statistics.residentBytes <= statistics.budgetBytes, "tight budget", "resident bytes over budget");
+    }
+    CheckTextures(streamer, textures, "tight budget");
+
+    TextureStreamer::Statistics statistics = streamer.GetStatistics();
+    Check(statistics.residentBytes > statistics.budgetBytes / 2, "tight budget", "most of the budget left unused");
+    Check(statistics.fullyResidentCount < textureCount, "tight budget", "every texture fully resident over budget");
+    Logger::Instance(std::cout).Log()
+      << "[BENCH] streaming tight budget : " << statistics.residentBytes / 1024 << " KiB resident of " << statistics.budgetBytes / 1024
+      << " KiB budget, " << statistics.requestedBytes / 1024 << " KiB requested, " << statistics.fullyResidentCount << " fully resident";
+
+    streamer.SetBudget(looseBudget);
+    for (int update = 0; update < settleUpdates; ++update)
+    {
+      for (int i = 0; i < textureCount; ++i)
+      {
+        streamer.RequestScreenSize(i, static_cast<float>(textureSize));
+      }
+      streamer.Update();
+    }
+    CheckTextures(streamer, textures, "loose budget");
+    statistics = streamer.GetStatistics();
+    Check(statistics.fullyResidentCount == textureCount, "loose budget", "textures left below full resolution within budget");
+
+    // nothing requested, every texture decays to the levels it keeps for its lifetime in one update
+    streamer.Update();
+    CheckTextures(streamer, textures, "decay");
+    for (int i = 0; i < textureCount; ++i)
+    {
+      Check(streamer.GetResidentLevel(i) == streamer.GetRequestedLevel(i), "decay", "texture " + std::to_string(i) + " kept levels nobody requested");
+    }
+
+    // half the textures swing between full and quarter resolution every update
+    streamer.SetBudget(tightBudget);
+    Measure("TextureStreamer Update, 16 textures churning", updateCount, [&](std::size_t update)
+    {
+      for (int i = 0; i < textureCount; ++i)
+      {
+        float screenSize = i % 2 && update % 2 ? textureSize / 4.0f : static_cast<float>(textureSize);
+        streamer.RequestScreenSize(i, screenSize);
+      }
+      streamer.Update();
+    });
+    CheckTextures(streamer, textures, "churn");
+
+    statistics = streamer.GetStatistics();
+    Logger::Instance(std::cout).Log()
+      << "[BENCH] streaming churn : " << statistics.upgrades << " upgrades, " << statistics.downgrades << " downgrades, "
+      << statistics.uploadedBytes / (1024 * 1024) << " MiB uploaded in total";
+  }
+
+  SamplerCache::Instance().Dispose();
+}
@@ -0,0 +1,86 @@
+#include "Benchmark.h"
+
+#include <random>
+#include <vector>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+#include "Scene/TransformHierarchy.h"
+
+namespace {
+  constexpr std::size_t rootCount       = 1000;
+  constexpr std::size_t childrenPerRoot = 10;
+  constexpr std::size_t leavesPerChild  = 10;
+  constexpr std::size_t updateCount     = 100;
+}
+
+void RunTransformBenchmark()
+{
+  std::mt19937 random{ 1337 };
+  std::uniform_real_distribution<float> unit{ -1.0f, 1.0f };
+
+  // 1000 roots, each with 10 children of 10 leaves, 111k nodes three levels deep
+  TransformHierarchy transforms{};
+  std::vector<TransformHierarchy::Handle> roots{};
+  std::vector<TransformHierarchy::Handle> nodes{};
+  transforms.Reserve(rootCount * (1 + childrenPerRoot * (1 + leavesPerChild)));
+  for (std::size_t r = 0; r < rootCount; ++r)
+  {
+    TransformHierarchy::Handle root = transforms.Create();
+    roots.push_back(root);
+    nodes.push_back(root);
+    for (std::size_t c = 0; c < childrenPerRoot; ++c)
+    {
+      TransformHierarchy::Handle child = transforms.Create(root);
+      nodes.push_back(child);
+      for (std::size_t l = 0; l < leavesPerChild; ++l)
+      {
+        nodes.push_back(transforms.Create(child));
+      }
+    }
+  }
+
+  for (TransformHierarchy::Handle node : nodes)
+  {
+    transforms.SetPosition(node, glm::vec3{ unit(random), unit(random), unit(random) } * 10.0f);
+    transforms.SetRotation(node, glm::normalize(glm::quat{ unit(random), unit(random), unit(random), unit(random) }));
+  }
+  transforms.Update();
+
+  Logger::Instance(std::cout).Log() << "[BENCH] transform hierarchy : " << transforms.GetSize() << " nodes";
+
+  Measure("TransformHierarchy Update, all local dirty", updateCount, [&](std::size_t)
+  {
+    for (TransformHierarchy::Handle node : nodes)
+    {
+      transforms.SetPosition(node, transforms.GetPosition(node));
+    }
+    transforms.Update();
+  });
+
+  Measure("TransformHierarchy Update, roots dirty", updateCount, [&](std::size_t i)
+  {
+    for (TransformHierarchy::Handle root : roots)
+    {
+      transforms.SetRotation(root, glm::angleAxis(i * 0.01f, glm::vec3{ 0.0f, 1.0f, 0.0f }));
+    }
+    transforms.Update();
+  });
+
+  Measure("TransformHierarchy Update, 1% leaves dirty", updateCount, [&](std::size_t)
+  {
+    for (std::size_t n = 0; n < nodes.size() / 100; ++n)
+    {
+      TransformHierarchy::Handle node = nodes[random() % nodes.size()];
+      transforms.SetPosition(node, transforms.GetPosition(node) + glm::vec3{ 0.01f });
+    }
+    transforms.Update();
+  });
+  Logger::Instance(std::cout).Log() << "[BENCH] TransformHierarchy Update, 1% leaves dirty : " << transforms.GetLastWorldUpdates() << " world matrices rebuilt";
+
+  Measure("TransformHierarchy Update, clean", updateCount, [&](std::size_t)
+  {
+    transforms.Update();
+  });
+}
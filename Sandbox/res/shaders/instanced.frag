@@ -0,0 +1,51 @@
+#version 330 core
+
+const int MAX_TINTS = 8;
+
+struct Material
+{
+  sampler2D diffuse;
+  sampler2D specular;
+  float shininess;
+  vec3 tints[MAX_TINTS];
+};
+
+struct Light
+{
+  vec3 position;
+  vec3 ambient;
+  vec3 diffuse;
+  vec3 specular;
+};
+
+in vec3 _normal;
+in vec2 _texCoords;
+in vec3 _fragmentPosition;
+flat in uint _material;
+
+out vec4 color;
+
+uniform Material material;
+uniform Light light;
+uniform vec3 cameraPosition;
+
+void main()
+{
+  vec3 normal = normalize(_normal);
+  vec3 lightDirection = normalize(light.position - _fragmentPosition);
+  vec3 cameraDirection = normalize(cameraPosition - _fragmentPosition);
+  vec3 reflectedLightDirection = reflect(-lightDirection, normal);
+
+  vec3 albedo = texture(material.diffuse, _texCoords).rgb * material.tints[_material % uint(MAX_TINTS)];
+
+  vec3 ambient = light.ambient * albedo;
+
+  float diffuseImpact = max(dot(lightDirection, normal), 0.0f);
+  vec3 diffuse = light.diffuse * diffuseImpact * albedo;
+
+  float specularImpact = pow(max(dot(cameraDirection, reflectedLightDirection), 0.0f), material.shininess);
+  vec3 specular = light.specular * specularImpact * texture(material.specular, _texCoords).rgb;
+
+  vec3 result = (ambient + diffuse + specular);
+  color = vec4(result, 1.0f);
+}
\ No newline at end of file
@@ -0,0 +1,26 @@
+#version 330 core
+
+in vec3 position;
+layout (location = 1) in vec3 normal;
+layout (location = 2) in vec2 texCoords;
+layout (location = 8) in mat4 instanceModel;
+layout (location = 12) in uint instanceMaterial;
+
+out vec3 _normal;
+out vec2 _texCoords;
+out vec3 _fragmentPosition;
+flat out uint _material;
+
+uniform mat4 view;
+uniform mat4 projection;
+
+void main() 
+{
+  // instances are only translated and uniformly scaled, no inverse transpose needed
+  _normal = mat3(instanceModel) * normal;
+  _texCoords = texCoords;
+  _fragmentPosition = vec3(instanceModel * vec4(position, 1.0f));
+  _material = instanceMaterial;
+
+  gl_Position = projection * view * vec4(_fragmentPosition, 1.0f);
+}
\ No newline at end of file
@@ -6,6 +6,11 @@
 #include <GL/glew.h>
 
 #include "Core/Core.h"
+#include "Core/GLStateCache.h"
+
+#include "Profiling/Counters.h"
+
+#include "Trace/GLTrace.h"
 
 template <typename T>
 class Buffer {
@@ -21,10 +26,14 @@ public:
   void GetData(size_t size, T* data, std::ptrdiff_t offset = Buffer::defaultOffset) const;
   void GetData(std::vector<T>& buf) const;
 
-  inline void GetSize() const {
+  inline std::size_t GetSize() const {
     return m_Size;
   }
 
+  inline unsigned int GetID() const {
+    return m_ID;
+  }
+
   void Bind() const;
   void UnBind() const;
 
@@ -36,14 +45,23 @@ private:
   static constexpr std::ptrdiff_t defaultOffset = 0;
 
   unsigned int m_ID     = 0;
-  unsigned int m_Target = 0;
+  unsigned int m_Target = Buffer::defaultTarget;
   std::size_t  m_Size   = 0;
+  bool m_DirectStateAccess = false;
 };
 
 template<typename T>
 Buffer<T>::Buffer()
 {
-  CALL(glGenBuffers(1, &m_ID));
+  m_DirectStateAccess = IsDirectStateAccessEnabled();
+  if (m_DirectStateAccess)
+  {
+    CALL(glCreateBuffers(1, &m_ID));
+  }
+  else
+  {
+    CALL(glGenBuffers(1, &m_ID));
+  }
 }
 
 template<typename T>
@@ -63,6 +81,18 @@ void Buffer<T>::SetData(std::size_t size, T* data, unsigned int target, unsigned
 {
   m_Target = target;
   m_Size = size;
+  GL_TRACE_RECORD(BufferData(m_ID, m_Target, usage, m_Size * sizeof(T), data));
+  if (data)
+  {
+    Counters::Instance().Add(Counter::BUFFER_UPLOADS);
+    Counters::Instance().Add(Counter::BUFFER_BYTES, m_Size * sizeof(T));
+  }
+
+  if (m_DirectStateAccess)
+  {
+    CALL(glNamedBufferData(m_ID, m_Size * sizeof(T), data, usage));
+    return;
+  }
 
   Bind();
   CALL(glBufferData(m_Target, m_Size * sizeof(T), data, usage));
@@ -78,8 +108,14 @@ void Buffer<T>::SetData(std::vector<T> buf)
 template<typename T>
 void Buffer<T>::GetData(size_t size, T* data, std::ptrdiff_t offset) const
 {
+  if (m_DirectStateAccess)
+  {
+    CALL(glGetNamedBufferSubData(m_ID, offset, size * sizeof(T), data));
+    return;
+  }
+
   Bind();
-  glGetBufferSubData(m_Target, offset, size * sizeof(T), data);
+  CALL(glGetBufferSubData(m_Target, offset, size * sizeof(T), data));
   UnBind();
 }
 
@@ -92,13 +128,15 @@ void Buffer<T>::GetData(std::vector<T>& buf) const
 template<typename T>
 void Buffer<T>::Bind() const
 {
-  CALL(glBindBuffer(m_Target, m_ID));
+  GLStateCache::Instance().BindBuffer(m_Target, m_ID);
 }
 
 template<typename T>
 void Buffer<T>::UnBind() const
 {
-  CALL(glBindBuffer(m_Target, 0));
+#ifndef NDEBUG
+  GLStateCache::Instance().BindBuffer(m_Target, 0);
+#endif
 }
 
 template<typename T>
@@ -107,8 +145,9 @@ void Buffer<T>::Dispose()
   if (m_ID)
   {
     CALL(glDeleteBuffers(1, &m_ID));
+    GLStateCache::Instance().OnDeleteBuffer(m_ID);
     m_ID = 0;
-    m_Target = 0;
+    m_Target = Buffer::defaultTarget;
     m_Size = 0;
   }
 }
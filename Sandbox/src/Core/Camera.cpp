@@ -88,6 +88,19 @@ void Camera::ProcessMouseScroll(float yOffset)
   if (m_Zoom > Camera::maxZoom) m_Zoom = Camera::maxZoom;
 }
 
+Ray Camera::ScreenPointToRay(float x, float y, int width, int height) const
+{
+  float ndcX = 2.0f * x / width - 1.0f;
+  float ndcY = 1.0f - 2.0f * y / height;
+  float tanHalfFov = std::tan(glm::radians(m_Zoom) * 0.5f);
+  float aspect = static_cast<float>(width) / height;
+
+  Ray ray{};
+  ray.origin    = m_Position;
+  ray.direction = glm::normalize(m_Front + m_Right * (ndcX * tanHalfFov * aspect) + m_Up * (ndcY * tanHalfFov));
+  return ray;
+}
+
 void Camera::UpdateCameraVectors()
 {
   glm::vec3 front{};
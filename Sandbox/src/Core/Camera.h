@@ -4,6 +4,8 @@
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 
+#include "Scene/Frustum.h"
+
 class Camera {
 public:
   enum class MovementDirection
@@ -35,6 +37,19 @@ public:
     return m_Zoom;
   }
 
+  inline glm::mat4 GetProjectionMatrix(float aspect, float nearPlane, float farPlane) const
+  {
+    return glm::perspective(glm::radians(m_Zoom), aspect, nearPlane, farPlane);
+  }
+
+  inline Frustum GetFrustum(float aspect, float nearPlane, float farPlane) const
+  {
+    return Frustum::FromMatrix(GetProjectionMatrix(aspect, nearPlane, farPlane) * GetViewMatrix());
+  }
+
+  // world space ray through a window pixel, origin top left
+  Ray ScreenPointToRay(float x, float y, int width, int height) const;
+
   void ProcessKeyboard(MovementDirection direction, float deltaTime);
   void ProcessKeyboardFPS(MovementDirection direction, float deltaTime);
   void ProcessMouseMovement(float xOffset, float yOffset, bool constraintPitch = true);
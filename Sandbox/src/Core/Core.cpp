@@ -3,6 +3,85 @@
 #include <stdio.h>
 #include <GL/glew.h>
 
+#include "Core/DebugOutput.h"
+
+namespace Detail {
+#if GL_CHECK_LEVEL >= GL_CHECK_LEVEL_CALL
+	ErrorCheckMode errorCheckMode = ErrorCheckMode::PER_CALL;
+#elif GL_CHECK_LEVEL >= GL_CHECK_LEVEL_FRAME
+	ErrorCheckMode errorCheckMode = ErrorCheckMode::PER_FRAME;
+#else
+	ErrorCheckMode errorCheckMode = ErrorCheckMode::OFF;
+#endif
+
+	enum class DirectStateAccess { UNRESOLVED, ENABLED, DISABLED };
+	DirectStateAccess directStateAccess = DirectStateAccess::UNRESOLVED;
+}
+
+ErrorCheckMode GetErrorCheckMode() {
+	return Detail::errorCheckMode;
+}
+
+ErrorCheckMode SetErrorCheckMode(ErrorCheckMode mode) {
+#if GL_CHECK_LEVEL < GL_CHECK_LEVEL_CALL
+	if (mode == ErrorCheckMode::PER_CALL) {
+		mode = GL_CHECK_LEVEL >= GL_CHECK_LEVEL_FRAME ? ErrorCheckMode::PER_FRAME : ErrorCheckMode::OFF;
+	}
+#endif
+#if GL_CHECK_LEVEL < GL_CHECK_LEVEL_FRAME
+	if (mode == ErrorCheckMode::PER_FRAME) {
+		mode = ErrorCheckMode::OFF;
+	}
+#endif
+
+	if (mode == ErrorCheckMode::DEBUG_OUTPUT && !DebugOutput::Instance().Install()) {
+		fprintf(stderr, u8"[OpenGL::WARN] KHR_debug not available, falling back to per frame error checks\n");
+		mode = GL_CHECK_LEVEL >= GL_CHECK_LEVEL_FRAME ? ErrorCheckMode::PER_FRAME : ErrorCheckMode::OFF;
+	}
+	else if (mode != ErrorCheckMode::DEBUG_OUTPUT && Detail::errorCheckMode == ErrorCheckMode::DEBUG_OUTPUT) {
+		DebugOutput::Instance().Uninstall();
+	}
+
+	ClearError();
+	Detail::errorCheckMode = mode;
+	return mode;
+}
+
+void CheckFrameErrors() {
+#if GL_CHECK_LEVEL >= GL_CHECK_LEVEL_FRAME
+	if (Detail::errorCheckMode != ErrorCheckMode::PER_FRAME) {
+		return;
+	}
+
+	unsigned int count = 0;
+	unsigned int last = GL_NO_ERROR;
+	while (unsigned int error = glGetError()) {
+		last = error;
+		++count;
+	}
+	if (count) {
+		fprintf(stderr, u8"[OpenGL::ERR] %u error(s) this frame, last err: %d\n", count, last);
+	}
+#endif
+}
+
+bool IsDirectStateAccessAvailable() {
+	return GLEW_VERSION_4_5 || GLEW_ARB_direct_state_access;
+}
+
+bool IsDirectStateAccessEnabled() {
+	if (Detail::directStateAccess == Detail::DirectStateAccess::UNRESOLVED) {
+		SetDirectStateAccessEnabled(true);
+	}
+	return Detail::directStateAccess == Detail::DirectStateAccess::ENABLED;
+}
+
+bool SetDirectStateAccessEnabled(bool enabled) {
+	bool available = IsDirectStateAccessAvailable();
+	Detail::directStateAccess = enabled && available ? Detail::DirectStateAccess::ENABLED : Detail::DirectStateAccess::DISABLED;
+	return enabled && available;
+}
+
 void ClearError() { while (glGetError() != GL_NO_ERROR); }
 
 bool LogCall(const char* func, const char* file, int line) {
@@ -13,4 +92,4 @@ bool LogCall(const char* func, const char* file, int line) {
 		}
 	}
 	return true;
-}
\ No newline at end of file
+}
@@ -1,13 +1,82 @@
 #pragma once
 
-#define ASSERT(x) if(!(x)) __debugbreak();
-#define CALL(x) ClearError(); x; ASSERT(LogCall(#x, __FILE__, __LINE__))
+#if defined(_MSC_VER)
+#define DEBUG_BREAK() __debugbreak()
+#else
+#define DEBUG_BREAK() __builtin_trap()
+#endif
+
+#ifdef NDEBUG
+#define ASSERT(x) (void)(x);
+#else
+#define ASSERT(x) if(!(x)) DEBUG_BREAK();
+#endif
+
+// GL error checking, GL_CHECK_LEVEL is the most expensive mode compiled in:
+//   GL_CHECK_LEVEL_OFF   : CALL(x) is x, only DEBUG_OUTPUT can be selected at runtime,
+//                          performance builds rely on the KHR_debug callback alone (see DebugOutput)
+//   GL_CHECK_LEVEL_FRAME : CALL(x) is x, errors are drained once per frame by CheckFrameErrors
+//   GL_CHECK_LEVEL_CALL  : every mode can be selected at runtime with SetErrorCheckMode
+#define GL_CHECK_LEVEL_OFF   0
+#define GL_CHECK_LEVEL_FRAME 1
+#define GL_CHECK_LEVEL_CALL  2
+
+#ifndef GL_CHECK_LEVEL
+#ifdef NDEBUG
+#define GL_CHECK_LEVEL GL_CHECK_LEVEL_FRAME
+#else
+#define GL_CHECK_LEVEL GL_CHECK_LEVEL_CALL
+#endif
+#endif
+
+// capture builds (GL_TRACE) count the call site of every CALL in the binary trace, see GLTrace,
+// only the expression text is kept, argument values are not, so these records are statistics and never replayed
+#ifdef GL_TRACE
+#include "Trace/GLTrace.h"
+#define TRACE_CALL(x) GL_TRACE_RECORD(Call(#x, __FILE__, __LINE__));
+#else
+#define TRACE_CALL(x)
+#endif
+
+#if GL_CHECK_LEVEL >= GL_CHECK_LEVEL_CALL
+#define CALL(x) TRACE_CALL(x) if (PerCallErrorCheck()) ClearError(); x; ASSERT(!PerCallErrorCheck() || LogCall(#x, __FILE__, __LINE__))
+#else
+#define CALL(x) TRACE_CALL(x) x
+#endif
 
 #define RGBA(x) (x >> 24 & 0xff) / 255.0f, (x >> 16 & 0xff) / 255.0f, (x >> 8 & 0xff) / 255.0f, (x >> 0 & 0xff) / 255.0f
 
 #define RAD(x) x * M_PI / 180.0f;
 #define DEG(x) x * 180.0f / M_PI;
 
+enum class ErrorCheckMode
+  : int
+{
+  OFF,
+  PER_FRAME,
+  PER_CALL,
+  DEBUG_OUTPUT
+};
+
+namespace Detail {
+  extern ErrorCheckMode errorCheckMode;
+}
+
+inline bool PerCallErrorCheck() { return Detail::errorCheckMode == ErrorCheckMode::PER_CALL; }
+
+ErrorCheckMode GetErrorCheckMode();
+
+// returns the mode actually selected, modes above GL_CHECK_LEVEL fall back to the closest compiled one
+ErrorCheckMode SetErrorCheckMode(ErrorCheckMode mode);
+
+// drains the error queue once, call at the end of the frame in PER_FRAME mode
+void CheckFrameErrors();
+
+// GL 4.5 / ARB_direct_state_access, resources created while enabled are edited without binding
+bool IsDirectStateAccessAvailable();
+bool IsDirectStateAccessEnabled();
+bool SetDirectStateAccessEnabled(bool enabled);
+
 void ClearError();
 
-bool LogCall(const char*, const char*, int);
\ No newline at end of file
+bool LogCall(const char*, const char*, int);
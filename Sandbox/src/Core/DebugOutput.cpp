@@ -0,0 +1,228 @@
+#include "DebugOutput.h"
+
+#include <iostream>
+#include <algorithm>
+#include <functional>
+
+#include "Logging/Logger.h"
+
+bool DebugOutput::IsAvailable()
+{
+  return GLEW_VERSION_4_3 || GLEW_KHR_debug;
+}
+
+bool DebugOutput::Install(Mode mode)
+{
+  if (!IsAvailable())
+  {
+    Logger::Instance(std::cerr).Log() << "[WARN::GL] KHR_debug is not available, debug output not installed";
+    return false;
+  }
+
+  glEnable(GL_DEBUG_OUTPUT);
+  if (mode == Mode::SYNCHRONOUS)
+  {
+    // messages are delivered on the calling thread, inside the offending call
+    glEnable(GL_DEBUG_OUTPUT_SYNCHRONOUS);
+  }
+  else
+  {
+    glDisable(GL_DEBUG_OUTPUT_SYNCHRONOUS);
+  }
+
+  glDebugMessageCallback(DebugOutput::Callback, this);
+  ApplySeverityFilter();
+
+  m_Installed = true;
+  return true;
+}
+
+void DebugOutput::Uninstall()
+{
+  if (!m_Installed)
+  {
+    return;
+  }
+
+  glDebugMessageCallback(nullptr, nullptr);
+  glDisable(GL_DEBUG_OUTPUT_SYNCHRONOUS);
+  glDisable(GL_DEBUG_OUTPUT);
+  m_Installed = false;
+}
+
+void DebugOutput::SetMinimumSeverity(unsigned int severity)
+{
+  m_MinimumSeverity = severity;
+  if (m_Installed)
+  {
+    ApplySeverityFilter();
+  }
+}
+
+void DebugOutput::IgnoreSource(unsigned int source)
+{
+  std::lock_guard<std::mutex> lock{ m_Mutex };
+  m_IgnoredSources.insert(source);
+}
+
+void DebugOutput::IgnoreType(unsigned int type)
+{
+  std::lock_guard<std::mutex> lock{ m_Mutex };
+  m_IgnoredTypes.insert(type);
+}
+
+void DebugOutput::IgnoreId(unsigned int id)
+{
+  std::lock_guard<std::mutex> lock{ m_Mutex };
+  m_IgnoredIds.insert(id);
+}
+
+void DebugOutput::Flush()
+{
+  std::lock_guard<std::mutex> lock{ m_Mutex };
+  std::for_each(
+    std::begin(m_Counters),
+    std::end(m_Counters),
+    [&](const std::pair<const MessageKey, MessageCounter>& counter) -> void
+    {
+      std::size_t& flushed = m_FlushedCounts[counter.first];
+      if (counter.second.count > flushed + 1)
+      {
+        Logger::Instance(std::cerr).Log()
+          << "[DEBUG::GL] id: " << counter.second.id << " repeated " << counter.second.count - flushed - 1
+          << " more time(s), total: " << counter.second.count;
+      }
+      flushed = counter.second.count - 1;
+    }
+  );
+}
+
+std::vector<DebugOutput::MessageCounter> DebugOutput::GetCounters() const
+{
+  std::lock_guard<std::mutex> lock{ m_Mutex };
+  std::vector<MessageCounter> counters{};
+  counters.reserve(m_Counters.size());
+  std::for_each(
+    std::begin(m_Counters),
+    std::end(m_Counters),
+    [&](const std::pair<const MessageKey, MessageCounter>& counter) -> void
+    {
+      counters.push_back(counter.second);
+    }
+  );
+  return counters;
+}
+
+void GLAPIENTRY DebugOutput::Callback(GLenum source, GLenum type, GLuint id, GLenum severity, GLsizei length, const GLchar* message, const void* userParam)
+{
+  DebugOutput* output = static_cast<DebugOutput*>(const_cast<void*>(userParam));
+  std::size_t messageLength = length < 0 ? std::char_traits<char>::length(message) : static_cast<std::size_t>(length);
+  output->Receive(source, type, id, severity, message, messageLength);
+}
+
+void DebugOutput::Receive(unsigned int source, unsigned int type, unsigned int id, unsigned int severity, const char* message, std::size_t length)
+{
+  // asynchronous output may call in from any driver thread
+  std::lock_guard<std::mutex> lock{ m_Mutex };
+
+  if (SeverityRank(severity) < SeverityRank(m_MinimumSeverity) ||
+      m_IgnoredSources.count(source) ||
+      m_IgnoredTypes.count(type) ||
+      m_IgnoredIds.count(id))
+  {
+    return;
+  }
+
+  std::string text{ message, length };
+  MessageKey key{ source, type, id, severity, std::hash<std::string>{}(text) };
+
+  auto it = m_Counters.find(key);
+  if (it != std::end(m_Counters))
+  {
+    ++it->second.count;
+    return;
+  }
+
+  Logger::Instance(std::cerr).Log()
+    << "[DEBUG::GL] " << SeverityName(severity) << " " << SourceName(source) << " " << TypeName(type)
+    << " id: " << id << " msg: " << text;
+
+  MessageCounter counter{};
+  counter.source   = source;
+  counter.type     = type;
+  counter.id       = id;
+  counter.severity = severity;
+  counter.message  = std::move(text);
+  counter.count    = 1;
+  m_Counters.emplace(key, std::move(counter));
+}
+
+void DebugOutput::ApplySeverityFilter() const
+{
+  const unsigned int severities[]{
+    GL_DEBUG_SEVERITY_NOTIFICATION,
+    GL_DEBUG_SEVERITY_LOW,
+    GL_DEBUG_SEVERITY_MEDIUM,
+    GL_DEBUG_SEVERITY_HIGH
+  };
+
+  // filtering in the driver means filtered messages are never even formatted
+  for (unsigned int severity : severities)
+  {
+    GLboolean enabled = SeverityRank(severity) >= SeverityRank(m_MinimumSeverity) ? GL_TRUE : GL_FALSE;
+    glDebugMessageControl(GL_DONT_CARE, GL_DONT_CARE, severity, 0, nullptr, enabled);
+  }
+}
+
+int DebugOutput::SeverityRank(unsigned int severity)
+{
+  switch (severity)
+  {
+  case GL_DEBUG_SEVERITY_HIGH:         return 3;
+  case GL_DEBUG_SEVERITY_MEDIUM:       return 2;
+  case GL_DEBUG_SEVERITY_LOW:          return 1;
+  case GL_DEBUG_SEVERITY_NOTIFICATION: return 0;
+  default:                             return 0;
+  }
+}
+
+const char* DebugOutput::SourceName(unsigned int source)
+{
+  switch (source)
+  {
+  case GL_DEBUG_SOURCE_API:             return "API";
+  case GL_DEBUG_SOURCE_WINDOW_SYSTEM:   return "WINDOW_SYSTEM";
+  case GL_DEBUG_SOURCE_SHADER_COMPILER: return "SHADER_COMPILER";
+  case GL_DEBUG_SOURCE_THIRD_PARTY:     return "THIRD_PARTY";
+  case GL_DEBUG_SOURCE_APPLICATION:     return "APPLICATION";
+  default:                              return "OTHER";
+  }
+}
+
+const char* DebugOutput::TypeName(unsigned int type)
+{
+  switch (type)
+  {
+  case GL_DEBUG_TYPE_ERROR:               return "ERROR";
+  case GL_DEBUG_TYPE_DEPRECATED_BEHAVIOR: return "DEPRECATED_BEHAVIOR";
+  case GL_DEBUG_TYPE_UNDEFINED_BEHAVIOR:  return "UNDEFINED_BEHAVIOR";
+  case GL_DEBUG_TYPE_PORTABILITY:         return "PORTABILITY";
+  case GL_DEBUG_TYPE_PERFORMANCE:         return "PERFORMANCE";
+  case GL_DEBUG_TYPE_MARKER:              return "MARKER";
+  case GL_DEBUG_TYPE_PUSH_GROUP:          return "PUSH_GROUP";
+  case GL_DEBUG_TYPE_POP_GROUP:           return "POP_GROUP";
+  default:                                return "OTHER";
+  }
+}
+
+const char* DebugOutput::SeverityName(unsigned int severity)
+{
+  switch (severity)
+  {
+  case GL_DEBUG_SEVERITY_HIGH:         return "HIGH";
+  case GL_DEBUG_SEVERITY_MEDIUM:       return "MEDIUM";
+  case GL_DEBUG_SEVERITY_LOW:          return "LOW";
+  case GL_DEBUG_SEVERITY_NOTIFICATION: return "NOTIFICATION";
+  default:                             return "UNKNOWN";
+  }
+}
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <map>
+#include <set>
+#include <mutex>
+#include <tuple>
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+#include <GL/glew.h>
+
+class DebugOutput {
+public:
+  enum class Mode
+    : std::int32_t
+  {
+    SYNCHRONOUS,
+    ASYNCHRONOUS
+  };
+
+  struct MessageCounter {
+    unsigned int source   = 0;
+    unsigned int type     = 0;
+    unsigned int id       = 0;
+    unsigned int severity = 0;
+    std::string message{};
+    std::size_t count     = 0;
+  };
+
+  static DebugOutput& Instance() {
+    static DebugOutput instance{};
+    return instance;
+  }
+
+  static bool IsAvailable();
+
+  // returns false when the context exposes neither GL 4.3 nor KHR_debug
+  bool Install(Mode mode = DebugOutput::defaultMode);
+  void Uninstall();
+
+  inline bool IsInstalled() const
+  {
+    return m_Installed;
+  }
+
+  // GL_DEBUG_SEVERITY_HIGH / MEDIUM / LOW / NOTIFICATION, everything below is filtered by the driver
+  void SetMinimumSeverity(unsigned int severity);
+  void IgnoreSource(unsigned int source);
+  void IgnoreType(unsigned int type);
+  void IgnoreId(unsigned int id);
+
+  // logs how often each deduplicated message repeated since the last flush
+  void Flush();
+
+  std::vector<MessageCounter> GetCounters() const;
+
+  DebugOutput(const DebugOutput&) = delete;
+  DebugOutput& operator=(const DebugOutput&) = delete;
+
+private:
+  DebugOutput() = default;
+
+  using MessageKey = std::tuple<unsigned int, unsigned int, unsigned int, unsigned int, std::size_t>;
+
+  static void GLAPIENTRY Callback(GLenum source, GLenum type, GLuint id, GLenum severity, GLsizei length, const GLchar* message, const void* userParam);
+
+  void Receive(unsigned int source, unsigned int type, unsigned int id, unsigned int severity, const char* message, std::size_t length);
+  void ApplySeverityFilter() const;
+
+  static int SeverityRank(unsigned int severity);
+  static const char* SourceName(unsigned int source);
+  static const char* TypeName(unsigned int type);
+  static const char* SeverityName(unsigned int severity);
+
+  static constexpr Mode         defaultMode             = Mode::SYNCHRONOUS;
+  static constexpr unsigned int defaultMinimumSeverity  = GL_DEBUG_SEVERITY_LOW;
+
+  mutable std::mutex m_Mutex{};
+  bool m_Installed              = false;
+  unsigned int m_MinimumSeverity = DebugOutput::defaultMinimumSeverity;
+  std::set<unsigned int> m_IgnoredSources{};
+  std::set<unsigned int> m_IgnoredTypes{};
+  std::set<unsigned int> m_IgnoredIds{};
+
+  std::map<MessageKey, MessageCounter> m_Counters{};
+  std::map<MessageKey, std::size_t> m_FlushedCounts{};
+};
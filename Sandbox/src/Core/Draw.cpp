@@ -0,0 +1,92 @@
+#include "Draw.h"
+
+#include <GL/glew.h>
+
+#include "Core/Core.h"
+
+#include "Profiling/Counters.h"
+
+#include "Trace/GLTrace.h"
+
+namespace {
+  std::uint64_t TriangleCount(unsigned int mode, int count)
+  {
+    switch (mode)
+    {
+    case GL_TRIANGLES:      return static_cast<std::uint64_t>(count / 3);
+    case GL_TRIANGLE_STRIP:
+    case GL_TRIANGLE_FAN:   return count > 2 ? static_cast<std::uint64_t>(count - 2) : 0;
+    default:                return 0;
+    }
+  }
+
+  void CountDraw(unsigned int mode, int count, int instances)
+  {
+    Counters& counters = Counters::Instance();
+    counters.Add(Counter::INSTANCES, static_cast<std::uint64_t>(instances));
+    counters.Add(Counter::TRIANGLES, TriangleCount(mode, count) * static_cast<std::uint64_t>(instances));
+  }
+}
+
+std::size_t GetIndexSize(unsigned int indexType)
+{
+  switch (indexType)
+  {
+  case GL_UNSIGNED_BYTE:  return 1;
+  case GL_UNSIGNED_SHORT: return 2;
+  default:                return 4;
+  }
+}
+
+bool IsMultiDrawIndirectAvailable()
+{
+  return GLEW_VERSION_4_3 || GLEW_ARB_multi_draw_indirect;
+}
+
+void DrawArrays(unsigned int mode, int first, int count, int instances)
+{
+  if (instances == 1)
+  {
+    CALL(glDrawArrays(mode, first, count));
+  }
+  else
+  {
+    CALL(glDrawArraysInstanced(mode, first, count, instances));
+  }
+  GL_TRACE_RECORD(Draw(mode, first, count, 0, 0, instances, 0, 0));
+  Counters::Instance().Add(Counter::DRAW_CALLS);
+  CountDraw(mode, count, instances);
+}
+
+void DrawElements(unsigned int mode, int count, unsigned int indexType, std::ptrdiff_t indexOffset, int instances, int baseVertex)
+{
+  const void* indices = reinterpret_cast<const void*>(indexOffset);
+  if (baseVertex)
+  {
+    CALL(glDrawElementsInstancedBaseVertex(mode, count, indexType, indices, instances, baseVertex));
+  }
+  else if (instances == 1)
+  {
+    CALL(glDrawElements(mode, count, indexType, indices));
+  }
+  else
+  {
+    CALL(glDrawElementsInstanced(mode, count, indexType, indices, instances));
+  }
+  GL_TRACE_RECORD(Draw(mode, 0, count, indexType, indexOffset, instances, baseVertex, 0));
+  Counters::Instance().Add(Counter::DRAW_CALLS);
+  CountDraw(mode, count, instances);
+}
+
+void MultiDrawElementsIndirect(unsigned int mode, unsigned int indexType, const DrawElementsIndirectCommand* commands, int drawCount, std::ptrdiff_t indirectOffset)
+{
+  CALL(glMultiDrawElementsIndirect(mode, indexType, reinterpret_cast<const void*>(indirectOffset), drawCount, sizeof(DrawElementsIndirectCommand)));
+  GL_TRACE_RECORD(MultiDrawIndirect(mode, indexType, commands, drawCount, indirectOffset));
+
+  Counters::Instance().Add(Counter::DRAW_CALLS);
+  for (int i = 0; i < drawCount; ++i)
+  {
+    const DrawElementsIndirectCommand& command = commands[i];
+    CountDraw(mode, static_cast<int>(command.count), static_cast<int>(command.instanceCount));
+  }
+}
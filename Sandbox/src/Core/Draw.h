@@ -0,0 +1,25 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// layout fixed by GL_DRAW_INDIRECT_BUFFER consumers
+struct DrawElementsIndirectCommand {
+  std::uint32_t count         = 0;
+  std::uint32_t instanceCount = 0;
+  std::uint32_t firstIndex    = 0;
+  std::int32_t  baseVertex    = 0;
+  std::uint32_t baseInstance  = 0;
+};
+
+std::size_t GetIndexSize(unsigned int indexType);
+
+// GL 4.3 / ARB_multi_draw_indirect
+bool IsMultiDrawIndirectAvailable();
+
+// draw entry points, every draw goes through here so capture and statistics see it
+void DrawArrays(unsigned int mode, int first, int count, int instances = 1);
+void DrawElements(unsigned int mode, int count, unsigned int indexType, std::ptrdiff_t indexOffset = 0, int instances = 1, int baseVertex = 0);
+
+// commands have to be uploaded to the bound GL_DRAW_INDIRECT_BUFFER at indirectOffset, the CPU copy is read by the counters and the capture layer
+void MultiDrawElementsIndirect(unsigned int mode, unsigned int indexType, const DrawElementsIndirectCommand* commands, int drawCount, std::ptrdiff_t indirectOffset = 0);
@@ -0,0 +1,327 @@
+#pragma once
+
+#include <array>
+#include <algorithm>
+#include <mutex>
+#include <thread>
+#include <chrono>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <condition_variable>
+
+#include "Profiling/Profiler.h"
+
+// two stage frame pipeline, a simulation thread fills the back snapshot of frame N+1 from the input sampled
+// on the render thread while the render thread draws the front snapshot of frame N:
+//   Submit(input)  hands the input to the simulation thread
+//   GetFrame()     the front snapshot, immutable until Advance
+//   Advance()      after present, waits for the simulation and swaps the snapshots
+// without pipelining Submit simulates inline and the frame is rendered in the same iteration
+template <typename Input, typename Snapshot>
+class FramePipeline {
+public:
+  using simulateFunction = std::function<void(const Input&, Snapshot&)>;
+
+  // averages in milliseconds since the last ResetStatistics
+  struct Statistics {
+    std::size_t frames              = 0;
+    double simulationMilliseconds   = 0.0;
+    double renderMilliseconds       = 0.0;
+    double waitMilliseconds         = 0.0;   // render thread blocked on the simulation
+    double frameMilliseconds        = 0.0;
+    double latencyMilliseconds      = 0.0;   // input sampled to frame presented
+    double maxLatencyMilliseconds   = 0.0;
+    double framesPerSecond          = 0.0;
+  };
+
+  FramePipeline(simulateFunction simulate, bool pipelined = FramePipeline::defaultPipelined);
+  ~FramePipeline();
+
+  FramePipeline(const FramePipeline&) = delete;
+  FramePipeline& operator=(const FramePipeline&) = delete;
+
+  void Submit(const Input& input);
+
+  // false until the first simulated frame is available
+  inline bool HasFrame() const
+  {
+    return m_Slots[m_Front].valid;
+  }
+
+  inline const Snapshot& GetFrame() const
+  {
+    return m_Slots[m_Front].snapshot;
+  }
+
+  inline std::size_t GetFrameIndex() const
+  {
+    return m_Slots[m_Front].index;
+  }
+
+  void Advance();
+
+  // only between Advance and Submit, the simulation thread is idle there
+  void SetPipelined(bool pipelined);
+
+  inline bool IsPipelined() const
+  {
+    return m_Pipelined;
+  }
+
+  Statistics GetStatistics() const;
+  void ResetStatistics();
+
+private:
+  using clock = std::chrono::steady_clock;
+
+  struct Slot {
+    Snapshot snapshot{};
+    std::size_t index = 0;
+    clock::time_point inputTime{};
+    bool valid = false;
+  };
+
+  void Start();
+  void Stop();
+  void SimulationLoop();
+  void Simulate(Slot& slot, const Input& input);
+
+  static double Milliseconds(clock::duration duration)
+  {
+    return std::chrono::duration<double, std::milli>(duration).count();
+  }
+
+  static constexpr bool defaultPipelined = true;
+
+  simulateFunction m_Simulate;
+  std::array<Slot, 2> m_Slots{};
+  std::size_t m_Front = 0;
+  std::size_t m_NextIndex = 0;
+  bool m_Pipelined = false;
+
+  std::thread m_Thread{};
+  std::mutex m_Mutex{};
+  std::condition_variable m_Condition{};
+  Input m_Input{};
+  bool m_Requested = false;
+  bool m_Busy = false;
+  bool m_Quit = false;
+  std::exception_ptr m_Error{};
+
+  // instrumentation, the simulation time is written by the simulation thread before it signals completion
+  clock::time_point m_SubmitTime{};
+  clock::time_point m_LastAdvance{};
+  double m_SimulationTotal     = 0.0;
+  double m_LastSimulation      = 0.0;
+  double m_RenderTotal         = 0.0;
+  double m_WaitTotal           = 0.0;
+  double m_FrameTotal          = 0.0;
+  double m_LatencyTotal        = 0.0;
+  double m_LatencyMax          = 0.0;
+  std::size_t m_Frames         = 0;
+  std::size_t m_LatencyFrames  = 0;
+  std::size_t m_Presented      = 0;
+};
+
+template <typename Input, typename Snapshot>
+FramePipeline<Input, Snapshot>::FramePipeline(simulateFunction simulate, bool pipelined) :
+  m_Simulate{ std::move(simulate) }
+{
+  SetPipelined(pipelined);
+}
+
+template <typename Input, typename Snapshot>
+FramePipeline<Input, Snapshot>::~FramePipeline()
+{
+  Stop();
+}
+
+template <typename Input, typename Snapshot>
+void FramePipeline<Input, Snapshot>::Submit(const Input& input)
+{
+  m_SubmitTime = clock::now();
+  if (!m_Pipelined)
+  {
+    Slot& slot = m_Slots[m_Front ^ 1];
+    Simulate(slot, input);
+    m_SimulationTotal += m_LastSimulation;
+    m_Front ^= 1;
+    return;
+  }
+
+  { std::lock_guard<std::mutex> lock{ m_Mutex };
+    m_Input = input;
+    m_Requested = true;
+    m_Busy = true;
+  }
+  m_Condition.notify_one();
+}
+
+template <typename Input, typename Snapshot>
+void FramePipeline<Input, Snapshot>::Advance()
+{
+  clock::time_point now = clock::now();
+
+  // the front frame was just presented
+  if (m_Slots[m_Front].valid && m_Slots[m_Front].index >= m_Presented)
+  {
+    double latency = Milliseconds(now - m_Slots[m_Front].inputTime);
+    m_LatencyTotal += latency;
+    m_LatencyMax = std::max(m_LatencyMax, latency);
+    ++m_LatencyFrames;
+    m_Presented = m_Slots[m_Front].index + 1;
+  }
+  m_RenderTotal += Milliseconds(now - m_SubmitTime);
+
+  if (m_Pipelined)
+  {
+    PROFILE_SCOPE("FramePipeline::Wait");
+    std::unique_lock<std::mutex> lock{ m_Mutex };
+    m_Condition.wait(lock, [this]() { return !m_Busy; });
+    if (m_Error)
+    {
+      std::exception_ptr error = m_Error;
+      m_Error = nullptr;
+      std::rethrow_exception(error);
+    }
+    m_SimulationTotal += m_LastSimulation;
+    m_Front ^= 1;
+  }
+
+  clock::time_point end = clock::now();
+  m_WaitTotal += Milliseconds(end - now);
+  if (m_LastAdvance != clock::time_point{})
+  {
+    m_FrameTotal += Milliseconds(end - m_LastAdvance);
+  }
+  m_LastAdvance = end;
+  ++m_Frames;
+}
+
+template <typename Input, typename Snapshot>
+void FramePipeline<Input, Snapshot>::SetPipelined(bool pipelined)
+{
+  if (pipelined == m_Pipelined)
+  {
+    return;
+  }
+
+  m_Pipelined = pipelined;
+  if (pipelined)
+  {
+    Start();
+  }
+  else
+  {
+    Stop();
+  }
+}
+
+template <typename Input, typename Snapshot>
+typename FramePipeline<Input, Snapshot>::Statistics FramePipeline<Input, Snapshot>::GetStatistics() const
+{
+  Statistics statistics{};
+  statistics.frames = m_Frames;
+  if (m_Frames == 0)
+  {
+    return statistics;
+  }
+
+  const double frames = static_cast<double>(m_Frames);
+  statistics.simulationMilliseconds = m_SimulationTotal / frames;
+  statistics.renderMilliseconds     = m_RenderTotal / frames;
+  statistics.waitMilliseconds       = m_WaitTotal / frames;
+  statistics.frameMilliseconds      = m_FrameTotal / frames;
+  statistics.latencyMilliseconds    = m_LatencyFrames ? m_LatencyTotal / m_LatencyFrames : 0.0;
+  statistics.maxLatencyMilliseconds = m_LatencyMax;
+  statistics.framesPerSecond        = m_FrameTotal > 0.0 ? 1000.0 * frames / m_FrameTotal : 0.0;
+  return statistics;
+}
+
+template <typename Input, typename Snapshot>
+void FramePipeline<Input, Snapshot>::ResetStatistics()
+{
+  m_SimulationTotal = 0.0;
+  m_RenderTotal     = 0.0;
+  m_WaitTotal       = 0.0;
+  m_FrameTotal      = 0.0;
+  m_LatencyTotal    = 0.0;
+  m_LatencyMax      = 0.0;
+  m_Frames          = 0;
+  m_LatencyFrames   = 0;
+}
+
+template <typename Input, typename Snapshot>
+void FramePipeline<Input, Snapshot>::Start()
+{
+  if (m_Thread.joinable())
+  {
+    return;
+  }
+
+  m_Quit = false;
+  m_Thread = std::thread{ &FramePipeline::SimulationLoop, this };
+}
+
+template <typename Input, typename Snapshot>
+void FramePipeline<Input, Snapshot>::Stop()
+{
+  if (!m_Thread.joinable())
+  {
+    return;
+  }
+
+  { std::lock_guard<std::mutex> lock{ m_Mutex };
+    m_Quit = true;
+  }
+  m_Condition.notify_all();
+  m_Thread.join();
+}
+
+template <typename Input, typename Snapshot>
+void FramePipeline<Input, Snapshot>::SimulationLoop()
+{
+  PROFILE_THREAD("Simulation");
+  std::unique_lock<std::mutex> lock{ m_Mutex };
+  while (true)
+  {
+    m_Condition.wait(lock, [this]() { return m_Requested || m_Quit; });
+    if (!m_Requested)
+    {
+      return;
+    }
+
+    m_Requested = false;
+    Input input = m_Input;
+    lock.unlock();
+
+    // the back slot belongs to this thread until m_Busy is cleared
+    std::exception_ptr error{};
+    try
+    {
+      Simulate(m_Slots[m_Front ^ 1], input);
+    }
+    catch (...)
+    {
+      error = std::current_exception();
+    }
+
+    lock.lock();
+    m_Error = error;
+    m_Busy = false;
+    m_Condition.notify_all();
+  }
+}
+
+template <typename Input, typename Snapshot>
+void FramePipeline<Input, Snapshot>::Simulate(Slot& slot, const Input& input)
+{
+  PROFILE_SCOPE("FramePipeline::Simulate");
+  clock::time_point start = clock::now();
+  slot.inputTime = m_SubmitTime;
+  slot.index     = m_NextIndex++;
+  m_Simulate(input, slot.snapshot);
+  slot.valid     = true;
+  m_LastSimulation = Milliseconds(clock::now() - start);
+}
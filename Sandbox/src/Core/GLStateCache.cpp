@@ -0,0 +1,217 @@
+#include "GLStateCache.h"
+
+#include "Core/Core.h"
+
+#include "Trace/GLTrace.h"
+
+GLStateCache::GLStateCache()
+{
+  Invalidate();
+}
+
+void GLStateCache::UseProgram(unsigned int program)
+{
+  const bool issue = !Skip(m_Program, program);
+  GL_TRACE_RECORD(UseProgram(program, issue));
+  if (issue)
+  {
+    CALL(glUseProgram(program));
+  }
+}
+
+void GLStateCache::BindVertexArray(unsigned int vertexArray)
+{
+  const bool issue = !Skip(m_VertexArray, vertexArray);
+  GL_TRACE_RECORD(BindVertexArray(vertexArray, issue));
+  if (issue)
+  {
+    CALL(glBindVertexArray(vertexArray));
+
+    // the element array binding is vertex array state
+    m_Buffers[BufferTargetIndex(GL_ELEMENT_ARRAY_BUFFER)] = GLStateCache::unknown;
+  }
+}
+
+void GLStateCache::BindBuffer(unsigned int target, unsigned int buffer)
+{
+  int index = BufferTargetIndex(target);
+  if (index < 0)
+  {
+    Issued();
+    GL_TRACE_RECORD(BindBuffer(target, buffer, true));
+    CALL(glBindBuffer(target, buffer));
+    return;
+  }
+
+  const bool issue = !Skip(m_Buffers[index], buffer);
+  GL_TRACE_RECORD(BindBuffer(target, buffer, issue));
+  if (issue)
+  {
+    CALL(glBindBuffer(target, buffer));
+  }
+}
+
+void GLStateCache::ActiveTexture(unsigned int unit)
+{
+  const bool issue = !Skip(m_ActiveUnit, unit);
+  GL_TRACE_RECORD(ActiveTexture(unit, issue));
+  if (issue)
+  {
+    CALL(glActiveTexture(GL_TEXTURE0 + unit));
+  }
+}
+
+void GLStateCache::BindTexture(unsigned int target, unsigned int texture)
+{
+  int index = TextureTargetIndex(target);
+  if (index < 0 || m_ActiveUnit >= GLStateCache::maxTextureUnits)
+  {
+    Issued();
+    GL_TRACE_RECORD(BindTexture(m_ActiveUnit, target, texture, true));
+    CALL(glBindTexture(target, texture));
+    return;
+  }
+
+  const bool issue = !Skip(m_Textures[m_ActiveUnit][index], texture);
+  GL_TRACE_RECORD(BindTexture(m_ActiveUnit, target, texture, issue));
+  if (issue)
+  {
+    CALL(glBindTexture(target, texture));
+  }
+}
+
+void GLStateCache::BindTexture(unsigned int unit, unsigned int target, unsigned int texture)
+{
+  int index = TextureTargetIndex(target);
+  if (index >= 0 && unit < GLStateCache::maxTextureUnits && m_Textures[unit][index] == texture)
+  {
+    ++m_Current.avoided;
+    GL_TRACE_RECORD(BindTexture(unit, target, texture, false));
+    return;
+  }
+
+  ActiveTexture(unit);
+  BindTexture(target, texture);
+}
+
+void GLStateCache::BindSampler(unsigned int unit, unsigned int sampler)
+{
+  if (unit >= GLStateCache::maxTextureUnits)
+  {
+    Issued();
+    GL_TRACE_RECORD(BindSampler(unit, sampler, true));
+    CALL(glBindSampler(unit, sampler));
+    return;
+  }
+
+  const bool issue = !Skip(m_Samplers[unit], sampler);
+  GL_TRACE_RECORD(BindSampler(unit, sampler, issue));
+  if (issue)
+  {
+    CALL(glBindSampler(unit, sampler));
+  }
+}
+
+void GLStateCache::OnDeleteProgram(unsigned int program)
+{
+  if (m_Program == program)
+  {
+    m_Program = 0;
+  }
+}
+
+void GLStateCache::OnDeleteVertexArray(unsigned int vertexArray)
+{
+  if (m_VertexArray == vertexArray)
+  {
+    m_VertexArray = 0;
+    m_Buffers[BufferTargetIndex(GL_ELEMENT_ARRAY_BUFFER)] = GLStateCache::unknown;
+  }
+}
+
+void GLStateCache::OnDeleteBuffer(unsigned int buffer)
+{
+  for (unsigned int& bound : m_Buffers)
+  {
+    if (bound == buffer)
+    {
+      bound = 0;
+    }
+  }
+}
+
+void GLStateCache::OnDeleteTexture(unsigned int texture)
+{
+  for (auto& unit : m_Textures)
+  {
+    for (unsigned int& bound : unit)
+    {
+      if (bound == texture)
+      {
+        bound = 0;
+      }
+    }
+  }
+}
+
+void GLStateCache::OnDeleteSampler(unsigned int sampler)
+{
+  for (unsigned int& bound : m_Samplers)
+  {
+    if (bound == sampler)
+    {
+      bound = 0;
+    }
+  }
+}
+
+void GLStateCache::Invalidate()
+{
+  m_Program     = GLStateCache::unknown;
+  m_VertexArray = GLStateCache::unknown;
+  m_ActiveUnit  = GLStateCache::unknown;
+  m_Buffers.fill(GLStateCache::unknown);
+  for (auto& unit : m_Textures)
+  {
+    unit.fill(GLStateCache::unknown);
+  }
+  m_Samplers.fill(GLStateCache::unknown);
+}
+
+void GLStateCache::EndFrame()
+{
+  m_LastFrame = m_Current;
+  m_Current = Statistics{};
+}
+
+int GLStateCache::BufferTargetIndex(unsigned int target)
+{
+  switch (target)
+  {
+  case GL_ARRAY_BUFFER:              return 0;
+  case GL_ELEMENT_ARRAY_BUFFER:      return 1;
+  case GL_UNIFORM_BUFFER:            return 2;
+  case GL_COPY_READ_BUFFER:          return 3;
+  case GL_COPY_WRITE_BUFFER:         return 4;
+  case GL_PIXEL_PACK_BUFFER:         return 5;
+  case GL_PIXEL_UNPACK_BUFFER:       return 6;
+  case GL_TEXTURE_BUFFER:            return 7;
+  case GL_DRAW_INDIRECT_BUFFER:      return 8;
+  case GL_SHADER_STORAGE_BUFFER:     return 9;
+  default:                           return -1;
+  }
+}
+
+int GLStateCache::TextureTargetIndex(unsigned int target)
+{
+  switch (target)
+  {
+  case GL_TEXTURE_2D:                return 0;
+  case GL_TEXTURE_CUBE_MAP:          return 1;
+  case GL_TEXTURE_3D:                return 2;
+  case GL_TEXTURE_2D_ARRAY:          return 3;
+  case GL_TEXTURE_BUFFER:            return 4;
+  case GL_TEXTURE_2D_MULTISAMPLE:    return 5;
+  default:                           return -1;
+  }
+}
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+
+#include <GL/glew.h>
+
+#include "Profiling/Counters.h"
+
+class GLStateCache {
+public:
+  struct Statistics {
+    std::size_t issued  = 0;
+    std::size_t avoided = 0;
+  };
+
+  // one cache per thread, binding state belongs to the context current on it (see ResourceLoader)
+  static GLStateCache& Instance() {
+    static thread_local GLStateCache instance{};
+    return instance;
+  }
+
+  // capture builds (GL_TRACE) record every request, skipped ones included, so traces show what the cache saved
+  void UseProgram(unsigned int program);
+  void BindVertexArray(unsigned int vertexArray);
+  void BindBuffer(unsigned int target, unsigned int buffer);
+
+  // unit is an index (0, 1, ...), not GL_TEXTUREi
+  void ActiveTexture(unsigned int unit);
+  void BindTexture(unsigned int target, unsigned int texture);
+  void BindTexture(unsigned int unit, unsigned int target, unsigned int texture);
+  void BindSampler(unsigned int unit, unsigned int sampler);
+
+  // deleting a bound object implicitly rebinds 0, keep the cache in sync
+  void OnDeleteProgram(unsigned int program);
+  void OnDeleteVertexArray(unsigned int vertexArray);
+  void OnDeleteBuffer(unsigned int buffer);
+  void OnDeleteTexture(unsigned int texture);
+  void OnDeleteSampler(unsigned int sampler);
+
+  // forget everything, required after GL state was changed behind the cache
+  void Invalidate();
+
+  void EndFrame();
+
+  inline Statistics GetFrameStatistics() const
+  {
+    return m_LastFrame;
+  }
+
+  inline Statistics GetCurrentStatistics() const
+  {
+    return m_Current;
+  }
+
+  GLStateCache(const GLStateCache&) = delete;
+  GLStateCache& operator=(const GLStateCache&) = delete;
+
+private:
+  GLStateCache();
+
+  static int BufferTargetIndex(unsigned int target);
+  static int TextureTargetIndex(unsigned int target);
+
+  inline bool Skip(unsigned int& cached, unsigned int value)
+  {
+    if (cached == value)
+    {
+      ++m_Current.avoided;
+      return true;
+    }
+
+    cached = value;
+    Issued();
+    return false;
+  }
+
+  inline void Issued()
+  {
+    ++m_Current.issued;
+    Counters::Instance().Add(Counter::STATE_CHANGES);
+  }
+
+  static constexpr unsigned int unknown            = 0xFFFFFFFF;
+  static constexpr std::size_t  bufferTargetCount  = 10;
+  static constexpr std::size_t  textureTargetCount = 6;
+  static constexpr std::size_t  maxTextureUnits    = 32;
+
+  unsigned int m_Program      = GLStateCache::unknown;
+  unsigned int m_VertexArray  = GLStateCache::unknown;
+  unsigned int m_ActiveUnit   = GLStateCache::unknown;
+  std::array<unsigned int, bufferTargetCount> m_Buffers{};
+  std::array<std::array<unsigned int, textureTargetCount>, maxTextureUnits> m_Textures{};
+  std::array<unsigned int, maxTextureUnits> m_Samplers{};
+
+  Statistics m_Current{};
+  Statistics m_LastFrame{};
+};
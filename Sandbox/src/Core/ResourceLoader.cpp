@@ -0,0 +1,294 @@
+#include "ResourceLoader.h"
+
+#include <chrono>
+#include <iostream>
+
+#include "Core/Core.h"
+#include "Core/GLStateCache.h"
+
+#include "Logging/Logger.h"
+
+#include "Profiling/Profiler.h"
+
+ResourceLoader::~ResourceLoader()
+{
+  // GLFW is usually gone by now, only the thread can be cleaned up
+  if (m_Thread.joinable())
+  {
+    { std::lock_guard<std::mutex> lock{ m_Mutex };
+      m_Quit = true;
+    }
+    m_Condition.notify_all();
+    m_Thread.join();
+  }
+}
+
+void ResourceLoader::Initialize(Window& window, Mode mode)
+{
+  if (m_Window)
+  {
+    throw std::exception{ "[ERROR::LOADER] Resource loader already initialized" };
+  }
+
+#ifdef GL_TRACE
+  mode = Mode::SINGLE_THREADED;
+#endif
+
+  m_Window = &window;
+  m_Mode   = mode;
+  m_Quit   = false;
+
+  if (m_Mode == Mode::SHARED_CONTEXT)
+  {
+    try
+    {
+      m_Context = window.CreateSharedContext();
+    }
+    catch (const std::exception& err)
+    {
+      Logger::Instance(std::cerr).Log() << err.what();
+      m_Context = nullptr;
+    }
+
+    if (!m_Context)
+    {
+      Logger::Instance(std::cerr).Log() << "[WARN::LOADER] Could not create a shared context, loading on the render thread";
+      m_Mode = Mode::SINGLE_THREADED;
+    }
+    else
+    {
+      m_Thread = std::thread{ &ResourceLoader::LoaderLoop, this };
+    }
+  }
+
+  Logger::Instance(std::cout).Log() << "[INFO::LOADER] Resource loader started, "
+                                    << (m_Mode == Mode::SHARED_CONTEXT ? "shared context thread" : "single threaded");
+}
+
+void ResourceLoader::Shutdown()
+{
+  if (!m_Window)
+  {
+    return;
+  }
+
+  // the loader thread finishes the queued requests first
+  if (m_Thread.joinable())
+  {
+    { std::lock_guard<std::mutex> lock{ m_Mutex };
+      m_Quit = true;
+    }
+    m_Condition.notify_all();
+    m_Thread.join();
+  }
+
+  m_Window->DestroySharedContext(m_Context);
+  m_Context = nullptr;
+
+  std::lock_guard<std::mutex> lock{ m_Mutex };
+  for (Completion& completion : m_Completions)
+  {
+    if (completion.fence)
+    {
+      CALL(glDeleteSync(completion.fence));
+    }
+  }
+  m_Completions.clear();
+  m_Requests.clear();
+  m_Pending = 0;
+  m_Window  = nullptr;
+}
+
+void ResourceLoader::Enqueue(Task task, Task onReady)
+{
+  if (!m_Window)
+  {
+    throw std::exception{ "[ERROR::LOADER] Resource loader not initialized" };
+  }
+
+  { std::lock_guard<std::mutex> lock{ m_Mutex };
+    m_Requests.push_back(Request{ std::move(task), std::move(onReady) });
+    ++m_Pending;
+    ++m_Statistics.queued;
+  }
+  m_Condition.notify_one();
+}
+
+void ResourceLoader::LoadTexture(Texture& texture, std::string path, unsigned int target, int flipTexture, Task onReady)
+{
+  Enqueue(
+    [&texture, path = std::move(path), target, flipTexture]()
+    {
+      texture.LoadFromFile(path.c_str(), target, flipTexture);
+    },
+    std::move(onReady)
+  );
+}
+
+void ResourceLoader::LoadShader(Shader& shader, std::string vertexPath, std::string fragmentPath, Task onReady)
+{
+  Enqueue(
+    [&shader, vertexPath = std::move(vertexPath), fragmentPath = std::move(fragmentPath)]()
+    {
+      shader.LoadFromFile(GL_VERTEX_SHADER, vertexPath.c_str());
+      shader.LoadFromFile(GL_FRAGMENT_SHADER, fragmentPath.c_str());
+      shader.Link();
+    },
+    std::move(onReady)
+  );
+}
+
+void ResourceLoader::Update()
+{
+  PROFILE_SCOPE("ResourceLoader::Update");
+  if (m_Mode == Mode::SINGLE_THREADED)
+  {
+    RunSingleThreaded();
+  }
+
+  // completions are in submission order, the first unsignalled fence stops the walk
+  std::exception_ptr error{};
+  while (true)
+  {
+    Completion completion{};
+    { std::lock_guard<std::mutex> lock{ m_Mutex };
+      if (m_Completions.empty())
+      {
+        break;
+      }
+
+      Completion& front = m_Completions.front();
+      if (front.fence)
+      {
+        CALL(GLenum status = glClientWaitSync(front.fence, 0, 0));
+        if (status == GL_TIMEOUT_EXPIRED)
+        {
+          break;
+        }
+        CALL(glDeleteSync(front.fence));
+      }
+
+      completion = std::move(front);
+      m_Completions.pop_front();
+      --m_Pending;
+      ++m_Statistics.completed;
+    }
+
+    if (completion.error)
+    {
+      if (!error)
+      {
+        error = completion.error;
+      }
+      continue;
+    }
+
+    if (completion.onReady)
+    {
+      completion.onReady();
+    }
+  }
+
+  if (error)
+  {
+    std::rethrow_exception(error);
+  }
+}
+
+void ResourceLoader::Flush()
+{
+  while (!IsIdle())
+  {
+    Update();
+    if (m_Mode == Mode::SHARED_CONTEXT)
+    {
+      std::this_thread::yield();
+    }
+  }
+}
+
+ResourceLoader::Statistics ResourceLoader::GetStatistics() const
+{
+  std::lock_guard<std::mutex> lock{ m_Mutex };
+  return m_Statistics;
+}
+
+void ResourceLoader::LoaderLoop()
+{
+  PROFILE_THREAD("Loader");
+  glfwMakeContextCurrent(m_Context);
+
+  std::unique_lock<std::mutex> lock{ m_Mutex };
+  while (true)
+  {
+    m_Condition.wait(lock, [this]() { return !m_Requests.empty() || m_Quit; });
+    if (m_Requests.empty())
+    {
+      break;
+    }
+
+    Request request = std::move(m_Requests.front());
+    m_Requests.pop_front();
+    lock.unlock();
+
+    // objects deleted on the render context may have left stale bindings behind in this one
+    GLStateCache::Instance().Invalidate();
+    Completion completion = Run(request);
+
+    // without the flush the fence might never reach the GPU and the render thread would wait forever
+    CALL(completion.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0));
+    CALL(glFlush());
+
+    lock.lock();
+    m_Completions.push_back(std::move(completion));
+  }
+  lock.unlock();
+
+  glfwMakeContextCurrent(nullptr);
+}
+
+ResourceLoader::Completion ResourceLoader::Run(Request& request)
+{
+  PROFILE_SCOPE("ResourceLoader::Run");
+  auto start = std::chrono::steady_clock::now();
+
+  Completion completion{};
+  completion.onReady = std::move(request.onReady);
+  try
+  {
+    request.task();
+  }
+  catch (...)
+  {
+    completion.error = std::current_exception();
+  }
+
+  double milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+  std::lock_guard<std::mutex> lock{ m_Mutex };
+  m_Statistics.taskMilliseconds += milliseconds;
+  return completion;
+}
+
+void ResourceLoader::RunSingleThreaded()
+{
+  // same context, the commands are ordered with the frame and need no fence
+  auto start = std::chrono::steady_clock::now();
+  do
+  {
+    Request request{};
+    { std::lock_guard<std::mutex> lock{ m_Mutex };
+      if (m_Requests.empty())
+      {
+        break;
+      }
+      request = std::move(m_Requests.front());
+      m_Requests.pop_front();
+    }
+
+    Completion completion = Run(request);
+
+    std::lock_guard<std::mutex> lock{ m_Mutex };
+    m_Completions.push_back(std::move(completion));
+  }
+  while (std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() < ResourceLoader::singleThreadedBudgetMilliseconds);
+}
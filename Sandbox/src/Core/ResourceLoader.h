@@ -0,0 +1,132 @@
+#pragma once
+
+#include <deque>
+#include <mutex>
+#include <vector>
+#include <string>
+#include <thread>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <condition_variable>
+
+#include <GL/glew.h>
+#include <GLFW/glfw3.h>
+
+#include "Core/Window.h"
+#include "Core/Buffer.h"
+#include "Core/Shader.h"
+#include "Core/Texture.h"
+
+// GL resource creation off the render thread, tasks run on a loader thread with a hidden context sharing objects
+// with the window, a fence is inserted after every task and its completion callback runs on the render thread in
+// Update once the fence signalled, so the render thread neither waits on the upload nor sees half written objects
+//   SHARED_CONTEXT  : loader thread, falls back to SINGLE_THREADED when the shared context cannot be created
+//   SINGLE_THREADED : tasks run inside Update on the render thread, at least one per call within a time budget,
+//                     always used by GL_TRACE builds, the trace is a single stream of one context
+// objects handed to a task must not be used until its completion callback ran
+class ResourceLoader {
+public:
+  enum class Mode
+    : std::int32_t
+  {
+    SINGLE_THREADED,
+    SHARED_CONTEXT
+  };
+
+  struct Statistics {
+    std::size_t queued    = 0;
+    std::size_t completed = 0;
+    double taskMilliseconds = 0.0;   // total time spent running tasks, on whichever thread ran them
+  };
+
+  using Task = std::function<void()>;
+
+  static ResourceLoader& Instance()
+  {
+    static ResourceLoader instance{};
+    return instance;
+  }
+
+  ResourceLoader(const ResourceLoader&) = delete;
+  ResourceLoader& operator=(const ResourceLoader&) = delete;
+
+  // on the thread owning the window, after it was initialized
+  void Initialize(Window& window, Mode mode = ResourceLoader::defaultMode);
+  void Shutdown();
+
+  inline Mode GetMode() const
+  {
+    return m_Mode;
+  }
+
+  // task runs with a GL context current, onReady on the render thread once the GPU finished the task's commands
+  void Enqueue(Task task, Task onReady = {});
+
+  void LoadTexture(Texture& texture, std::string path, unsigned int target = GL_TEXTURE_2D, int flipTexture = GL_TRUE, Task onReady = {});
+  void LoadShader(Shader& shader, std::string vertexPath, std::string fragmentPath, Task onReady = {});
+
+  template <typename T>
+  void UploadBuffer(Buffer<T>& buffer, std::vector<T> data, Task onReady = {})
+  {
+    // the vector is moved into the task, the caller's copy can go right away
+    Enqueue(
+      [&buffer, data = std::move(data)]() mutable
+      {
+        buffer.SetData(std::move(data));
+      },
+      std::move(onReady)
+    );
+  }
+
+  // render thread, once per frame, runs the callbacks of finished tasks, rethrows the first failed task
+  void Update();
+
+  // blocks until everything enqueued so far is finished and its callback ran
+  void Flush();
+
+  inline bool IsIdle() const
+  {
+    std::lock_guard<std::mutex> lock{ m_Mutex };
+    return m_Pending == 0;
+  }
+
+  Statistics GetStatistics() const;
+
+private:
+  struct Request {
+    Task task{};
+    Task onReady{};
+  };
+
+  struct Completion {
+    Task onReady{};
+    GLsync fence = nullptr;
+    std::exception_ptr error{};
+  };
+
+  ResourceLoader() = default;
+  ~ResourceLoader();
+
+  void LoaderLoop();
+  Completion Run(Request& request);
+  void RunSingleThreaded();
+
+  static constexpr Mode defaultMode = Mode::SHARED_CONTEXT;
+  static constexpr double singleThreadedBudgetMilliseconds = 2.0;
+
+  Mode m_Mode = Mode::SINGLE_THREADED;
+  Window* m_Window = nullptr;
+  GLFWwindow* m_Context = nullptr;
+  std::thread m_Thread{};
+
+  mutable std::mutex m_Mutex{};
+  std::condition_variable m_Condition{};
+  std::deque<Request> m_Requests{};
+  std::deque<Completion> m_Completions{};
+  std::size_t m_Pending = 0;
+  bool m_Quit = false;
+
+  Statistics m_Statistics{};
+};
@@ -0,0 +1,58 @@
+#include "SamplerCache.h"
+
+#include <algorithm>
+
+#include "Core/Core.h"
+#include "Core/GLStateCache.h"
+
+#include "Trace/GLTrace.h"
+
+SamplerCache::~SamplerCache()
+{
+  Dispose();
+}
+
+unsigned int SamplerCache::Get(const std::unordered_map<int, int>& parameters)
+{
+  return Get(std::map<int, int>{ std::begin(parameters), std::end(parameters) });
+}
+
+unsigned int SamplerCache::Get(const std::map<int, int>& parameters)
+{
+  std::lock_guard<std::mutex> lock{ m_Mutex };
+  auto it = m_Samplers.find(parameters);
+  if (it != std::end(m_Samplers))
+  {
+    return it->second;
+  }
+
+  unsigned int sampler = 0;
+  CALL(glGenSamplers(1, &sampler));
+  std::for_each(
+    std::begin(parameters),
+    std::end(parameters),
+    [&](const std::pair<const int, int>& param) -> void
+    {
+      CALL(glSamplerParameteri(sampler, param.first, param.second));
+    }
+  );
+  GL_TRACE_RECORD(Sampler(sampler, parameters));
+
+  m_Samplers.emplace(parameters, sampler);
+  return sampler;
+}
+
+void SamplerCache::Dispose()
+{
+  std::lock_guard<std::mutex> lock{ m_Mutex };
+  std::for_each(
+    std::begin(m_Samplers),
+    std::end(m_Samplers),
+    [](const std::pair<const std::map<int, int>, unsigned int>& sampler) -> void
+    {
+      CALL(glDeleteSamplers(1, &sampler.second));
+      GLStateCache::Instance().OnDeleteSampler(sampler.second);
+    }
+  );
+  m_Samplers.clear();
+}
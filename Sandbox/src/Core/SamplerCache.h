@@ -0,0 +1,39 @@
+#pragma once
+
+#include <map>
+#include <mutex>
+#include <unordered_map>
+
+#include <GL/glew.h>
+
+class SamplerCache {
+public:
+  static SamplerCache& Instance() {
+    static SamplerCache instance{};
+    return instance;
+  }
+
+  ~SamplerCache();
+
+  unsigned int Get(const std::unordered_map<int, int>& parameters);
+  unsigned int Get(const std::map<int, int>& parameters);
+
+  inline std::size_t GetSize() const
+  {
+    std::lock_guard<std::mutex> lock{ m_Mutex };
+    return m_Samplers.size();
+  }
+
+  void Dispose();
+
+  SamplerCache(const SamplerCache&) = delete;
+  SamplerCache& operator=(const SamplerCache&) = delete;
+
+private:
+  SamplerCache() = default;
+
+  // ordered so that equal parameter sets compare equal regardless of insertion order
+  std::map<std::map<int, int>, unsigned int> m_Samplers{};
+  // sampler objects are shared between contexts, textures loaded on the loader thread resolve theirs here too
+  mutable std::mutex m_Mutex{};
+};
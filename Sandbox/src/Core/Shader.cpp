@@ -5,6 +5,11 @@
 #include <algorithm>
 
 #include "Core/Core.h"
+#include "Core/GLStateCache.h"
+
+#include "Profiling/Counters.h"
+
+#include "Trace/GLTrace.h"
 
 Shader::~Shader()
 {
@@ -31,6 +36,7 @@ void Shader::LoadFromString(unsigned int type, const std::string& source)
   CALL(unsigned int shader = glCreateShader(type));
   const char* csource = source.c_str();
   CALL(glShaderSource(shader, 1, &csource, nullptr));
+  GL_TRACE_RECORD(ShaderSource(shader, type, source));
 
   CALL(glCompileShader(shader));
   int compileStatus = 0;
@@ -97,6 +103,7 @@ void Shader::Link()
       throw std::exception{ outStream.str().c_str() };
     }
   }
+  GL_TRACE_RECORD(ProgramLink(m_Program, m_Shaders.data(), m_ShaderCount));
 
   { int validationStatus = 0;
     CALL(glValidateProgram(m_Program));
@@ -179,36 +186,56 @@ unsigned int Shader::GetUniformLocation(const char* uniform)
 void Shader::SetUniform1b(unsigned int uniformLocation, bool value) 
 {
   CALL(glUniform1i(uniformLocation, (int)value));
+  Counters::Instance().Add(Counter::UNIFORM_UPLOADS);
+#ifdef GL_TRACE
+  const int intValue = value;
+  GL_TRACE_RECORD(Uniform(uniformLocation, TraceUniformType::INT, 1, &intValue));
+#endif
 }
 void Shader::SetUniform1i(unsigned int uniformLocation, int value) 
 {
   CALL(glUniform1i(uniformLocation, value));
+  Counters::Instance().Add(Counter::UNIFORM_UPLOADS);
+  GL_TRACE_RECORD(Uniform(uniformLocation, TraceUniformType::INT, 1, &value));
 }
 void Shader::SetUniform1f(unsigned int uniformLocation, float value) 
 {
   CALL(glUniform1f(uniformLocation, value));
+  Counters::Instance().Add(Counter::UNIFORM_UPLOADS);
+  GL_TRACE_RECORD(Uniform(uniformLocation, TraceUniformType::FLOAT, 1, &value));
 }
 void Shader::SetUniform3f(unsigned int uniformLocation, float value1, float value2, float value3)
 {
   CALL(glUniform3f(uniformLocation, value1, value2, value3));
+  Counters::Instance().Add(Counter::UNIFORM_UPLOADS);
+#ifdef GL_TRACE
+  const float value[3]{ value1, value2, value3 };
+  GL_TRACE_RECORD(Uniform(uniformLocation, TraceUniformType::VEC3, 1, value));
+#endif
 }
 void Shader::SetUniform3fv(unsigned int uniformLocation, const float* value, int count)
 {
   CALL(glUniform3fv(uniformLocation, count, value));
+  Counters::Instance().Add(Counter::UNIFORM_UPLOADS);
+  GL_TRACE_RECORD(Uniform(uniformLocation, TraceUniformType::VEC3, count, value));
 }
 void Shader::SetUniformMatrix4fv(unsigned int uniformLocation, const float* value, unsigned char transpose)
 {
   CALL(glUniformMatrix4fv(uniformLocation, 1, transpose, value));
+  Counters::Instance().Add(Counter::UNIFORM_UPLOADS);
+  GL_TRACE_RECORD(Uniform(uniformLocation, transpose ? TraceUniformType::MAT4_TRANSPOSE : TraceUniformType::MAT4, 1, value));
 }
 
 void Shader::Bind() const 
 {
-  CALL(glUseProgram(m_Program));
+  GLStateCache::Instance().UseProgram(m_Program);
 }
 
 void Shader::UnBind() const 
 {
-  CALL(glUseProgram(0));
+#ifndef NDEBUG
+  GLStateCache::Instance().UseProgram(0);
+#endif
 }
 
 void Shader::Dispose() 
@@ -216,6 +243,7 @@ void Shader::Dispose()
   if (m_Program) 
   {
     CALL(glDeleteProgram(m_Program));
+    GLStateCache::Instance().OnDeleteProgram(m_Program);
     m_Program = 0;
   }
 }
\ No newline at end of file
@@ -4,6 +4,14 @@
 #include <algorithm>
 
 #include "Core/Core.h"
+#include "Core/SamplerCache.h"
+#include "Core/GLStateCache.h"
+
+#include "Profiling/Counters.h"
+
+#include "Trace/GLTrace.h"
+
+#include "Utility/MappedFile/MappedFile.h"
 
 #include "Vendor/stb_image/stb_image.h"
 
@@ -29,50 +37,57 @@ void Texture::SetTexParameter(int parameter, int value)
   {
     m_TexParameters.at(parameter) = value;
   }
+
+  if (m_ID)
+  {
+    ResolveSampler();
+  }
 }
 
 void Texture::LoadFromFile(const char* path, unsigned int target, int flipTexture, unsigned int dataType)
 {
-  m_Target = target;
-
-  CALL(glGenTextures(1, &m_ID));
-  Bind();
-
-  std::unordered_map<int, int> tempTexParams{ Texture::defaultTexParameters };
-  m_TexParameters.merge(tempTexParams);
-  std::for_each(
-    std::begin(m_TexParameters),
-    std::end(m_TexParameters),
-    [&](const std::pair<int, int>& param) -> void
-    {
-      CALL(glTexParameteri(m_Target, param.first, param.second));
-    }
-  );
-
-
-  stbi_set_flip_vertically_on_load(flipTexture);
-  unsigned char* data = stbi_load(path, &m_Width, &m_Height, &m_BitDepth, 0);
+  // decoded straight out of the mapped pages, stb allocations are served by the DecodeBufferPool
+  MappedFile file{ path };
+  stbi_set_flip_vertically_on_load_thread(flipTexture);
+  int width    = 0;
+  int height   = 0;
+  int bitDepth = 0;
+  unsigned char* data = stbi_load_from_memory(file.GetData(), static_cast<int>(file.GetSize()), &width, &height, &bitDepth, 0);
 
   if (data)
   {
     unsigned int format;
-    switch (m_BitDepth)
+    unsigned int internalFormat;
+    switch (bitDepth)
     {
     case 1:
-      format = GL_RED;
+      format         = GL_RED;
+      internalFormat = GL_R8;
       break;
     case 3:
-      format = GL_RGB;
+      format         = GL_RGB;
+      internalFormat = GL_RGB8;
       break;
     case 4:
-      format = GL_RGBA;
+      format         = GL_RGBA;
+      internalFormat = GL_RGBA8;
       break;
     default:
+      stbi_image_free(data);
       throw std::exception{ "[ERROR] Could not load texture, error while trying to determine data format." };
     }
 
-    CALL(glTexImage2D(m_Target, 0, format, m_Width, m_Height, 0, format, dataType, data));
-    CALL(glGenerateMipmap(m_Target));
+    int levels = 1;
+    while ((std::max(width, height) >> levels) > 0)
+    {
+      ++levels;
+    }
+
+    Allocate(width, height, levels, internalFormat, target);
+    m_BitDepth = bitDepth;
+
+    SetLevelData(0, m_Width, m_Height, format, dataType, data);
+    GenerateMipmaps();
     stbi_image_free(data);
   }
   else
@@ -81,18 +96,170 @@ void Texture::LoadFromFile(const char* path, unsigned int target, int flipTextur
     outStream << "[ERROR] Could not load texture, path: " << path;
     throw std::exception{ outStream.str().c_str() };
   }
+}
+
+void Texture::Allocate(int width, int height, int levels, unsigned int internalFormat, unsigned int target)
+{
+  if (m_ID)
+  {
+    throw std::exception{ "[ERROR] Could not allocate texture, texture already allocated." };
+  }
+
+  m_Target = target;
+  m_Width  = width;
+  m_Height = height;
+  m_Levels = levels;
+
+  m_DirectStateAccess = IsDirectStateAccessEnabled();
+  if (m_DirectStateAccess)
+  {
+    CALL(glCreateTextures(m_Target, 1, &m_ID));
+    CALL(glTextureStorage2D(m_ID, m_Levels, internalFormat, m_Width, m_Height));
+    GL_TRACE_RECORD(TextureStorage(m_ID, m_Target, m_Levels, internalFormat, m_Width, m_Height));
+    ResolveSampler();
+    return;
+  }
+
+  CALL(glGenTextures(1, &m_ID));
+  Bind();
+
+  if (GLEW_ARB_texture_storage)
+  {
+    CALL(glTexStorage2D(m_Target, m_Levels, internalFormat, m_Width, m_Height));
+  }
+  else
+  {
+    // mutable fallback, every level has to be specified for the texture to be complete
+    CALL(glTexParameteri(m_Target, GL_TEXTURE_BASE_LEVEL, 0));
+    CALL(glTexParameteri(m_Target, GL_TEXTURE_MAX_LEVEL, m_Levels - 1));
+    for (int level = 0; level < m_Levels; ++level)
+    {
+      int levelWidth  = std::max(1, m_Width >> level);
+      int levelHeight = std::max(1, m_Height >> level);
+      CALL(glTexImage2D(m_Target, level, internalFormat, levelWidth, levelHeight, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr));
+    }
+  }
 
   UnBind();
+  GL_TRACE_RECORD(TextureStorage(m_ID, m_Target, m_Levels, internalFormat, m_Width, m_Height));
+
+  ResolveSampler();
+}
+
+void Texture::Reallocate(int width, int height, int levels, unsigned int internalFormat)
+{
+  unsigned int target = m_Target ? m_Target : Texture::defaultTarget;
+  std::unordered_map<int, int> texParameters{ std::move(m_TexParameters) };
+  int bitDepth = m_BitDepth;
+
+  Dispose();
+  m_TexParameters = std::move(texParameters);
+  Allocate(width, height, levels, internalFormat, target);
+  m_BitDepth = bitDepth;
+}
+
+void Texture::SetLevelData(int level, int width, int height, unsigned int format, unsigned int dataType, const void* data)
+{
+  if (level < 0 || level >= m_Levels)
+  {
+    throw std::exception{ "[ERROR] Could not upload texture level, level out of allocated range." };
+  }
+
+  CALL(glPixelStorei(GL_UNPACK_ALIGNMENT, 1));
+  if (m_DirectStateAccess)
+  {
+    CALL(glTextureSubImage2D(m_ID, level, 0, 0, width, height, format, dataType, data));
+  }
+  else
+  {
+    Bind();
+    CALL(glTexSubImage2D(m_Target, level, 0, 0, width, height, format, dataType, data));
+    UnBind();
+  }
+  CALL(glPixelStorei(GL_UNPACK_ALIGNMENT, 4));
+  GL_TRACE_RECORD(TextureLevel(m_ID, level, width, height, format, dataType, data));
+  if (data)
+  {
+    Counters::Instance().Add(Counter::TEXTURE_UPLOADS);
+    Counters::Instance().Add(Counter::TEXTURE_BYTES, static_cast<std::uint64_t>(width) * height * Texture::GetTexelSize(format, dataType));
+  }
+}
+
+std::size_t Texture::GetTexelSize(unsigned int format, unsigned int dataType)
+{
+  std::size_t components = 4;
+  switch (format)
+  {
+  case GL_RED:  components = 1; break;
+  case GL_RG:   components = 2; break;
+  case GL_RGB:  components = 3; break;
+  case GL_RGBA: components = 4; break;
+  default:                      break;
+  }
+
+  switch (dataType)
+  {
+  case GL_FLOAT:          return components * 4;
+  case GL_HALF_FLOAT:
+  case GL_UNSIGNED_SHORT: return components * 2;
+  default:                return components;
+  }
+}
+
+void Texture::GenerateMipmaps()
+{
+  GL_TRACE_RECORD(GenerateMipmap(m_ID));
+  if (m_DirectStateAccess)
+  {
+    CALL(glGenerateTextureMipmap(m_ID));
+    return;
+  }
+
+  Bind();
+  CALL(glGenerateMipmap(m_Target));
+  UnBind();
 }
 
 void Texture::Bind() const
 {
-  CALL(glBindTexture(m_Target, m_ID));
+  GLStateCache::Instance().BindTexture(m_Target, m_ID);
+}
+
+void Texture::Bind(unsigned int unit) const
+{
+  Bind(unit, m_Sampler);
+}
+
+void Texture::Bind(unsigned int unit, unsigned int sampler) const
+{
+  GLStateCache::Instance().BindTexture(unit, m_Target, m_ID);
+  GLStateCache::Instance().BindSampler(unit, sampler);
 }
 
 void Texture::UnBind() const
 {
-  CALL(glBindTexture(m_Target, 0));
+#ifndef NDEBUG
+  GLStateCache::Instance().BindTexture(m_Target, 0);
+#endif
+}
+
+void Texture::UnBind(unsigned int unit) const
+{
+#ifndef NDEBUG
+  GLStateCache::Instance().BindTexture(unit, m_Target, 0);
+  GLStateCache::Instance().BindSampler(unit, 0);
+#else
+  (void)unit;
+#endif
+}
+
+void Texture::ResolveSampler()
+{
+  std::unordered_map<int, int> tempTexParams{ Texture::defaultTexParameters };
+  m_TexParameters.merge(tempTexParams);
+
+  // wrap and filter state lives in shared sampler objects, equal parameter sets share one sampler
+  m_Sampler = SamplerCache::Instance().Get(m_TexParameters);
 }
 
 void Texture::Dispose()
@@ -100,10 +267,14 @@ void Texture::Dispose()
   if (m_ID) 
   {
     CALL(glDeleteTextures(1, &m_ID));
+    GLStateCache::Instance().OnDeleteTexture(m_ID);
     m_ID       = 0;
     m_Width    = 0;
     m_Height   = 0;
     m_BitDepth = 0;
+    m_Levels   = 0;
+    m_Sampler  = 0;
+    m_DirectStateAccess = false;
     m_TexParameters.clear();
   }
 }
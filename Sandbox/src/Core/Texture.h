@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstddef>
 #include <unordered_map>
 
 #include <GL/glew.h>
@@ -15,12 +16,57 @@ public:
                     int flipTexture         = Texture::defaultFlip      ,
                     unsigned int dataType   = Texture::defaultDataType  );
 
+  void Allocate(int width                                               ,
+                int height                                              ,
+                int levels                                              ,
+                unsigned int internalFormat                             ,
+                unsigned int target     = Texture::defaultTarget        );
+  // new storage in place of the current one, immutable storage cannot be resized so the GL name changes,
+  // the Texture object and its sampler parameters stay, bind through it instead of caching GetID
+  void Reallocate(int width, int height, int levels, unsigned int internalFormat);
+  void SetLevelData(int level, int width, int height, unsigned int format, unsigned int dataType, const void* data);
+  void GenerateMipmaps();
+
+  // bytes of one texel of client data in the given format and type
+  static std::size_t GetTexelSize(unsigned int format, unsigned int dataType);
+
+  inline unsigned int GetID() const
+  {
+    return m_ID;
+  }
+
+  inline int GetWidth() const
+  {
+    return m_Width;
+  }
+
+  inline int GetHeight() const
+  {
+    return m_Height;
+  }
+
+  inline int GetLevels() const
+  {
+    return m_Levels;
+  }
+
+  inline unsigned int GetSampler() const
+  {
+    return m_Sampler;
+  }
+
+  // unit is an index, 0 for GL_TEXTURE0, the value the sampler uniform is set to
   void Bind() const;
+  void Bind(unsigned int unit) const;
+  void Bind(unsigned int unit, unsigned int sampler) const;
   void UnBind() const;
+  void UnBind(unsigned int unit) const;
 
   void Dispose();
 
 private:
+  void ResolveSampler();
+
   static constexpr unsigned int defaultTarget     = GL_TEXTURE_2D;
   static constexpr int          defaultFlip       = GL_TRUE;
   static constexpr unsigned int defaultDataType   = GL_UNSIGNED_BYTE;
@@ -32,6 +78,9 @@ private:
   int m_Width           = 0;
   int m_Height          = 0;
   int m_BitDepth        = 0;
+  int m_Levels          = 0;
+  unsigned int m_Sampler = 0;
+  bool m_DirectStateAccess = false;
 
   std::unordered_map<int, int> m_TexParameters{};
 };
@@ -0,0 +1,342 @@
+#include "TextureStreamer.h"
+
+#include <sstream>
+#include <algorithm>
+#include <cmath>
+
+#include "Core/Core.h"
+
+#include "Jobs/JobSystem.h"
+
+#include "Utility/MappedFile/MappedFile.h"
+
+#include "Vendor/stb_image/stb_image.h"
+
+TextureStreamer::TextureStreamer() :
+  TextureStreamer(TextureStreamer::defaultBudget)
+{
+}
+
+TextureStreamer::TextureStreamer(std::size_t budgetBytes) :
+  m_Budget        { budgetBytes                           },
+  m_MaxUploadBytes{ TextureStreamer::defaultMaxUploadBytes }
+{
+}
+
+TextureStreamer::~TextureStreamer()
+{
+  Dispose();
+}
+
+TextureStreamer::Handle TextureStreamer::Add(const char* path, int flipTexture)
+{
+  int width    = 0;
+  int height   = 0;
+  int channels = 0;
+
+  MappedFile file{ path };
+  stbi_set_flip_vertically_on_load_thread(flipTexture);
+  unsigned char* data = stbi_load_from_memory(file.GetData(), static_cast<int>(file.GetSize()), &width, &height, &channels, 0);
+  if (!data)
+  {
+    std::ostringstream outStream{};
+    outStream << "[ERROR] Could not load streamed texture, path: " << path;
+    throw std::exception{ outStream.str().c_str() };
+  }
+
+  try
+  {
+    Handle handle = Add(data, width, height, channels);
+    stbi_image_free(data);
+    return handle;
+  }
+  catch (...)
+  {
+    stbi_image_free(data);
+    throw;
+  }
+}
+
+TextureStreamer::Handle TextureStreamer::Add(const unsigned char* pixels, int width, int height, int channels)
+{
+  Entry entry{};
+  switch (channels)
+  {
+  case 1:
+    entry.format         = GL_RED;
+    entry.internalFormat = GL_R8;
+    entry.bytesPerTexel  = 1;
+    break;
+  case 3:
+    entry.format         = GL_RGB;
+    entry.internalFormat = GL_RGB8;
+    entry.bytesPerTexel  = 4; // drivers pad RGB8 to 32 bits
+    break;
+  case 4:
+    entry.format         = GL_RGBA;
+    entry.internalFormat = GL_RGBA8;
+    entry.bytesPerTexel  = 4;
+    break;
+  default:
+    throw std::exception{ "[ERROR] Could not load streamed texture, error while trying to determine data format." };
+  }
+
+  GenerateMipChain(entry, pixels, width, height, channels);
+
+  // low mips first, everything up to initialResidentSize stays resident for the texture lifetime
+  int coarsestLevel = static_cast<int>(entry.levels.size()) - 1;
+  while (coarsestLevel > 0 &&
+         std::max(entry.levels[coarsestLevel - 1].width, entry.levels[coarsestLevel - 1].height) <= TextureStreamer::initialResidentSize)
+  {
+    --coarsestLevel;
+  }
+
+  entry.coarsestLevel  = coarsestLevel;
+  entry.requestedLevel = coarsestLevel;
+  entry.targetLevel    = coarsestLevel;
+  entry.residentLevel  = static_cast<int>(entry.levels.size());
+  entry.texture        = std::make_unique<Texture>();
+  MakeResident(entry, coarsestLevel);
+
+  m_Entries.push_back(std::move(entry));
+  return m_Entries.size() - 1;
+}
+
+void TextureStreamer::RequestScreenSize(Handle handle, float pixels)
+{
+  Entry& entry = m_Entries.at(handle);
+
+  int level = entry.coarsestLevel;
+  if (pixels > 0.0f)
+  {
+    float texels = static_cast<float>(std::max(entry.levels[0].width, entry.levels[0].height));
+    level = static_cast<int>(std::floor(std::log2(std::max(texels / pixels, 1.0f))));
+    level = std::clamp(level, 0, entry.coarsestLevel);
+  }
+
+  if (!entry.requestedThisUpdate || level < entry.requestedLevel)
+  {
+    entry.requestedLevel = level;
+  }
+  entry.requestedThisUpdate = true;
+}
+
+void TextureStreamer::Update()
+{
+  std::size_t total = 0;
+  for (Entry& entry : m_Entries)
+  {
+    if (!entry.requestedThisUpdate)
+    {
+      entry.requestedLevel = entry.coarsestLevel;
+    }
+    entry.requestedThisUpdate = false;
+    entry.targetLevel = entry.requestedLevel;
+    total += ResidentBytes(entry, entry.targetLevel);
+  }
+
+  // over budget, repeatedly drop the most expensive top level until everything fits
+  while (total > m_Budget)
+  {
+    Entry* victim = nullptr;
+    for (Entry& entry : m_Entries)
+    {
+      if (entry.targetLevel < entry.coarsestLevel &&
+          (!victim || LevelBytes(entry, entry.targetLevel) > LevelBytes(*victim, victim->targetLevel)))
+      {
+        victim = &entry;
+      }
+    }
+
+    if (!victim)
+    {
+      break;
+    }
+
+    total -= LevelBytes(*victim, victim->targetLevel);
+    ++victim->targetLevel;
+  }
+
+  std::vector<Entry*> upgrades{};
+  for (Entry& entry : m_Entries)
+  {
+    if (entry.targetLevel > entry.residentLevel)
+    {
+      MakeResident(entry, entry.targetLevel);
+      ++m_Downgrades;
+    }
+    else if (entry.targetLevel < entry.residentLevel)
+    {
+      upgrades.push_back(&entry);
+    }
+  }
+
+  // furthest from the requested quality first, one level per texture per update
+  std::sort(
+    std::begin(upgrades),
+    std::end(upgrades),
+    [](const Entry* lhs, const Entry* rhs) -> bool
+    {
+      return lhs->residentLevel - lhs->targetLevel > rhs->residentLevel - rhs->targetLevel;
+    }
+  );
+
+  std::size_t uploaded = 0;
+  for (Entry* entry : upgrades)
+  {
+    std::size_t cost = ResidentBytes(*entry, entry->residentLevel - 1);
+    if (uploaded > 0 && uploaded + cost > m_MaxUploadBytes)
+    {
+      break;
+    }
+
+    MakeResident(*entry, entry->residentLevel - 1);
+    uploaded += cost;
+    ++m_Upgrades;
+  }
+}
+
+void TextureStreamer::SetBudget(std::size_t budgetBytes)
+{
+  m_Budget = budgetBytes;
+}
+
+void TextureStreamer::SetMaxUploadBytesPerUpdate(std::size_t bytes)
+{
+  m_MaxUploadBytes = bytes;
+}
+
+const Texture& TextureStreamer::GetTexture(Handle handle) const
+{
+  return *m_Entries.at(handle).texture;
+}
+
+int TextureStreamer::GetResidentLevel(Handle handle) const
+{
+  return m_Entries.at(handle).residentLevel;
+}
+
+int TextureStreamer::GetRequestedLevel(Handle handle) const
+{
+  return m_Entries.at(handle).requestedLevel;
+}
+
+TextureStreamer::Statistics TextureStreamer::GetStatistics() const
+{
+  Statistics statistics{};
+  statistics.textureCount  = m_Entries.size();
+  statistics.residentBytes = m_ResidentBytes;
+  statistics.budgetBytes   = m_Budget;
+  statistics.uploadedBytes = m_UploadedBytes;
+  statistics.upgrades      = m_Upgrades;
+  statistics.downgrades    = m_Downgrades;
+
+  for (const Entry& entry : m_Entries)
+  {
+    statistics.requestedBytes += ResidentBytes(entry, entry.requestedLevel);
+    if (entry.residentLevel == 0)
+    {
+      ++statistics.fullyResidentCount;
+    }
+  }
+
+  return statistics;
+}
+
+void TextureStreamer::Dispose()
+{
+  m_Entries.clear();
+  m_ResidentBytes = 0;
+}
+
+void TextureStreamer::GenerateMipChain(Entry& entry, const unsigned char* data, int width, int height, int channels)
+{
+  MipLevel base{};
+  base.width  = width;
+  base.height = height;
+  base.pixels.assign(data, data + static_cast<std::size_t>(width) * height * channels);
+  entry.levels.push_back(std::move(base));
+
+  while (entry.levels.back().width > 1 || entry.levels.back().height > 1)
+  {
+    const MipLevel& src = entry.levels.back();
+
+    MipLevel dst{};
+    dst.width  = std::max(1, src.width / 2);
+    dst.height = std::max(1, src.height / 2);
+    dst.pixels.resize(static_cast<std::size_t>(dst.width) * dst.height * channels);
+
+    JobSystem::Instance().ParallelFor(static_cast<std::size_t>(dst.height), TextureStreamer::mipRowGrain, [&](std::size_t begin, std::size_t end)
+    {
+      for (int y = static_cast<int>(begin); y < static_cast<int>(end); ++y)
+      {
+        int y0 = std::min(y * 2, src.height - 1);
+        int y1 = std::min(y * 2 + 1, src.height - 1);
+        for (int x = 0; x < dst.width; ++x)
+        {
+          int x0 = std::min(x * 2, src.width - 1);
+          int x1 = std::min(x * 2 + 1, src.width - 1);
+          for (int c = 0; c < channels; ++c)
+          {
+            int sum = src.pixels[(static_cast<std::size_t>(y0) * src.width + x0) * channels + c] +
+                      src.pixels[(static_cast<std::size_t>(y0) * src.width + x1) * channels + c] +
+                      src.pixels[(static_cast<std::size_t>(y1) * src.width + x0) * channels + c] +
+                      src.pixels[(static_cast<std::size_t>(y1) * src.width + x1) * channels + c];
+            dst.pixels[(static_cast<std::size_t>(y) * dst.width + x) * channels + c] = static_cast<unsigned char>((sum + 2) / 4);
+          }
+        }
+      }
+    });
+
+    entry.levels.push_back(std::move(dst));
+  }
+}
+
+std::size_t TextureStreamer::LevelBytes(const Entry& entry, int level)
+{
+  const MipLevel& mip = entry.levels[level];
+  return static_cast<std::size_t>(mip.width) * mip.height * entry.bytesPerTexel;
+}
+
+std::size_t TextureStreamer::ResidentBytes(const Entry& entry, int fromLevel)
+{
+  std::size_t bytes = 0;
+  for (int level = fromLevel; level < static_cast<int>(entry.levels.size()); ++level)
+  {
+    bytes += LevelBytes(entry, level);
+  }
+  return bytes;
+}
+
+void TextureStreamer::MakeResident(Entry& entry, int level)
+{
+  if (entry.residentLevel < static_cast<int>(entry.levels.size()))
+  {
+    m_ResidentBytes -= ResidentBytes(entry, entry.residentLevel);
+  }
+
+  // immutable storage cannot change its level count, a smaller or larger chain is a new allocation
+  // behind the same Texture object
+  Texture& texture = *entry.texture;
+  const int levels = static_cast<int>(entry.levels.size()) - level;
+  if (texture.GetID())
+  {
+    texture.Reallocate(entry.levels[level].width, entry.levels[level].height, levels, entry.internalFormat);
+  }
+  else
+  {
+    texture.Allocate(entry.levels[level].width, entry.levels[level].height, levels, entry.internalFormat);
+  }
+
+  for (int source = level; source < static_cast<int>(entry.levels.size()); ++source)
+  {
+    const MipLevel& mip = entry.levels[source];
+    texture.SetLevelData(source - level, mip.width, mip.height, entry.format, GL_UNSIGNED_BYTE, mip.pixels.data());
+  }
+
+  std::size_t bytes = ResidentBytes(entry, level);
+  m_ResidentBytes += bytes;
+  m_UploadedBytes += bytes;
+
+  entry.residentLevel = level;
+}
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <vector>
+#include <memory>
+#include <cstddef>
+
+#include <GL/glew.h>
+
+#include "Core/Texture.h"
+
+class TextureStreamer {
+public:
+  using Handle = std::size_t;
+
+  struct Statistics {
+    std::size_t textureCount        = 0;
+    std::size_t fullyResidentCount  = 0;
+    std::size_t residentBytes       = 0;
+    std::size_t requestedBytes      = 0;
+    std::size_t budgetBytes         = 0;
+    std::size_t uploadedBytes       = 0;
+    std::size_t upgrades            = 0;
+    std::size_t downgrades          = 0;
+  };
+
+  TextureStreamer();
+  TextureStreamer(std::size_t budgetBytes);
+  ~TextureStreamer();
+
+  Handle Add(const char* path, int flipTexture = TextureStreamer::defaultFlip);
+  // tightly packed 8 bit pixels with 1, 3 or 4 channels, copied into the CPU side mip chain
+  Handle Add(const unsigned char* pixels, int width, int height, int channels);
+
+  // screen space size (in pixels) of the largest on-screen extent of the texture,
+  // must be requested every update, otherwise the texture decays to its coarsest levels
+  void RequestScreenSize(Handle handle, float pixels);
+
+  void Update();
+
+  void SetBudget(std::size_t budgetBytes);
+  void SetMaxUploadBytesPerUpdate(std::size_t bytes);
+
+  // one Texture per handle for the lifetime of the streamer, a residency change reallocates its storage in place,
+  // so the reference stays valid but the GL name does not, bind through the Texture (a Material does) every frame
+  const Texture& GetTexture(Handle handle) const;
+  int GetResidentLevel(Handle handle) const;
+  int GetRequestedLevel(Handle handle) const;
+
+  Statistics GetStatistics() const;
+
+  void Dispose();
+
+private:
+  struct MipLevel {
+    int width  = 0;
+    int height = 0;
+    std::vector<unsigned char> pixels{};
+  };
+
+  struct Entry {
+    std::vector<MipLevel> levels{};
+    unsigned int format         = 0;
+    unsigned int internalFormat = 0;
+    int bytesPerTexel           = 0;
+    int coarsestLevel           = 0;
+    int residentLevel           = 0;
+    int requestedLevel          = 0;
+    int targetLevel             = 0;
+    bool requestedThisUpdate    = false;
+    std::unique_ptr<Texture> texture{};   // heap allocated, references survive m_Entries growing
+  };
+
+  static void GenerateMipChain(Entry& entry, const unsigned char* data, int width, int height, int channels);
+  static std::size_t LevelBytes(const Entry& entry, int level);
+  static std::size_t ResidentBytes(const Entry& entry, int fromLevel);
+
+  void MakeResident(Entry& entry, int level);
+
+  static constexpr int         defaultFlip                 = GL_TRUE;
+  static constexpr std::size_t defaultBudget               = 256 * 1024 * 1024;
+  static constexpr std::size_t defaultMaxUploadBytes       = 8 * 1024 * 1024;
+  static constexpr int         initialResidentSize         = 64;
+  static constexpr std::size_t mipRowGrain                 = 64;
+
+  std::vector<Entry> m_Entries{};
+  std::size_t m_Budget               = 0;
+  std::size_t m_MaxUploadBytes       = 0;
+  std::size_t m_ResidentBytes        = 0;
+  std::size_t m_UploadedBytes        = 0;
+  std::size_t m_Upgrades             = 0;
+  std::size_t m_Downgrades           = 0;
+};
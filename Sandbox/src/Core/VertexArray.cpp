@@ -0,0 +1,226 @@
+#include "VertexArray.h"
+
+#include "Core/Core.h"
+#include "Core/GLStateCache.h"
+
+#include "Trace/GLTrace.h"
+
+VertexArray::VertexArray()
+{
+  m_DirectStateAccess = IsDirectStateAccessEnabled();
+  if (m_DirectStateAccess)
+  {
+    CALL(glCreateVertexArrays(1, &m_ID));
+  }
+  else
+  {
+    CALL(glGenVertexArrays(1, &m_ID));
+  }
+}
+
+VertexArray::~VertexArray()
+{
+  Dispose();
+}
+
+void VertexArray::SetVertexBuffer(unsigned int binding, unsigned int buffer, std::ptrdiff_t offset, int stride)
+{
+  VertexBinding& vertexBinding = m_Bindings.at(binding);
+  if (vertexBinding.buffer == buffer && vertexBinding.offset == offset && vertexBinding.stride == stride)
+  {
+    return;
+  }
+
+  vertexBinding.buffer = buffer;
+  vertexBinding.offset = offset;
+  vertexBinding.stride = stride;
+
+  if (m_DirectStateAccess)
+  {
+    CALL(glVertexArrayVertexBuffer(m_ID, binding, buffer, offset, stride));
+  }
+
+  for (unsigned int location = 0; location < VertexArray::maxAttributes; ++location)
+  {
+    if (m_Attributes[location].enabled && m_Attributes[location].binding == binding)
+    {
+      if (m_DirectStateAccess)
+      {
+        TraceAttribute(location);
+      }
+      else
+      {
+        ApplyAttribute(location);
+      }
+    }
+  }
+}
+
+void VertexArray::SetBindingDivisor(unsigned int binding, unsigned int divisor)
+{
+  m_Bindings.at(binding).divisor = divisor;
+
+  if (m_DirectStateAccess)
+  {
+    CALL(glVertexArrayBindingDivisor(m_ID, binding, divisor));
+  }
+
+  for (unsigned int location = 0; location < VertexArray::maxAttributes; ++location)
+  {
+    if (m_Attributes[location].enabled && m_Attributes[location].binding == binding)
+    {
+      if (m_DirectStateAccess)
+      {
+        TraceAttribute(location);
+      }
+      else
+      {
+        ApplyAttribute(location);
+      }
+    }
+  }
+}
+
+void VertexArray::SetIndexBuffer(unsigned int buffer)
+{
+  if (m_DirectStateAccess)
+  {
+    CALL(glVertexArrayElementBuffer(m_ID, buffer));
+    GL_TRACE_RECORD(IndexBuffer(m_ID, buffer));
+    return;
+  }
+
+  Bind();
+  GLStateCache::Instance().BindBuffer(GL_ELEMENT_ARRAY_BUFFER, buffer);
+}
+
+void VertexArray::SetAttribute(unsigned int location, unsigned int binding, int size, unsigned int type, bool normalized, unsigned int relativeOffset)
+{
+  Attribute& attribute = m_Attributes.at(location);
+  attribute.enabled        = true;
+  attribute.integer        = false;
+  attribute.binding        = binding;
+  attribute.size           = size;
+  attribute.type           = type;
+  attribute.normalized     = normalized;
+  attribute.relativeOffset = relativeOffset;
+
+  if (m_DirectStateAccess)
+  {
+    CALL(glEnableVertexArrayAttrib(m_ID, location));
+    CALL(glVertexArrayAttribFormat(m_ID, location, size, type, normalized ? GL_TRUE : GL_FALSE, relativeOffset));
+    CALL(glVertexArrayAttribBinding(m_ID, location, binding));
+    TraceAttribute(location);
+    return;
+  }
+
+  ApplyAttribute(location);
+}
+
+void VertexArray::SetIntegerAttribute(unsigned int location, unsigned int binding, int size, unsigned int type, unsigned int relativeOffset)
+{
+  Attribute& attribute = m_Attributes.at(location);
+  attribute.enabled        = true;
+  attribute.integer        = true;
+  attribute.binding        = binding;
+  attribute.size           = size;
+  attribute.type           = type;
+  attribute.normalized     = false;
+  attribute.relativeOffset = relativeOffset;
+
+  if (m_DirectStateAccess)
+  {
+    CALL(glEnableVertexArrayAttrib(m_ID, location));
+    CALL(glVertexArrayAttribIFormat(m_ID, location, size, type, relativeOffset));
+    CALL(glVertexArrayAttribBinding(m_ID, location, binding));
+    TraceAttribute(location);
+    return;
+  }
+
+  ApplyAttribute(location);
+}
+
+void VertexArray::DisableAttribute(unsigned int location)
+{
+  m_Attributes.at(location).enabled = false;
+
+  if (m_DirectStateAccess)
+  {
+    CALL(glDisableVertexArrayAttrib(m_ID, location));
+    return;
+  }
+
+  Bind();
+  CALL(glDisableVertexAttribArray(location));
+}
+
+void VertexArray::Bind() const
+{
+  GLStateCache::Instance().BindVertexArray(m_ID);
+}
+
+void VertexArray::UnBind() const
+{
+#ifndef NDEBUG
+  GLStateCache::Instance().BindVertexArray(0);
+#endif
+}
+
+void VertexArray::Dispose()
+{
+  if (m_ID)
+  {
+    CALL(glDeleteVertexArrays(1, &m_ID));
+    GLStateCache::Instance().OnDeleteVertexArray(m_ID);
+    m_ID = 0;
+    m_Bindings.fill(VertexBinding{});
+    m_Attributes.fill(Attribute{});
+  }
+}
+
+void VertexArray::ApplyAttribute(unsigned int location) const
+{
+  const Attribute& attribute = m_Attributes[location];
+  const VertexBinding& vertexBinding = m_Bindings[attribute.binding];
+  if (!vertexBinding.buffer)
+  {
+    // specified again once the binding gets a buffer
+    return;
+  }
+
+  Bind();
+  GLStateCache::Instance().BindBuffer(GL_ARRAY_BUFFER, vertexBinding.buffer);
+
+  const void* pointer = reinterpret_cast<const void*>(vertexBinding.offset + attribute.relativeOffset);
+  if (attribute.integer)
+  {
+    CALL(glVertexAttribIPointer(location, attribute.size, attribute.type, vertexBinding.stride, pointer));
+  }
+  else
+  {
+    CALL(glVertexAttribPointer(location, attribute.size, attribute.type, attribute.normalized ? GL_TRUE : GL_FALSE, vertexBinding.stride, pointer));
+  }
+  CALL(glVertexAttribDivisor(location, vertexBinding.divisor));
+  CALL(glEnableVertexAttribArray(location));
+  TraceAttribute(location);
+}
+
+void VertexArray::TraceAttribute(unsigned int location) const
+{
+#ifdef GL_TRACE
+  const Attribute& attribute = m_Attributes[location];
+  const VertexBinding& vertexBinding = m_Bindings[attribute.binding];
+  GL_TRACE_RECORD(VertexAttribute(m_ID                                             ,
+                                  location                                         ,
+                                  vertexBinding.buffer                             ,
+                                  vertexBinding.offset + attribute.relativeOffset  ,
+                                  vertexBinding.stride                             ,
+                                  attribute.size                                   ,
+                                  attribute.type                                   ,
+                                  attribute.normalized                             ,
+                                  attribute.integer                                ,
+                                  vertexBinding.divisor                            ));
+#else
+  (void)location;
+#endif
+}
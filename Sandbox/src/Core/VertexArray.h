@@ -0,0 +1,67 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+
+#include <GL/glew.h>
+
+class VertexArray {
+public:
+  VertexArray();
+  ~VertexArray();
+
+  // binding points as in glVertexArrayVertexBuffer, attributes reference them by index
+  void SetVertexBuffer(unsigned int binding, unsigned int buffer, std::ptrdiff_t offset, int stride);
+  void SetBindingDivisor(unsigned int binding, unsigned int divisor);
+  void SetIndexBuffer(unsigned int buffer);
+
+  void SetAttribute(unsigned int location                                           ,
+                    unsigned int binding                                            ,
+                    int size                                                        ,
+                    unsigned int type                                               ,
+                    bool normalized                                                 ,
+                    unsigned int relativeOffset                                     );
+  void SetIntegerAttribute(unsigned int location, unsigned int binding, int size, unsigned int type, unsigned int relativeOffset);
+
+  void DisableAttribute(unsigned int location);
+
+  inline unsigned int GetID() const
+  {
+    return m_ID;
+  }
+
+  void Bind() const;
+  void UnBind() const;
+
+  void Dispose();
+
+private:
+  struct VertexBinding {
+    unsigned int buffer   = 0;
+    std::ptrdiff_t offset = 0;
+    int stride            = 0;
+    unsigned int divisor  = 0;
+  };
+
+  struct Attribute {
+    bool enabled                = false;
+    bool integer                = false;
+    unsigned int binding        = 0;
+    int size                    = 0;
+    unsigned int type           = 0;
+    bool normalized             = false;
+    unsigned int relativeOffset = 0;
+  };
+
+  // bind-to-edit fallback, re-specifies the attribute with its binding's buffer, stride and offset
+  void ApplyAttribute(unsigned int location) const;
+  void TraceAttribute(unsigned int location) const;
+
+  static constexpr std::size_t maxBindings   = 16;
+  static constexpr std::size_t maxAttributes = 16;
+
+  unsigned int m_ID = 0;
+  bool m_DirectStateAccess = false;
+  std::array<VertexBinding, maxBindings> m_Bindings{};
+  std::array<Attribute, maxAttributes> m_Attributes{};
+};
@@ -12,6 +12,9 @@ const std::unordered_map<int, int> Window::defaultWindowHints{
   { GLFW_CONTEXT_VERSION_MINOR, 3 },
   { GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE },
   { GLFW_SAMPLES, 4 },
+#ifndef NDEBUG
+  { GLFW_OPENGL_DEBUG_CONTEXT, GLFW_TRUE },
+#endif
 };
 
 Window::Window() :
@@ -56,6 +59,7 @@ Window::Window(std::string title    ,
 Window::~Window() 
 {
   if (m_Window) {
+    DestroyFramebuffer();
     glfwDestroyWindow(m_Window);
   }
   glfwTerminate();
@@ -78,6 +82,26 @@ void Window::SetHint(int hint, int value)
   }
 }
 
+void Window::SetHeadless(bool headless)
+{
+  if (m_Window)
+  {
+    throw std::exception{ "[ERROR::GLFW] Window already initialized" };
+  }
+
+  m_Headless = headless;
+}
+
+void Window::SetFrameLimit(std::uint64_t frames)
+{
+  m_FrameLimit = frames;
+}
+
+void Window::SetFixedTimestep(double seconds)
+{
+  m_FixedTimestep = seconds;
+}
+
 void Window::SetFramebufferSizeCallback(framebufferSizeCallback callback) 
 {
   if (m_Window) 
@@ -144,6 +168,11 @@ void Window::Initialize()
     throw std::exception{ "[ERROR::GLFW] Could not init GLFW" };
   }
 
+  if (m_Headless)
+  {
+    m_WindowHints[GLFW_VISIBLE] = GLFW_FALSE;
+  }
+
   std::unordered_map<int, int> tempWindowHints{ Window::defaultWindowHints };
   m_WindowHints.merge(tempWindowHints);
   std::for_each(
@@ -155,7 +184,7 @@ void Window::Initialize()
     }
   );
 
-  if (m_Fullscreen)
+  if (m_Fullscreen && !m_Headless)
   {
     GLFWmonitor* monitor = glfwGetPrimaryMonitor();
     const GLFWvidmode* videoMode = glfwGetVideoMode(monitor);
@@ -179,9 +208,13 @@ void Window::Initialize()
   SetCallbacks();
 
   glfwMakeContextCurrent(m_Window);
-  glfwSwapInterval(defaultSwapInterval);
+  glfwSwapInterval(m_Headless ? 0 : defaultSwapInterval);
 
-  glfwSetInputMode(m_Window, GLFW_CURSOR, GLFW_CURSOR_DISABLED);
+  if (!m_Headless)
+  {
+    glfwSetInputMode(m_Window, GLFW_CURSOR, GLFW_CURSOR_DISABLED);
+    m_CursorCaptured = true;
+  }
 
   glewExperimental = GL_TRUE;
 
@@ -197,6 +230,34 @@ void Window::Initialize()
   }
   Logger::Instance(std::cout).Log() << "[INFO::GLEW] GLEW version: " << glewGetString(GLEW_VERSION);
 
+  if (m_Headless)
+  {
+    CreateFramebuffer();
+  }
+
+}
+
+GLFWwindow* Window::CreateSharedContext()
+{
+  if (!m_Window)
+  {
+    throw std::exception{ "[ERROR::GLFW] Window not initialized" };
+  }
+
+  // the window hints are still set from Initialize, only the visibility differs
+  glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+  GLFWwindow* context = glfwCreateWindow(1, 1, m_Title.c_str(), nullptr, m_Window);
+  auto visible = m_WindowHints.find(GLFW_VISIBLE);
+  glfwWindowHint(GLFW_VISIBLE, visible != std::end(m_WindowHints) ? visible->second : GLFW_TRUE);
+  return context;
+}
+
+void Window::DestroySharedContext(GLFWwindow* context)
+{
+  if (context)
+  {
+    glfwDestroyWindow(context);
+  }
 }
 
 int Window::GetKeyState(int key) const
@@ -232,6 +293,59 @@ float Window::GetScrollYOffset()
   return yScroll;
 }
 
+float Window::GetCursorX() const
+{
+  return m_CursorCaptured ? m_Width / 2.0f : m_MouseLastX;
+}
+
+float Window::GetCursorY() const
+{
+  return m_CursorCaptured ? m_Height / 2.0f : m_MouseLastY;
+}
+
+InputState Window::CaptureInput()
+{
+  InputState input{};
+  std::copy(std::begin(m_KeyboardKeys), std::end(m_KeyboardKeys), std::begin(input.keys));
+  input.mouseXOffset  = GetMouseXOffset();
+  input.mouseYOffset  = GetMouseYOffset();
+  input.scrollXOffset = GetScrollXOffset();
+  input.scrollYOffset = GetScrollYOffset();
+  input.cursorX       = GetCursorX();
+  input.cursorY       = GetCursorY();
+  input.width         = m_Width;
+  input.height        = m_Height;
+  input.time          = GetTime();
+  return input;
+}
+
+bool Window::IsHeadless() const
+{
+  return m_Headless;
+}
+
+std::uint64_t Window::GetFrameIndex() const
+{
+  return m_FrameIndex;
+}
+
+double Window::GetTime() const
+{
+  return m_FixedTimestep > 0.0 ? static_cast<double>(m_FrameIndex) * m_FixedTimestep : glfwGetTime();
+}
+
+unsigned int Window::GetFramebuffer() const
+{
+  return m_Framebuffer;
+}
+
+void Window::ReadPixels(std::vector<unsigned char>& pixels) const
+{
+  pixels.resize(static_cast<std::size_t>(m_Width) * m_Height * 4);
+  CALL(glPixelStorei(GL_PACK_ALIGNMENT, 1));
+  CALL(glReadPixels(0, 0, m_Width, m_Height, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data()));
+}
+
 int Window::GetWidth() const
 {
   return m_Width;
@@ -244,35 +358,64 @@ int Window::GetHeight() const
 
 void Window::SwapBuffers()
 {
+  ++m_FrameIndex;
+  if (m_Headless)
+  {
+    // nothing to present, the flush hands the frame to the GPU like a swap would
+    CALL(glFlush());
+    return;
+  }
+
   glfwSwapBuffers(m_Window);
 }
 
 bool Window::ShouldClose()
 {
-  return glfwWindowShouldClose(m_Window);
+  return glfwWindowShouldClose(m_Window) || (m_FrameLimit && m_FrameIndex >= m_FrameLimit);
 }
 
-void Window::CalculateFPS()
+void Window::CreateFramebuffer()
 {
-  static double prevSeconds = glfwGetTime();
-  static int frameCount = 0;
-
-  double curSeconds = glfwGetTime();
-  double elapsedSeconds = curSeconds - prevSeconds;
-
-  if (elapsedSeconds > 0.25)
+  CALL(glGenFramebuffers(1, &m_Framebuffer));
+  CALL(glGenRenderbuffers(1, &m_ColorBuffer));
+  CALL(glGenRenderbuffers(1, &m_DepthBuffer));
+
+  CALL(glBindRenderbuffer(GL_RENDERBUFFER, m_ColorBuffer));
+  CALL(glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, m_Width, m_Height));
+  CALL(glBindRenderbuffer(GL_RENDERBUFFER, m_DepthBuffer));
+  CALL(glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, m_Width, m_Height));
+  CALL(glBindRenderbuffer(GL_RENDERBUFFER, 0));
+
+  // stays bound for the lifetime of the window, everything drawn lands in it
+  CALL(glBindFramebuffer(GL_FRAMEBUFFER, m_Framebuffer));
+  CALL(glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, m_ColorBuffer));
+  CALL(glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, m_DepthBuffer));
+
+  CALL(GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER));
+  if (status != GL_FRAMEBUFFER_COMPLETE)
   {
-    prevSeconds = curSeconds;
-    double fps = (double)frameCount / elapsedSeconds;
-
     std::ostringstream outStream{};
-    outStream << m_Title << " @ fps: " << fps;
-    glfwSetWindowTitle(m_Window, outStream.str().c_str());
+    outStream << "[ERROR::GLFW] Headless framebuffer incomplete, status " << status;
+    throw std::exception{ outStream.str().c_str() };
+  }
 
-    frameCount = 0;
+  CALL(glViewport(0, 0, m_Width, m_Height));
+}
+
+void Window::DestroyFramebuffer()
+{
+  if (!m_Framebuffer)
+  {
+    return;
   }
 
-  frameCount++;
+  CALL(glBindFramebuffer(GL_FRAMEBUFFER, 0));
+  CALL(glDeleteFramebuffers(1, &m_Framebuffer));
+  CALL(glDeleteRenderbuffers(1, &m_ColorBuffer));
+  CALL(glDeleteRenderbuffers(1, &m_DepthBuffer));
+  m_Framebuffer = 0;
+  m_ColorBuffer = 0;
+  m_DepthBuffer = 0;
 }
 
 void Window::SetCallbacks()
@@ -341,7 +484,7 @@ void Window::KeyCallback(GLFWwindow* window, int key, int code, int action, int
     glfwSetWindowShouldClose(window, GLFW_TRUE);
   }
 
-  if (key >= 0 && key < 1024) 
+  if (key >= 0 && key < InputState::keyCount) 
   {
     if (action == GLFW_PRESS)
     {
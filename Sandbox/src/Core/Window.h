@@ -2,10 +2,32 @@
 
 #include <unordered_map>
 #include <string>
+#include <vector>
+#include <cstdint>
 
 #include <GL/glew.h>
 #include <GLFW/glfw3.h>
 
+// input of one frame sampled on the thread polling events, a plain copy that can be handed to other threads
+struct InputState {
+  static constexpr int keyCount = 1024;
+
+  int keys[InputState::keyCount]{};
+  float mouseXOffset  = 0.0f;
+  float mouseYOffset  = 0.0f;
+  float scrollXOffset = 0.0f;
+  float scrollYOffset = 0.0f;
+  float cursorX       = 0.0f;
+  float cursorY       = 0.0f;
+  int width           = 0;
+  int height          = 0;
+  double time         = 0.0;
+
+  inline int GetKeyState(int key) const
+  {
+    return keys[key];
+  }
+};
 
 class Window
 {
@@ -33,27 +55,63 @@ public:
   void SetCursorPositionCallback(cursorPosCallback callback);
   void SetScrollCallback(scrollCallback callback);
 
+  // HEADLESS, no visible window and nothing presented, frames are drawn into an offscreen framebuffer of the window
+  // size that stays bound, the context still comes from a hidden native (WGL) window, so a desktop session and an
+  // OpenGL driver are needed, a software one such as Mesa's opengl32.dll next to the executable does for machines
+  // without a GPU, EGL / OSMesa contexts are not supported by the prebuilt GLFW and GLEW libraries
+  void SetHeadless(bool headless);
+
+  // ShouldClose turns true after this many frames, 0 runs until the window is closed
+  void SetFrameLimit(std::uint64_t frames);
+
+  // GetTime advances by exactly this much per frame instead of following the clock, 0 follows the clock
+  void SetFixedTimestep(double seconds);
+
   // INITIALIZE
   void Initialize();
 
+  // hidden context sharing objects with the window, made current on another thread (see ResourceLoader),
+  // has to be created and destroyed on the thread that initialized the window, nullptr on failure
+  GLFWwindow* CreateSharedContext();
+  void DestroySharedContext(GLFWwindow* context);
+
   // GETTERS
   int GetWidth() const;
   int GetHeight() const;
   int GetKeyState(int key) const;
 
+  bool IsHeadless() const;
+  // frames presented so far
+  std::uint64_t GetFrameIndex() const;
+  double GetTime() const;
+  // offscreen framebuffer in headless mode, 0 otherwise
+  unsigned int GetFramebuffer() const;
+
+  // RGBA of the framebuffer drawn to, bottom row first
+  void ReadPixels(std::vector<unsigned char>& pixels) const;
+
   float GetMouseXOffset();
   float GetMouseYOffset();
   float GetScrollXOffset();
   float GetScrollYOffset();
 
+  // cursor position in window pixels, origin top left, the window center while the cursor is captured
+  float GetCursorX() const;
+  float GetCursorY() const;
+
+  // consumes the mouse and scroll offsets like the getters above
+  InputState CaptureInput();
+
   // MANAGEMENT
   void SwapBuffers();
   bool ShouldClose();
-  void CalculateFPS();
 
 private:
   void SetCallbacks();
 
+  void CreateFramebuffer();
+  void DestroyFramebuffer();
+
   // DEFAULT CALLBACKS
   static void ErrorCallback(int, const char*);
   static void FramebufferSizeCallback(GLFWwindow*, int, int);
@@ -75,6 +133,17 @@ private:
   int m_Height;
   bool m_Fullscreen;
 
+  // HEADLESS
+  bool m_Headless = false;
+  unsigned int m_Framebuffer = 0;
+  unsigned int m_ColorBuffer = 0;
+  unsigned int m_DepthBuffer = 0;
+
+  // FRAMES
+  std::uint64_t m_FrameIndex = 0;
+  std::uint64_t m_FrameLimit = 0;
+  double m_FixedTimestep     = 0.0;
+
   errorCallback m_ErrorCb;
   framebufferSizeCallback m_FbSizeCb   = nullptr;
   keyCallback m_KeyCb                  = nullptr;
@@ -84,7 +153,7 @@ private:
   std::unordered_map<int, int> m_WindowHints{};
 
   // KEYBOARD INPUT
-  int m_KeyboardKeys[1024]{};
+  int m_KeyboardKeys[InputState::keyCount]{};
 
   // MOUSE INPUT
   float m_MouseLastX;
@@ -92,6 +161,7 @@ private:
   float m_MouseXOffset = 0.0f;
   float m_MouseYOffset = 0.0f;
   bool  m_MouseInitialMovement = true;
+  bool  m_CursorCaptured = false;
 
   // SCROLL INPUT
   float m_ScrollXOffset = 0.0f;
@@ -0,0 +1,262 @@
+#include "JobSystem.h"
+
+#include <string>
+#include <iostream>
+
+#include "Logging/Logger.h"
+#include "Profiling/Profiler.h"
+
+namespace {
+  constexpr unsigned int notAWorker   = ~0u;
+  constexpr std::size_t  jobRingSize  = WorkStealingQueue::capacity;
+
+  thread_local unsigned int t_WorkerIndex = notAWorker;
+  thread_local Job* t_JobRing = nullptr;
+  thread_local std::size_t t_JobRingIndex = 0;
+  thread_local std::uint32_t t_StealSeed = 0;
+
+  std::uint32_t NextRandom()
+  {
+    // xorshift, only spreads steal attempts over victims
+    std::uint32_t x = t_StealSeed ? t_StealSeed : 2463534242u;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    t_StealSeed = x;
+    return x;
+  }
+}
+
+JobSystem::~JobSystem()
+{
+  Shutdown();
+}
+
+void JobSystem::Initialize(unsigned int workerThreads)
+{
+  if (!m_Queues.empty())
+  {
+    throw std::exception{ "[ERROR::JOBS] Job system already initialized" };
+  }
+
+  if (workerThreads == 0)
+  {
+    unsigned int hardwareThreads = std::thread::hardware_concurrency();
+    workerThreads = hardwareThreads > 1 ? hardwareThreads - 1 : 1;
+  }
+
+  m_Quit.store(false);
+  for (unsigned int i = 0; i <= workerThreads; ++i)
+  {
+    m_Queues.push_back(std::make_unique<WorkStealingQueue>());
+  }
+
+  t_WorkerIndex = 0;
+  t_StealSeed   = 1;
+  for (unsigned int i = 1; i <= workerThreads; ++i)
+  {
+    m_Threads.emplace_back(&JobSystem::WorkerLoop, this, i);
+  }
+
+  Logger::Instance(std::cout).Log() << "[INFO::JOBS] Job system started with " << workerThreads << " worker threads";
+}
+
+void JobSystem::Shutdown()
+{
+  if (m_Queues.empty())
+  {
+    return;
+  }
+
+  // drain whatever is still queued before the workers leave
+  while (m_Pending.load() > 0)
+  {
+    if (!RunOne())
+    {
+      std::this_thread::yield();
+    }
+  }
+
+  { std::lock_guard<std::mutex> lock{ m_SleepMutex };
+    m_Quit.store(true);
+  }
+  m_SleepCondition.notify_all();
+
+  for (std::thread& thread : m_Threads)
+  {
+    thread.join();
+  }
+  m_Threads.clear();
+  m_Queues.clear();
+  t_WorkerIndex = notAWorker;
+}
+
+unsigned int JobSystem::GetWorkerCount() const
+{
+  return m_Queues.empty() ? 1 : static_cast<unsigned int>(m_Queues.size());
+}
+
+void JobSystem::Wait(const JobCounter& counter)
+{
+  while (!counter.IsDone())
+  {
+    if (!RunOne())
+    {
+      std::this_thread::yield();
+    }
+  }
+}
+
+Job* JobSystem::AllocateJob()
+{
+  // per thread ring, with more than jobRingSize jobs of this thread in flight the oldest slot is still
+  // queued or waiting as a continuation, run other jobs until it is done instead of overwriting it
+  if (!t_JobRing)
+  {
+    // rings outlive their threads, a thread may exit while its jobs are still queued
+    std::lock_guard<std::mutex> lock{ m_RingMutex };
+    m_JobRings.push_back(std::make_unique<Job[]>(jobRingSize));
+    t_JobRing = m_JobRings.back().get();
+  }
+
+  Job* job = &t_JobRing[t_JobRingIndex++ & (jobRingSize - 1)];
+  while (job->live.load(std::memory_order_acquire))
+  {
+    if (!RunOne())
+    {
+      std::this_thread::yield();
+    }
+  }
+
+  job->function = nullptr;
+  job->counter  = nullptr;
+  job->live.store(true, std::memory_order_relaxed);
+  return job;
+}
+
+void JobSystem::Submit(Job* job)
+{
+  if (m_Queues.empty())
+  {
+    Execute(job);
+    return;
+  }
+
+  m_Pending.fetch_add(1);
+
+  bool queued = t_WorkerIndex != notAWorker && m_Queues[t_WorkerIndex]->Push(job);
+  if (!queued)
+  {
+    std::lock_guard<std::mutex> lock{ m_SharedMutex };
+    m_SharedQueue.push_back(job);
+  }
+
+  if (m_Sleeping.load() > 0)
+  {
+    { std::lock_guard<std::mutex> lock{ m_SleepMutex }; }
+    m_SleepCondition.notify_one();
+  }
+}
+
+bool JobSystem::RunOne()
+{
+  if (m_Queues.empty())
+  {
+    return false;
+  }
+
+  Job* job = nullptr;
+  if (t_WorkerIndex != notAWorker)
+  {
+    job = m_Queues[t_WorkerIndex]->Pop();
+  }
+
+  if (!job)
+  {
+    std::lock_guard<std::mutex> lock{ m_SharedMutex };
+    if (!m_SharedQueue.empty())
+    {
+      job = m_SharedQueue.front();
+      m_SharedQueue.pop_front();
+    }
+  }
+
+  if (!job)
+  {
+    const std::size_t queueCount = m_Queues.size();
+    const std::size_t start = NextRandom() % queueCount;
+    for (std::size_t i = 0; i < queueCount && !job; ++i)
+    {
+      std::size_t victim = (start + i) % queueCount;
+      if (victim != t_WorkerIndex)
+      {
+        job = m_Queues[victim]->Steal();
+      }
+    }
+  }
+
+  if (!job)
+  {
+    return false;
+  }
+
+  m_Pending.fetch_sub(1);
+  Execute(job);
+  return true;
+}
+
+void JobSystem::Execute(Job* job)
+{
+  job->function(job->data);
+
+  JobCounter* counter = job->counter;
+  job->live.store(false, std::memory_order_release);
+  if (!counter)
+  {
+    return;
+  }
+
+  counter->m_Finishing.fetch_add(1);
+  std::vector<Job*> ready{};
+  if (counter->m_Value.fetch_sub(1) == 1)
+  {
+    std::lock_guard<std::mutex> lock{ counter->m_Mutex };
+    ready.swap(counter->m_Continuations);
+  }
+  // last access, waiters may destroy the counter from here on
+  counter->m_Finishing.fetch_sub(1);
+
+  for (Job* continuation : ready)
+  {
+    Submit(continuation);
+  }
+}
+
+void JobSystem::WorkerLoop(unsigned int index)
+{
+  t_WorkerIndex = index;
+  t_StealSeed   = index + 1;
+  PROFILE_THREAD(("Worker " + std::to_string(index)).c_str());
+
+  int spins = 0;
+  while (!m_Quit.load(std::memory_order_relaxed))
+  {
+    if (RunOne())
+    {
+      spins = 0;
+      continue;
+    }
+
+    if (++spins < JobSystem::spinsBeforeSleep)
+    {
+      std::this_thread::yield();
+      continue;
+    }
+
+    std::unique_lock<std::mutex> lock{ m_SleepMutex };
+    m_Sleeping.fetch_add(1);
+    m_SleepCondition.wait(lock, [this]() { return m_Pending.load() > 0 || m_Quit.load(); });
+    m_Sleeping.fetch_sub(1);
+    spins = 0;
+  }
+}
@@ -0,0 +1,164 @@
+#pragma once
+
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <vector>
+#include <deque>
+#include <memory>
+#include <new>
+#include <algorithm>
+#include <type_traits>
+#include <cstddef>
+
+#include "Jobs/WorkStealingQueue.h"
+
+class JobCounter;
+
+// a job is a small trivially copyable callable stored inline, capture by reference or pointer
+struct Job {
+  static constexpr std::size_t dataSize = 48;
+
+  void (*function)(const void* data) = nullptr;
+  JobCounter* counter = nullptr;
+  std::atomic<bool> live{ false };      // set from allocation until Execute is done with the job
+  alignas(16) unsigned char data[Job::dataSize]{};
+};
+
+// counts unfinished jobs, waiting on it and jobs scheduled after it run once it drops to zero
+class JobCounter {
+public:
+  JobCounter() = default;
+  JobCounter(const JobCounter&) = delete;
+  JobCounter& operator=(const JobCounter&) = delete;
+
+  // also waits for the last decrement to let go of the counter, so it can be destroyed right after
+  inline bool IsDone() const
+  {
+    return m_Value.load(std::memory_order_acquire) == 0 && m_Finishing.load(std::memory_order_acquire) == 0;
+  }
+
+private:
+  friend class JobSystem;
+
+  std::atomic<int> m_Value{ 0 };
+  std::atomic<int> m_Finishing{ 0 };
+  std::mutex m_Mutex{};
+  std::vector<Job*> m_Continuations{};
+};
+
+// work-stealing scheduler, one Chase-Lev deque per worker, the thread calling Initialize is worker 0
+// and only runs jobs while it waits, threads that are not workers submit through a shared queue
+class JobSystem {
+public:
+  static JobSystem& Instance()
+  {
+    static JobSystem instance{};
+    return instance;
+  }
+
+  JobSystem(const JobSystem&) = delete;
+  JobSystem& operator=(const JobSystem&) = delete;
+
+  // background workers besides the calling thread, 0 picks hardware concurrency - 1
+  void Initialize(unsigned int workerThreads = 0);
+  void Shutdown();
+
+  // workers including the main thread, 1 when not initialized (jobs then run inline)
+  unsigned int GetWorkerCount() const;
+
+  template <typename Function>
+  void Run(const Function& function, JobCounter* counter = nullptr)
+  {
+    Submit(CreateJob(function, counter));
+  }
+
+  // function runs once dependency reaches zero
+  template <typename Function>
+  void RunAfter(JobCounter& dependency, const Function& function, JobCounter* counter = nullptr)
+  {
+    Job* job = CreateJob(function, counter);
+    { std::lock_guard<std::mutex> lock{ dependency.m_Mutex };
+      if (dependency.m_Value.load(std::memory_order_acquire) != 0)
+      {
+        dependency.m_Continuations.push_back(job);
+        return;
+      }
+    }
+    Submit(job);
+  }
+
+  // runs other jobs until counter reaches zero
+  void Wait(const JobCounter& counter);
+
+  // function(begin, end) over [0, count) in chunks of at least grainSize, returns when all chunks are done
+  template <typename Function>
+  void ParallelFor(std::size_t count, std::size_t grainSize, const Function& function)
+  {
+    const std::size_t workers = GetWorkerCount();
+    const std::size_t chunkSize = std::max<std::size_t>({ grainSize, 1, (count + workers * JobSystem::chunksPerWorker - 1) / (workers * JobSystem::chunksPerWorker) });
+    if (workers <= 1 || count <= chunkSize)
+    {
+      if (count)
+      {
+        function(std::size_t{ 0 }, count);
+      }
+      return;
+    }
+
+    JobCounter counter{};
+    for (std::size_t begin = 0; begin < count; begin += chunkSize)
+    {
+      std::size_t end = std::min(begin + chunkSize, count);
+      Run([&function, begin, end]() { function(begin, end); }, &counter);
+    }
+    Wait(counter);
+  }
+
+private:
+  JobSystem() = default;
+  ~JobSystem();
+
+  template <typename Function>
+  Job* CreateJob(const Function& function, JobCounter* counter)
+  {
+    static_assert(sizeof(Function) <= Job::dataSize, "job callable too large, capture by reference");
+    static_assert(std::is_trivially_copyable<Function>::value, "job callable must be trivially copyable");
+
+    Job* job = AllocateJob();
+    job->function = [](const void* data) { (*static_cast<const Function*>(data))(); };
+    job->counter  = counter;
+    new (job->data) Function{ function };
+
+    if (counter)
+    {
+      counter->m_Value.fetch_add(1, std::memory_order_relaxed);
+    }
+    return job;
+  }
+
+  Job* AllocateJob();
+  void Submit(Job* job);
+  bool RunOne();
+  void Execute(Job* job);
+  void WorkerLoop(unsigned int index);
+
+  static constexpr std::size_t chunksPerWorker  = 4;
+  static constexpr int         spinsBeforeSleep = 64;
+
+  std::vector<std::unique_ptr<WorkStealingQueue>> m_Queues{};
+  std::vector<std::thread> m_Threads{};
+
+  std::mutex m_SharedMutex{};
+  std::deque<Job*> m_SharedQueue{};
+
+  std::mutex m_RingMutex{};
+  std::vector<std::unique_ptr<Job[]>> m_JobRings{};
+
+  std::atomic<int> m_Pending{ 0 };
+  std::atomic<int> m_Sleeping{ 0 };
+  std::atomic<bool> m_Quit{ false };
+  std::mutex m_SleepMutex{};
+  std::condition_variable m_SleepCondition{};
+};
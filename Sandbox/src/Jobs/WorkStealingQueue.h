@@ -0,0 +1,83 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+struct Job;
+
+// Chase-Lev deque (Le et al. 2013 memory orders), the owning worker pushes and pops at the bottom,
+// every other worker steals from the top, capacity is fixed
+class WorkStealingQueue {
+public:
+  static constexpr std::int64_t capacity = 4096;
+
+  // owner only, false when full
+  bool Push(Job* job)
+  {
+    std::int64_t bottom = m_Bottom.load(std::memory_order_relaxed);
+    std::int64_t top    = m_Top.load(std::memory_order_acquire);
+    if (bottom - top >= WorkStealingQueue::capacity)
+    {
+      return false;
+    }
+
+    m_Jobs[bottom & WorkStealingQueue::mask].store(job, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    m_Bottom.store(bottom + 1, std::memory_order_relaxed);
+    return true;
+  }
+
+  // owner only, newest first
+  Job* Pop()
+  {
+    std::int64_t bottom = m_Bottom.load(std::memory_order_relaxed) - 1;
+    m_Bottom.store(bottom, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    std::int64_t top = m_Top.load(std::memory_order_relaxed);
+
+    if (top > bottom)
+    {
+      m_Bottom.store(bottom + 1, std::memory_order_relaxed);
+      return nullptr;
+    }
+
+    Job* job = m_Jobs[bottom & WorkStealingQueue::mask].load(std::memory_order_relaxed);
+    if (top == bottom)
+    {
+      // last job, race the thieves for it
+      if (!m_Top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+      {
+        job = nullptr;
+      }
+      m_Bottom.store(bottom + 1, std::memory_order_relaxed);
+    }
+    return job;
+  }
+
+  // any thread, oldest first
+  Job* Steal()
+  {
+    std::int64_t top = m_Top.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    std::int64_t bottom = m_Bottom.load(std::memory_order_acquire);
+    if (top >= bottom)
+    {
+      return nullptr;
+    }
+
+    Job* job = m_Jobs[top & WorkStealingQueue::mask].load(std::memory_order_relaxed);
+    if (!m_Top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+    {
+      return nullptr;
+    }
+    return job;
+  }
+
+private:
+  static constexpr std::int64_t mask = WorkStealingQueue::capacity - 1;
+
+  alignas(64) std::atomic<std::int64_t> m_Top{ 0 };
+  alignas(64) std::atomic<std::int64_t> m_Bottom{ 0 };
+  alignas(64) std::atomic<Job*> m_Jobs[WorkStealingQueue::capacity]{};
+};
@@ -0,0 +1,109 @@
+#include "BenchmarkRun.h"
+
+#include <cstdio>
+#include <sstream>
+#include <algorithm>
+
+#include "Utility/SystemInfo/SystemInfo.h"
+
+BenchmarkRun::BenchmarkRun(std::string scene, std::uint64_t warmupFrames, std::uint64_t measuredFrames) :
+  m_Scene         { std::move(scene)                                                     },
+  m_WarmupFrames  { std::max<std::uint64_t>(warmupFrames, 1)                             },
+  m_MeasuredFrames{ std::max<std::uint64_t>(measuredFrames, 1)                           },
+  m_FrameStats    { static_cast<std::size_t>(std::max<std::uint64_t>(measuredFrames, 1)) }
+{
+}
+
+void BenchmarkRun::SetParameter(const char* name, double value)
+{
+  m_Parameters.push_back(Parameter{ name, value });
+}
+
+void BenchmarkRun::EndFrame()
+{
+  if (IsDone())
+  {
+    return;
+  }
+
+  // the end of the last warmup frame starts the clock of the first measured one
+  if (m_Frame + 1 == m_WarmupFrames)
+  {
+    m_FrameStats.Tick();
+    m_WarmupPeakResidentSetSize = PeakResidentSetSize();
+  }
+  else if (IsMeasuring())
+  {
+    m_FrameStats.Tick();
+
+    const Counters::Values& frame = Counters::Instance().GetFrame();
+    for (std::size_t i = 0; i < Counters::counterCount; ++i)
+    {
+      m_Counters[i] += frame[i];
+    }
+  }
+
+  ++m_Frame;
+}
+
+void BenchmarkRun::WriteJson(const char* path) const
+{
+  std::FILE* file = std::fopen(path, "wb");
+  if (!file)
+  {
+    std::ostringstream outStream{};
+    outStream << "[ERROR::BENCHMARK] Could not open benchmark report : " << path;
+    throw std::exception{ outStream.str().c_str() };
+  }
+
+  const FrameStats::Summary summary = m_FrameStats.GetSummary();
+  const double measured = static_cast<double>(m_MeasuredFrames);
+
+  std::fprintf(file, "{\n");
+  std::fprintf(file, "  \"scene\": \"%s\",\n", m_Scene.c_str());
+  std::fprintf(file, "  \"warmupFrames\": %llu,\n", static_cast<unsigned long long>(m_WarmupFrames));
+  std::fprintf(file, "  \"measuredFrames\": %llu,\n", static_cast<unsigned long long>(summary.frames));
+
+  std::fprintf(file, "  \"parameters\": {");
+  for (std::size_t i = 0; i < m_Parameters.size(); ++i)
+  {
+    std::fprintf(file, "%s\n    \"%s\": %.9g", i ? "," : "", m_Parameters[i].name, m_Parameters[i].value);
+  }
+  std::fprintf(file, "%s},\n", m_Parameters.empty() ? "" : "\n  ");
+
+  std::fprintf(file, "  \"frameTime\": {\n");
+  std::fprintf(file, "    \"averageMilliseconds\": %.6f,\n", summary.averageMilliseconds);
+  std::fprintf(file, "    \"p50Milliseconds\": %.6f,\n", summary.p50Milliseconds);
+  std::fprintf(file, "    \"p95Milliseconds\": %.6f,\n", summary.p95Milliseconds);
+  std::fprintf(file, "    \"p99Milliseconds\": %.6f,\n", summary.p99Milliseconds);
+  std::fprintf(file, "    \"maxMilliseconds\": %.6f,\n", summary.maxMilliseconds);
+  std::fprintf(file, "    \"fps\": %.3f,\n", summary.fps);
+  std::fprintf(file, "    \"hitches\": %zu,\n", summary.hitches);
+  std::fprintf(file, "    \"histogramEdgesMilliseconds\": [");
+  for (std::size_t i = 0; i < FrameStats::histogramEdges.size(); ++i)
+  {
+    std::fprintf(file, "%s%.1f", i ? ", " : "", FrameStats::histogramEdges[i]);
+  }
+  std::fprintf(file, "],\n    \"histogram\": [");
+  for (std::size_t i = 0; i < FrameStats::histogramBins; ++i)
+  {
+    std::fprintf(file, "%s%u", i ? ", " : "", summary.histogram[i]);
+  }
+  std::fprintf(file, "]\n  },\n");
+
+  std::fprintf(file, "  \"counters\": {");
+  for (std::size_t i = 0; i < Counters::counterCount; ++i)
+  {
+    std::fprintf(file, "%s\n    \"%s\": { \"total\": %llu, \"perFrame\": %.3f }", i ? "," : "",
+                 Counters::GetName(static_cast<Counter>(i)),
+                 static_cast<unsigned long long>(m_Counters[i]),
+                 static_cast<double>(m_Counters[i]) / measured);
+  }
+  std::fprintf(file, "\n  },\n");
+
+  std::fprintf(file, "  \"memory\": {\n");
+  std::fprintf(file, "    \"warmupPeakResidentSetSizeKiB\": %zu,\n", m_WarmupPeakResidentSetSize / 1024);
+  std::fprintf(file, "    \"peakResidentSetSizeKiB\": %zu\n", PeakResidentSetSize() / 1024);
+  std::fprintf(file, "  }\n}\n");
+  std::fclose(file);
+}
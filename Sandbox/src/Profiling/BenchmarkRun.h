@@ -0,0 +1,61 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+#include "Profiling/Counters.h"
+#include "Profiling/FrameStats.h"
+
+// one scripted run of a scene, the first warmupFrames frames are ignored (at least one, its end starts the clock),
+// the following measuredFrames frames are timed and their counters summed, WriteJson reports frame time percentiles,
+// counters and peak memory so runs of different builds can be compared
+class BenchmarkRun {
+public:
+  BenchmarkRun(std::string scene, std::uint64_t warmupFrames, std::uint64_t measuredFrames);
+
+  // describes the run in the report, cube and light counts, the timestep, ...
+  void SetParameter(const char* name, double value);
+
+  // once per frame after Counters::EndFrame
+  void EndFrame();
+
+  inline bool IsMeasuring() const
+  {
+    return m_Frame >= m_WarmupFrames && m_Frame < GetTotalFrames();
+  }
+
+  inline bool IsDone() const
+  {
+    return m_Frame >= GetTotalFrames();
+  }
+
+  inline std::uint64_t GetTotalFrames() const
+  {
+    return m_WarmupFrames + m_MeasuredFrames;
+  }
+
+  inline FrameStats::Summary GetSummary() const
+  {
+    return m_FrameStats.GetSummary();
+  }
+
+  void WriteJson(const char* path) const;
+
+private:
+  struct Parameter {
+    const char* name = nullptr;
+    double value     = 0.0;
+  };
+
+  std::string m_Scene;
+  std::uint64_t m_WarmupFrames   = 0;
+  std::uint64_t m_MeasuredFrames = 0;
+  std::uint64_t m_Frame          = 0;
+  std::vector<Parameter> m_Parameters{};
+
+  FrameStats m_FrameStats;
+  Counters::Values m_Counters{};
+  std::size_t m_WarmupPeakResidentSetSize = 0;
+};
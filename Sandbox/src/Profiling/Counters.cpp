@@ -0,0 +1,101 @@
+#include "Counters.h"
+
+#include <cstdio>
+#include <sstream>
+
+thread_local Counters::ThreadBlock* Counters::t_Block = nullptr;
+
+const char* Counters::GetName(Counter counter)
+{
+  switch (counter)
+  {
+  case Counter::DRAW_CALLS:      return "draw_calls";
+  case Counter::INSTANCES:       return "instances";
+  case Counter::TRIANGLES:       return "triangles";
+  case Counter::STATE_CHANGES:   return "state_changes";
+  case Counter::UNIFORM_UPLOADS: return "uniform_uploads";
+  case Counter::BUFFER_UPLOADS:  return "buffer_uploads";
+  case Counter::BUFFER_BYTES:    return "buffer_bytes";
+  case Counter::TEXTURE_UPLOADS: return "texture_uploads";
+  case Counter::TEXTURE_BYTES:   return "texture_bytes";
+  default:                       return "unknown";
+  }
+}
+
+void Counters::EndFrame()
+{
+  m_Frame.fill(0);
+
+  { std::lock_guard<std::mutex> lock{ m_Mutex };
+    for (std::unique_ptr<ThreadBlock>& block : m_Blocks)
+    {
+      for (std::size_t i = 0; i < Counters::counterCount; ++i)
+      {
+        // running totals, the difference to the previous read is what was added in between
+        std::uint64_t value = block->values[i].load(std::memory_order_relaxed);
+        m_Frame[i] += value - block->collected[i];
+        block->collected[i] = value;
+      }
+    }
+  }
+
+  for (std::size_t i = 0; i < Counters::counterCount; ++i)
+  {
+    m_Totals[i] += m_Frame[i];
+  }
+  ++m_FrameCount;
+
+  if (m_Recording && m_Recorded.size() < Counters::maxRecordedFrames)
+  {
+    m_Recorded.push_back(m_Frame);
+  }
+}
+
+void Counters::BeginRecording()
+{
+  m_Recorded.clear();
+  m_RecordingStart = m_FrameCount;
+  m_Recording = true;
+}
+
+void Counters::EndRecording()
+{
+  m_Recording = false;
+}
+
+void Counters::WriteCsv(const char* path) const
+{
+  std::FILE* file = std::fopen(path, "wb");
+  if (!file)
+  {
+    std::ostringstream outStream{};
+    outStream << "[ERROR::COUNTERS] Could not open counters file : " << path;
+    throw std::exception{ outStream.str().c_str() };
+  }
+
+  std::fputs("frame", file);
+  for (std::size_t i = 0; i < Counters::counterCount; ++i)
+  {
+    std::fprintf(file, ",%s", Counters::GetName(static_cast<Counter>(i)));
+  }
+  std::fputc('\n', file);
+
+  for (std::size_t frame = 0; frame < m_Recorded.size(); ++frame)
+  {
+    std::fprintf(file, "%llu", static_cast<unsigned long long>(m_RecordingStart + frame));
+    for (std::uint64_t value : m_Recorded[frame])
+    {
+      std::fprintf(file, ",%llu", static_cast<unsigned long long>(value));
+    }
+    std::fputc('\n', file);
+  }
+  std::fclose(file);
+}
+
+Counters::ThreadBlock& Counters::RegisterThread()
+{
+  std::lock_guard<std::mutex> lock{ m_Mutex };
+  m_Blocks.push_back(std::make_unique<ThreadBlock>());
+  t_Block = m_Blocks.back().get();
+  return *t_Block;
+}
@@ -0,0 +1,123 @@
+#pragma once
+
+#include <array>
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+enum class Counter
+  : std::int32_t
+{
+  DRAW_CALLS,        // API calls, a multi draw counts once
+  INSTANCES,
+  TRIANGLES,
+  STATE_CHANGES,     // binds issued through GLStateCache
+  UNIFORM_UPLOADS,
+  BUFFER_UPLOADS,
+  BUFFER_BYTES,
+  TEXTURE_UPLOADS,
+  TEXTURE_BYTES,
+  COUNT
+};
+
+// renderer counters, fed by the GL wrappers on whichever thread issues the call, every thread adds into its own
+// block of atomics without contention, EndFrame on the render thread collects what was added since the previous
+// frame, so uploads of the loader thread land in the frame during which they finished
+class Counters {
+public:
+  static constexpr std::size_t counterCount = static_cast<std::size_t>(Counter::COUNT);
+  using Values = std::array<std::uint64_t, Counters::counterCount>;
+
+  static Counters& Instance()
+  {
+    static Counters instance{};
+    return instance;
+  }
+
+  Counters(const Counters&) = delete;
+  Counters& operator=(const Counters&) = delete;
+
+  static const char* GetName(Counter counter);
+
+  inline void Add(Counter counter, std::uint64_t value = 1)
+  {
+    // only the owning thread writes its block, a plain load and store is enough
+    std::atomic<std::uint64_t>& slot = GetThreadBlock().values[static_cast<std::size_t>(counter)];
+    slot.store(slot.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+  }
+
+  void EndFrame();
+
+  // values of the last frame collected by EndFrame
+  inline std::uint64_t Get(Counter counter) const
+  {
+    return m_Frame[static_cast<std::size_t>(counter)];
+  }
+
+  inline const Values& GetFrame() const
+  {
+    return m_Frame;
+  }
+
+  // since the start of the program
+  inline std::uint64_t GetTotal(Counter counter) const
+  {
+    return m_Totals[static_cast<std::size_t>(counter)];
+  }
+
+  inline std::uint64_t GetFrameCount() const
+  {
+    return m_FrameCount;
+  }
+
+  // frames collected between BeginRecording and EndRecording are kept for WriteCsv
+  void BeginRecording();
+  void EndRecording();
+
+  inline bool IsRecording() const
+  {
+    return m_Recording;
+  }
+
+  inline std::size_t GetRecordedFrames() const
+  {
+    return m_Recorded.size();
+  }
+
+  // one row per recorded frame, one column per counter
+  void WriteCsv(const char* path) const;
+
+private:
+  struct ThreadBlock {
+    std::array<std::atomic<std::uint64_t>, Counters::counterCount> values{};
+    Values collected{};
+  };
+
+  Counters() = default;
+
+  inline ThreadBlock& GetThreadBlock()
+  {
+    return t_Block ? *t_Block : RegisterThread();
+  }
+
+  ThreadBlock& RegisterThread();
+
+  static thread_local ThreadBlock* t_Block;
+
+  static constexpr std::size_t maxRecordedFrames = 1024 * 1024;
+
+  // blocks outlive their threads, what an exiting thread added is still collected
+  std::mutex m_Mutex{};
+  std::vector<std::unique_ptr<ThreadBlock>> m_Blocks{};
+
+  Values m_Frame{};
+  Values m_Totals{};
+  std::uint64_t m_FrameCount = 0;
+
+  bool m_Recording = false;
+  std::uint64_t m_RecordingStart = 0;
+  std::vector<Values> m_Recorded{};
+};
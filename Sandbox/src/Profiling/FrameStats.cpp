@@ -0,0 +1,100 @@
+#include "FrameStats.h"
+
+#include <cmath>
+#include <algorithm>
+
+FrameStats::FrameStats(std::size_t capacity) :
+  m_Frames ( std::max<std::size_t>(capacity, 1) ),
+  m_Scratch( std::max<std::size_t>(capacity, 1) )
+{
+}
+
+void FrameStats::Tick()
+{
+  auto now = std::chrono::steady_clock::now();
+  if (m_Started)
+  {
+    AddFrame(std::chrono::duration<double, std::milli>(now - m_LastTick).count());
+  }
+  m_Started  = true;
+  m_LastTick = now;
+}
+
+void FrameStats::AddFrame(double milliseconds)
+{
+  m_Frames[m_Next] = milliseconds;
+  m_Next = (m_Next + 1) % m_Frames.size();
+
+  if (m_RecentMilliseconds > 0.0 &&
+      milliseconds > m_RecentMilliseconds * FrameStats::hitchFactor &&
+      milliseconds > FrameStats::hitchMinimumMilliseconds)
+  {
+    ++m_Hitches;
+  }
+  // a hitch still moves the average, a long stall should not hide the ones right after it
+  m_RecentMilliseconds = m_RecentMilliseconds > 0.0
+                       ? m_RecentMilliseconds + (milliseconds - m_RecentMilliseconds) * FrameStats::averageWeight
+                       : milliseconds;
+
+  std::size_t bin = std::upper_bound(std::begin(FrameStats::histogramEdges), std::end(FrameStats::histogramEdges), milliseconds) -
+                    std::begin(FrameStats::histogramEdges);
+  ++m_Histogram[bin];
+
+  ++m_Count;
+  m_TotalMilliseconds += milliseconds;
+  m_MaxMilliseconds    = std::max(m_MaxMilliseconds, milliseconds);
+  m_LastMilliseconds   = milliseconds;
+}
+
+FrameStats::Summary FrameStats::GetSummary() const
+{
+  Summary summary{};
+  summary.frames          = m_Count;
+  summary.hitches         = m_Hitches;
+  summary.maxMilliseconds = m_MaxMilliseconds;
+  summary.histogram       = m_Histogram;
+  if (!m_Count)
+  {
+    return summary;
+  }
+
+  summary.averageMilliseconds = m_TotalMilliseconds / static_cast<double>(m_Count);
+  summary.fps = m_TotalMilliseconds > 0.0 ? 1000.0 * static_cast<double>(m_Count) / m_TotalMilliseconds : 0.0;
+
+  // the newest frames are the ones before m_Next, wrapping around
+  const std::size_t count = std::min(m_Count, m_Frames.size());
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    m_Scratch[i] = m_Frames[(m_Next + m_Frames.size() - count + i) % m_Frames.size()];
+  }
+
+  summary.p50Milliseconds = FrameStats::Percentile(m_Scratch.data(), count, 0.50);
+  summary.p95Milliseconds = FrameStats::Percentile(m_Scratch.data(), count, 0.95);
+  summary.p99Milliseconds = FrameStats::Percentile(m_Scratch.data(), count, 0.99);
+  return summary;
+}
+
+void FrameStats::Reset()
+{
+  // the recent average and the clock carry over, the next interval starts with the next frame
+  m_Next    = 0;
+  m_Count   = 0;
+  m_Hitches = 0;
+  m_TotalMilliseconds = 0.0;
+  m_MaxMilliseconds   = 0.0;
+  m_Histogram.fill(0);
+}
+
+double FrameStats::Percentile(double* values, std::size_t count, double percentile)
+{
+  if (!count)
+  {
+    return 0.0;
+  }
+
+  // nearest rank, reorders values
+  std::size_t rank = static_cast<std::size_t>(std::ceil(percentile * static_cast<double>(count)));
+  std::size_t index = std::min(count - 1, rank > 0 ? rank - 1 : 0);
+  std::nth_element(values, values + index, values + count);
+  return values[index];
+}
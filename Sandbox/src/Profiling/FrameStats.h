@@ -0,0 +1,70 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+// frame time distribution of the frames since the last Reset, every frame time goes into a fixed ring so stutter
+// shows up in the percentiles instead of vanishing in an average, nothing is allocated after construction,
+// a hitch is a frame taking hitchFactor times the recent average and at least hitchMinimumMilliseconds
+class FrameStats {
+public:
+  static constexpr std::size_t histogramBins = 10;
+  // upper bounds of all bins but the last, milliseconds
+  static constexpr std::array<double, FrameStats::histogramBins - 1> histogramEdges{
+    4.0, 8.0, 12.0, 16.7, 20.0, 25.0, 33.3, 50.0, 100.0
+  };
+
+  struct Summary {
+    std::size_t frames  = 0;
+    std::size_t hitches = 0;
+    double fps                 = 0.0;
+    double averageMilliseconds = 0.0;
+    double p50Milliseconds     = 0.0;
+    double p95Milliseconds     = 0.0;
+    double p99Milliseconds     = 0.0;
+    double maxMilliseconds     = 0.0;
+    std::array<std::uint32_t, FrameStats::histogramBins> histogram{};
+  };
+
+  explicit FrameStats(std::size_t capacity = FrameStats::defaultCapacity);
+
+  // once per frame at the same point of the loop, the first call only starts the clock
+  void Tick();
+  void AddFrame(double milliseconds);
+
+  // percentiles over the last capacity frames, everything else over all frames since Reset
+  Summary GetSummary() const;
+  void Reset();
+
+  inline double GetLastMilliseconds() const
+  {
+    return m_LastMilliseconds;
+  }
+
+  static double Percentile(double* values, std::size_t count, double percentile);
+
+private:
+  static constexpr std::size_t defaultCapacity = 4096;
+  static constexpr double hitchFactor              = 2.0;
+  static constexpr double hitchMinimumMilliseconds = 8.0;
+  // weight of the newest frame in the recent average hitches are measured against
+  static constexpr double averageWeight = 0.1;
+
+  std::vector<double> m_Frames{};
+  mutable std::vector<double> m_Scratch{};
+  std::size_t m_Next = 0;
+
+  bool m_Started = false;
+  std::chrono::steady_clock::time_point m_LastTick{};
+  double m_LastMilliseconds   = 0.0;
+  double m_RecentMilliseconds = 0.0;
+
+  std::size_t m_Count   = 0;
+  std::size_t m_Hitches = 0;
+  double m_TotalMilliseconds = 0.0;
+  double m_MaxMilliseconds   = 0.0;
+  std::array<std::uint32_t, FrameStats::histogramBins> m_Histogram{};
+};
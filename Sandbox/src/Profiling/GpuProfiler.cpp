@@ -0,0 +1,199 @@
+#include "GpuProfiler.h"
+
+#include <algorithm>
+
+#include <GL/glew.h>
+
+#include "Core/Core.h"
+
+void GpuProfiler::Initialize()
+{
+  if (!m_Queries.empty())
+  {
+    throw std::exception{ "[ERROR::PROFILER] GPU profiler already initialized" };
+  }
+
+  m_Queries.resize(GpuProfiler::frameLatency * GpuProfiler::maxQueriesPerFrame);
+  CALL(glGenQueries(static_cast<int>(m_Queries.size()), m_Queries.data()));
+
+  for (Frame& frame : m_Frames)
+  {
+    frame = Frame{};
+    frame.scopes.reserve(GpuProfiler::maxQueriesPerFrame / 2);
+  }
+  m_Frame     = 0;
+  m_Recording = true;
+  Calibrate();
+}
+
+void GpuProfiler::Dispose()
+{
+  if (m_Queries.empty())
+  {
+    return;
+  }
+
+  CALL(glDeleteQueries(static_cast<int>(m_Queries.size()), m_Queries.data()));
+  m_Queries.clear();
+  m_Recording = false;
+}
+
+std::uint32_t GpuProfiler::Begin(const char* name)
+{
+  Frame& frame = m_Frames[m_Frame];
+  if (!m_Recording || frame.queryCount + 2 > GpuProfiler::maxQueriesPerFrame)
+  {
+    return GpuProfiler::invalidScope;
+  }
+
+  if (frame.scopes.empty())
+  {
+    frame.cpuTicks       = m_CpuTicks;
+    frame.gpuNanoseconds = m_GpuNanoseconds;
+  }
+
+  // both queries are reserved up front so End always has its slot
+  const std::uint32_t base = static_cast<std::uint32_t>(m_Frame) * GpuProfiler::maxQueriesPerFrame;
+  Scope scope{ name, base + frame.queryCount, base + frame.queryCount + 1 };
+  frame.queryCount += 2;
+  frame.lastQuery   = scope.beginQuery;
+  CALL(glQueryCounter(m_Queries[scope.beginQuery], GL_TIMESTAMP));
+
+  frame.scopes.push_back(scope);
+  return static_cast<std::uint32_t>(frame.scopes.size() - 1);
+}
+
+void GpuProfiler::End(std::uint32_t scope)
+{
+  if (scope == GpuProfiler::invalidScope || !m_Recording)
+  {
+    return;
+  }
+
+  Frame& frame = m_Frames[m_Frame];
+  frame.lastQuery = frame.scopes[scope].endQuery;
+  CALL(glQueryCounter(m_Queries[frame.lastQuery], GL_TIMESTAMP));
+}
+
+void GpuProfiler::EndFrame()
+{
+  if (m_Queries.empty())
+  {
+    return;
+  }
+
+  // a skipped frame keeps waiting on the same slot, so m_Frame is always the oldest one in flight
+  if (m_Recording)
+  {
+    m_Frames[m_Frame].pending = !m_Frames[m_Frame].scopes.empty();
+    m_Frame = (m_Frame + 1) % GpuProfiler::frameLatency;
+  }
+
+  // oldest first, a frame still in flight means every later one is too
+  for (std::size_t i = 0; i < GpuProfiler::frameLatency; ++i)
+  {
+    Frame& frame = m_Frames[(m_Frame + i) % GpuProfiler::frameLatency];
+    if (frame.pending && !Resolve(frame))
+    {
+      break;
+    }
+  }
+
+  Frame& next = m_Frames[m_Frame];
+  m_Recording = !next.pending;
+  if (!m_Recording)
+  {
+    ++m_Skipped;
+    return;
+  }
+
+  next.scopes.clear();
+  next.queryCount = 0;
+
+  // the clocks drift apart slowly, recalibrating now and then is enough
+  Profiler& profiler = Profiler::Instance();
+  if (Profiler::Now() - m_CpuTicks > static_cast<std::uint64_t>(profiler.TicksPerSecond() * GpuProfiler::calibrationSeconds))
+  {
+    Calibrate();
+  }
+}
+
+void GpuProfiler::Calibrate()
+{
+  GLint64 gpuNanoseconds = 0;
+  m_CpuTicks = Profiler::Now();
+  CALL(glGetInteger64v(GL_TIMESTAMP, &gpuNanoseconds));
+  m_GpuNanoseconds = static_cast<std::uint64_t>(gpuNanoseconds);
+}
+
+bool GpuProfiler::Resolve(Frame& frame)
+{
+  GLuint available = GL_FALSE;
+  CALL(glGetQueryObjectuiv(m_Queries[frame.lastQuery], GL_QUERY_RESULT_AVAILABLE, &available));
+  if (!available)
+  {
+    return false;
+  }
+
+  for (Profiler::ScopeStatistics& scope : m_Scopes)
+  {
+    scope.calls           = 0;
+    scope.milliseconds    = 0.0;
+    scope.maxMilliseconds = 0.0;
+  }
+
+  Profiler& profiler = Profiler::Instance();
+  const double ticksPerNanosecond = profiler.TicksPerSecond() * 1.0e-9;
+  for (const Scope& scope : frame.scopes)
+  {
+    GLuint64 begin = 0;
+    GLuint64 end   = 0;
+    CALL(glGetQueryObjectui64v(m_Queries[scope.beginQuery], GL_QUERY_RESULT, &begin));
+    CALL(glGetQueryObjectui64v(m_Queries[scope.endQuery], GL_QUERY_RESULT, &end));
+    end = std::max(begin, end);
+
+    // GPU nanoseconds relative to the calibration point, onto the CPU profiler's ticks
+    double beginOffset = (static_cast<double>(begin) - static_cast<double>(frame.gpuNanoseconds)) * ticksPerNanosecond;
+    double endOffset   = (static_cast<double>(end) - static_cast<double>(frame.gpuNanoseconds)) * ticksPerNanosecond;
+    profiler.AddCapturedEvent(scope.name, "GPU",
+                              frame.cpuTicks + static_cast<std::int64_t>(beginOffset),
+                              frame.cpuTicks + static_cast<std::int64_t>(endOffset));
+
+    auto it = m_ScopeIndices.find(scope.name);
+    if (it == std::end(m_ScopeIndices))
+    {
+      it = m_ScopeIndices.emplace(scope.name, m_Scopes.size()).first;
+      m_Scopes.push_back(Profiler::ScopeStatistics{ scope.name });
+      m_FrameStatistics.reserve(m_Scopes.size());
+    }
+
+    Profiler::ScopeStatistics& statistics = m_Scopes[it->second];
+    double milliseconds = static_cast<double>(end - begin) * 1.0e-6;
+    ++statistics.calls;
+    statistics.milliseconds   += milliseconds;
+    statistics.maxMilliseconds = std::max(statistics.maxMilliseconds, milliseconds);
+  }
+
+  m_FrameStatistics.clear();
+  for (const Profiler::ScopeStatistics& scope : m_Scopes)
+  {
+    if (scope.calls)
+    {
+      m_FrameStatistics.push_back(scope);
+    }
+  }
+
+  std::sort(
+    std::begin(m_FrameStatistics),
+    std::end(m_FrameStatistics),
+    [](const Profiler::ScopeStatistics& lhs, const Profiler::ScopeStatistics& rhs) -> bool
+    {
+      return lhs.milliseconds > rhs.milliseconds;
+    }
+  );
+
+  frame.pending = false;
+  frame.scopes.clear();
+  frame.queryCount = 0;
+  return true;
+}
@@ -0,0 +1,116 @@
+#pragma once
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+
+#include "Profiling/Profiler.h"
+
+#if PROFILE
+// times the enclosed commands on the CPU and the GPU under the same name
+#define PROFILE_GPU_SCOPE(name) PROFILE_SCOPE(name); GpuProfileScope PROFILE_CONCAT(gpuProfileScope, __LINE__){ name }
+#else
+#define PROFILE_GPU_SCOPE(name)
+#endif
+
+// GPU side of the profiler, every scope writes a GL_TIMESTAMP query at its begin and end into a ring of per frame
+// query sets, a set is read back frameLatency frames later once its last query is available so the CPU never waits,
+// a frame whose set is still in flight is not timed at all, timestamps are mapped onto the CPU profiler's clock
+// with a GL_TIMESTAMP / Profiler::Now pair taken at Initialize and again every calibrationSeconds and land on the
+// "GPU" track of the capture, glGetInteger64v(GL_TIMESTAMP) is a round trip to the driver that returns the GPU
+// clock once earlier commands have reached the server, not once they finished, so it is no GPU sync point
+class GpuProfiler {
+public:
+  static GpuProfiler& Instance()
+  {
+    static GpuProfiler instance{};
+    return instance;
+  }
+
+  GpuProfiler(const GpuProfiler&) = delete;
+  GpuProfiler& operator=(const GpuProfiler&) = delete;
+
+  // on the render thread with its context current
+  void Initialize();
+  void Dispose();
+
+  static constexpr std::uint32_t invalidScope = ~0u;
+
+  // invalidScope when nothing is recorded this frame, End ignores it
+  std::uint32_t Begin(const char* name);
+  void End(std::uint32_t scope);
+
+  // after the frame's last scope, reads back every finished frame
+  void EndFrame();
+
+  // scopes of the latest frame read back, frameLatency frames old, sorted by total time
+  inline const std::vector<Profiler::ScopeStatistics>& GetFrameStatistics() const
+  {
+    return m_FrameStatistics;
+  }
+
+  // frames not timed because their query set was still in flight
+  inline std::size_t GetSkippedFrames() const
+  {
+    return m_Skipped;
+  }
+
+private:
+  struct Scope {
+    const char* name = nullptr;
+    std::uint32_t beginQuery = 0;
+    std::uint32_t endQuery   = 0;
+  };
+
+  struct Frame {
+    std::vector<Scope> scopes{};
+    std::uint32_t queryCount = 0;
+    std::uint32_t lastQuery  = 0;   // queries complete in issue order, the last one issued tells when all are done
+    bool pending = false;
+    // calibration pair in effect when the frame was recorded
+    std::uint64_t cpuTicks       = 0;
+    std::uint64_t gpuNanoseconds = 0;
+  };
+
+  GpuProfiler() = default;
+
+  bool Resolve(Frame& frame);
+  void Calibrate();
+
+  static constexpr std::size_t   frameLatency       = 4;
+  static constexpr std::uint32_t maxQueriesPerFrame = 128;
+  static constexpr double        calibrationSeconds = 5.0;
+
+  std::vector<unsigned int> m_Queries{};
+  Frame m_Frames[GpuProfiler::frameLatency]{};
+  std::size_t m_Frame = 0;
+  bool m_Recording = false;
+  std::size_t m_Skipped = 0;
+
+  std::uint64_t m_CpuTicks       = 0;
+  std::uint64_t m_GpuNanoseconds = 0;
+
+  std::unordered_map<const char*, std::size_t> m_ScopeIndices{};
+  std::vector<Profiler::ScopeStatistics> m_Scopes{};
+  std::vector<Profiler::ScopeStatistics> m_FrameStatistics{};
+};
+
+class GpuProfileScope {
+public:
+  explicit GpuProfileScope(const char* name) :
+    m_Scope{ GpuProfiler::Instance().Begin(name) }
+  {
+  }
+
+  ~GpuProfileScope()
+  {
+    GpuProfiler::Instance().End(m_Scope);
+  }
+
+  GpuProfileScope(const GpuProfileScope&) = delete;
+  GpuProfileScope& operator=(const GpuProfileScope&) = delete;
+
+private:
+  std::uint32_t m_Scope;
+};
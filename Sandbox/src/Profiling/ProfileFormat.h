@@ -0,0 +1,12 @@
+#pragma once
+
+#include <cstdint>
+
+// compact capture written by Profiler::WriteBinary, integers little endian as written by the capturing machine:
+//   [magic][u32 version][f64 ticks per second]
+//   [u32 name count]   { [u32 length][chars] }
+//   [u32 thread count] { [u32 length][chars] }
+//   [u64 event count]  { [u32 name][u32 thread][u64 begin ticks][u64 duration ticks] }
+// begin ticks are relative to the first captured event
+constexpr char          profileMagic[4] = { 'P', 'R', 'O', 'F' };
+constexpr std::uint32_t profileVersion  = 1;
@@ -0,0 +1,315 @@
+#include "Profiler.h"
+
+#include <cstdio>
+#include <sstream>
+#include <algorithm>
+
+#include "Profiling/ProfileFormat.h"
+
+thread_local Profiler::ThreadBuffer* Profiler::t_Buffer = nullptr;
+
+namespace {
+  double SteadySeconds()
+  {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+  }
+
+  // retires the ring of an exiting thread
+  struct ThreadRetirement {
+    std::atomic<bool>* retired = nullptr;
+
+    ~ThreadRetirement()
+    {
+      if (retired)
+      {
+        retired->store(true, std::memory_order_release);
+      }
+    }
+  };
+
+  thread_local ThreadRetirement t_Retirement{};
+
+  template <typename T>
+  void Write(std::FILE* file, const T& value)
+  {
+    std::fwrite(&value, sizeof(T), 1, file);
+  }
+
+  void WriteString(std::FILE* file, const std::string& text)
+  {
+    Write(file, static_cast<std::uint32_t>(text.size()));
+    std::fwrite(text.data(), 1, text.size(), file);
+  }
+
+  void WriteJsonString(std::FILE* file, const char* text)
+  {
+    std::fputc('"', file);
+    for (; *text; ++text)
+    {
+      if (*text == '"' || *text == '\\')
+      {
+        std::fputc('\\', file);
+      }
+      std::fputc(*text, file);
+    }
+    std::fputc('"', file);
+  }
+}
+
+Profiler::Profiler() :
+  m_OriginTicks  { Profiler::Now() },
+  m_OriginSeconds{ SteadySeconds() }
+{
+  m_FrameBegin = m_OriginTicks;
+}
+
+double Profiler::TicksPerSecond() const
+{
+#ifdef PROFILER_RDTSC
+  // calibrated against steady_clock over the whole run, good to a fraction of a percent after a few frames
+  double seconds = SteadySeconds() - m_OriginSeconds;
+  if (seconds < 1e-3)
+  {
+    return 1e9;
+  }
+  return static_cast<double>(Profiler::Now() - m_OriginTicks) / seconds;
+#else
+  return 1e9;
+#endif
+}
+
+void Profiler::SetThreadName(const char* name)
+{
+  ThreadBuffer& buffer = GetThreadBuffer();
+  std::lock_guard<std::mutex> lock{ m_Mutex };
+  m_Tracks[buffer.track] = name;
+}
+
+void Profiler::EndFrame()
+{
+  std::uint64_t now = Profiler::Now();
+  Record("Frame", m_FrameBegin, now);
+  m_FrameBegin = now;
+
+  for (ScopeStatistics& scope : m_Scopes)
+  {
+    scope.calls           = 0;
+    scope.milliseconds    = 0.0;
+    scope.maxMilliseconds = 0.0;
+  }
+
+  const double ticksToMilliseconds = 1000.0 / TicksPerSecond();
+  { std::lock_guard<std::mutex> lock{ m_Mutex };
+    for (std::unique_ptr<ThreadBuffer>& buffer : m_Threads)
+    {
+      Drain(*buffer, ticksToMilliseconds);
+    }
+  }
+
+  m_FrameStatistics.clear();
+  for (const ScopeStatistics& scope : m_Scopes)
+  {
+    if (scope.calls)
+    {
+      m_FrameStatistics.push_back(scope);
+    }
+  }
+
+  std::sort(
+    std::begin(m_FrameStatistics),
+    std::end(m_FrameStatistics),
+    [](const ScopeStatistics& lhs, const ScopeStatistics& rhs) -> bool
+    {
+      return lhs.milliseconds > rhs.milliseconds;
+    }
+  );
+}
+
+void Profiler::BeginCapture()
+{
+  m_Capture.clear();
+  m_Capturing = true;
+}
+
+void Profiler::EndCapture()
+{
+  m_Capturing = false;
+}
+
+void Profiler::WriteChromeTrace(const char* path) const
+{
+  std::FILE* file = std::fopen(path, "wb");
+  if (!file)
+  {
+    std::ostringstream outStream{};
+    outStream << "[ERROR::PROFILER] Could not open profile file : " << path;
+    throw std::exception{ outStream.str().c_str() };
+  }
+
+  const double ticksToMicroseconds = 1.0e6 / TicksPerSecond();
+  const std::uint64_t origin = m_Capture.empty() ? 0 : std::min_element(
+    std::begin(m_Capture),
+    std::end(m_Capture),
+    [](const CapturedEvent& lhs, const CapturedEvent& rhs) -> bool
+    {
+      return lhs.event.begin < rhs.event.begin;
+    }
+  )->event.begin;
+
+  std::fputs("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n", file);
+  for (std::size_t track = 0; track < m_Tracks.size(); ++track)
+  {
+    std::fprintf(file, "{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":1,\"tid\":%zu,\"args\":{\"name\":", track);
+    WriteJsonString(file, m_Tracks[track].c_str());
+    std::fputs("}},\n", file);
+  }
+
+  for (std::size_t i = 0; i < m_Capture.size(); ++i)
+  {
+    const CapturedEvent& captured = m_Capture[i];
+    std::fputs("{\"ph\":\"X\",\"name\":", file);
+    WriteJsonString(file, captured.event.name);
+    std::fprintf(file, ",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}%s\n",
+                 captured.track,
+                 (captured.event.begin - origin) * ticksToMicroseconds,
+                 (captured.event.end - captured.event.begin) * ticksToMicroseconds,
+                 i + 1 < m_Capture.size() ? "," : "");
+  }
+  std::fputs("]}\n", file);
+  std::fclose(file);
+}
+
+void Profiler::WriteBinary(const char* path) const
+{
+  std::FILE* file = std::fopen(path, "wb");
+  if (!file)
+  {
+    std::ostringstream outStream{};
+    outStream << "[ERROR::PROFILER] Could not open profile file : " << path;
+    throw std::exception{ outStream.str().c_str() };
+  }
+
+  std::vector<std::string> names{};
+  std::unordered_map<const char*, std::uint32_t> nameIndices{};
+  std::uint64_t origin = UINT64_MAX;
+  for (const CapturedEvent& captured : m_Capture)
+  {
+    if (nameIndices.emplace(captured.event.name, static_cast<std::uint32_t>(names.size())).second)
+    {
+      names.push_back(captured.event.name);
+    }
+    origin = std::min(origin, captured.event.begin);
+  }
+
+  std::fwrite(profileMagic, sizeof(profileMagic), 1, file);
+  Write(file, profileVersion);
+  Write(file, TicksPerSecond());
+
+  Write(file, static_cast<std::uint32_t>(names.size()));
+  for (const std::string& name : names)
+  {
+    WriteString(file, name);
+  }
+
+  Write(file, static_cast<std::uint32_t>(m_Tracks.size()));
+  for (const std::string& track : m_Tracks)
+  {
+    WriteString(file, track);
+  }
+
+  Write(file, static_cast<std::uint64_t>(m_Capture.size()));
+  for (const CapturedEvent& captured : m_Capture)
+  {
+    Write(file, nameIndices.at(captured.event.name));
+    Write(file, captured.track);
+    Write(file, captured.event.begin - origin);
+    Write(file, captured.event.end - captured.event.begin);
+  }
+  std::fclose(file);
+}
+
+void Profiler::AddCapturedEvent(const char* name, const char* thread, std::uint64_t begin, std::uint64_t end)
+{
+  if (!m_Capturing || m_Capture.size() >= Profiler::maxCapturedEvents)
+  {
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock{ m_Mutex };
+  m_Capture.push_back(CapturedEvent{ Event{ name, begin, end }, FindTrack(thread) });
+}
+
+Profiler::ThreadBuffer& Profiler::RegisterThread()
+{
+  std::lock_guard<std::mutex> lock{ m_Mutex };
+
+  ThreadBuffer* buffer = nullptr;
+  for (std::unique_ptr<ThreadBuffer>& candidate : m_Threads)
+  {
+    if (candidate->retired.load(std::memory_order_acquire) &&
+        candidate->read.load(std::memory_order_relaxed) == candidate->write.load(std::memory_order_relaxed))
+    {
+      buffer = candidate.get();
+      buffer->retired.store(false, std::memory_order_relaxed);
+      break;
+    }
+  }
+
+  if (!buffer)
+  {
+    m_Threads.push_back(std::make_unique<ThreadBuffer>());
+    buffer = m_Threads.back().get();
+    buffer->events = std::make_unique<Event[]>(Profiler::ringSize);
+    buffer->track  = static_cast<std::uint32_t>(m_Tracks.size());
+    m_Tracks.push_back("Thread " + std::to_string(m_Threads.size() - 1));
+  }
+
+  t_Buffer = buffer;
+  t_Retirement.retired = &buffer->retired;
+  return *buffer;
+}
+
+std::uint32_t Profiler::FindTrack(const char* name)
+{
+  auto it = std::find(std::begin(m_Tracks), std::end(m_Tracks), name);
+  if (it != std::end(m_Tracks))
+  {
+    return static_cast<std::uint32_t>(it - std::begin(m_Tracks));
+  }
+
+  m_Tracks.push_back(name);
+  return static_cast<std::uint32_t>(m_Tracks.size() - 1);
+}
+
+void Profiler::Drain(ThreadBuffer& buffer, double ticksToMilliseconds)
+{
+  std::uint64_t read  = buffer.read.load(std::memory_order_relaxed);
+  std::uint64_t write = buffer.write.load(std::memory_order_acquire);
+  m_Dropped += buffer.dropped.exchange(0, std::memory_order_relaxed);
+
+  for (; read < write; ++read)
+  {
+    const Event& event = buffer.events[read & (Profiler::ringSize - 1)];
+
+    auto it = m_ScopeIndices.find(event.name);
+    if (it == std::end(m_ScopeIndices))
+    {
+      it = m_ScopeIndices.emplace(event.name, m_Scopes.size()).first;
+      m_Scopes.push_back(ScopeStatistics{ event.name });
+      m_FrameStatistics.reserve(m_Scopes.size());
+    }
+
+    ScopeStatistics& scope = m_Scopes[it->second];
+    double milliseconds = (event.end - event.begin) * ticksToMilliseconds;
+    ++scope.calls;
+    scope.milliseconds   += milliseconds;
+    scope.maxMilliseconds = std::max(scope.maxMilliseconds, milliseconds);
+
+    if (m_Capturing && m_Capture.size() < Profiler::maxCapturedEvents)
+    {
+      m_Capture.push_back(CapturedEvent{ event, buffer.track });
+    }
+  }
+
+  buffer.read.store(write, std::memory_order_release);
+}
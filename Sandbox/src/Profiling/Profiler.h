@@ -0,0 +1,208 @@
+#pragma once
+
+#include <mutex>
+#include <chrono>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define PROFILER_RDTSC
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#endif
+
+// instrumentation compiles to nothing unless PROFILE is 1, it defaults to on in debug builds only,
+// release builds can opt in with PROFILE=1
+#ifndef PROFILE
+#ifdef NDEBUG
+#define PROFILE 0
+#else
+#define PROFILE 1
+#endif
+#endif
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+
+#if PROFILE
+// name has to be a string literal, scopes are aggregated by its address
+#define PROFILE_SCOPE(name) ProfileScope PROFILE_CONCAT(profileScope, __LINE__){ name }
+#define PROFILE_THREAD(name) Profiler::Instance().SetThreadName(name)
+#define PROFILE_FRAME() Profiler::Instance().EndFrame()
+#else
+#define PROFILE_SCOPE(name)
+#define PROFILE_THREAD(name)
+#define PROFILE_FRAME()
+#endif
+
+// scoped CPU instrumentation, every thread writes its finished scopes into its own fixed size ring without locking,
+// EndFrame drains the rings on the frame thread, aggregates the frame and appends the events to a running capture,
+// timestamps are rdtsc ticks on x86 (invariant TSC assumed) and steady_clock nanoseconds elsewhere
+class Profiler {
+public:
+  struct Event {
+    const char* name   = nullptr;
+    std::uint64_t begin = 0;
+    std::uint64_t end   = 0;
+  };
+
+  struct ScopeStatistics {
+    const char* name        = nullptr;
+    std::uint32_t calls     = 0;
+    double milliseconds     = 0.0;
+    double maxMilliseconds  = 0.0;
+  };
+
+  static Profiler& Instance()
+  {
+    static Profiler instance{};
+    return instance;
+  }
+
+  Profiler(const Profiler&) = delete;
+  Profiler& operator=(const Profiler&) = delete;
+
+  static inline std::uint64_t Now()
+  {
+#ifdef PROFILER_RDTSC
+    return __rdtsc();
+#else
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+  }
+
+  double TicksPerSecond() const;
+
+  // lock free for the calling thread, its ring is registered on first use
+  inline void Record(const char* name, std::uint64_t begin, std::uint64_t end)
+  {
+    ThreadBuffer& buffer = GetThreadBuffer();
+    std::uint64_t write = buffer.write.load(std::memory_order_relaxed);
+    if (write - buffer.read.load(std::memory_order_acquire) >= Profiler::ringSize)
+    {
+      buffer.dropped.fetch_add(1, std::memory_order_relaxed);
+      return;
+    }
+
+    buffer.events[write & (Profiler::ringSize - 1)] = Event{ name, begin, end };
+    buffer.write.store(write + 1, std::memory_order_release);
+  }
+
+  void SetThreadName(const char* name);
+
+  // on the frame thread, records the frame itself as a scope and drains every ring
+  void EndFrame();
+
+  // scopes drained by the last EndFrame, sorted by total time
+  inline const std::vector<ScopeStatistics>& GetFrameStatistics() const
+  {
+    return m_FrameStatistics;
+  }
+
+  inline std::size_t GetDroppedEvents() const
+  {
+    return m_Dropped;
+  }
+
+  // events are kept between BeginCapture and EndCapture, written by the exporters afterwards
+  void BeginCapture();
+  void EndCapture();
+
+  inline bool IsCapturing() const
+  {
+    return m_Capturing;
+  }
+
+  inline std::size_t GetCapturedEvents() const
+  {
+    return m_Capture.size();
+  }
+
+  // Chrome trace event format, loads in chrome://tracing and Perfetto
+  void WriteChromeTrace(const char* path) const;
+  // see ProfileFormat.h
+  void WriteBinary(const char* path) const;
+
+  // events of other sources (GPU timers) already converted to profiler ticks, thread names the track they appear on
+  void AddCapturedEvent(const char* name, const char* thread, std::uint64_t begin, std::uint64_t end);
+
+private:
+  struct ThreadBuffer {
+    std::unique_ptr<Event[]> events{};
+    std::atomic<std::uint64_t> write{ 0 };
+    std::atomic<std::uint64_t> read{ 0 };
+    std::atomic<std::size_t> dropped{ 0 };
+    // set when the owning thread exits, the ring is handed to the next new thread once drained
+    std::atomic<bool> retired{ false };
+    std::uint32_t track = 0;
+  };
+
+  struct CapturedEvent {
+    Event event{};
+    std::uint32_t track = 0;
+  };
+
+  Profiler();
+
+  inline ThreadBuffer& GetThreadBuffer()
+  {
+    return t_Buffer ? *t_Buffer : RegisterThread();
+  }
+
+  ThreadBuffer& RegisterThread();
+  std::uint32_t FindTrack(const char* name);
+  void Drain(ThreadBuffer& buffer, double ticksToMilliseconds);
+
+  static thread_local ThreadBuffer* t_Buffer;
+
+  static constexpr std::size_t ringSize = 64 * 1024;
+  static constexpr std::size_t maxCapturedEvents = 16 * 1024 * 1024;
+
+  // calibration pair for rdtsc, taken at construction
+  std::uint64_t m_OriginTicks = 0;
+  double m_OriginSeconds = 0.0;
+
+  // threads and other event sources each get a track, named in the exported traces
+  std::mutex m_Mutex{};
+  std::vector<std::unique_ptr<ThreadBuffer>> m_Threads{};
+  std::vector<std::string> m_Tracks{};
+
+  // every scope seen so far keeps its slot, the frame statistics are rebuilt from them without allocating
+  std::uint64_t m_FrameBegin = 0;
+  std::unordered_map<const char*, std::size_t> m_ScopeIndices{};
+  std::vector<ScopeStatistics> m_Scopes{};
+  std::vector<ScopeStatistics> m_FrameStatistics{};
+  std::size_t m_Dropped = 0;
+
+  bool m_Capturing = false;
+  std::vector<CapturedEvent> m_Capture{};
+};
+
+class ProfileScope {
+public:
+  explicit ProfileScope(const char* name) :
+    m_Name { name              },
+    m_Begin{ Profiler::Now()   }
+  {
+  }
+
+  ~ProfileScope()
+  {
+    Profiler::Instance().Record(m_Name, m_Begin, Profiler::Now());
+  }
+
+  ProfileScope(const ProfileScope&) = delete;
+  ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+  const char* m_Name;
+  std::uint64_t m_Begin;
+};
@@ -0,0 +1,43 @@
+#include "CommandBuffer.h"
+
+#include "Renderer/RenderQueue.h"
+
+void CommandBuffer::Begin(const RenderQueue& queue)
+{
+  m_Queue = &queue;
+  m_Packets.clear();
+  m_Entries.clear();
+  m_ProgramSwitches  = 0;
+  m_MaterialSwitches = 0;
+  m_MeshSwitches     = 0;
+}
+
+void CommandBuffer::Submit(const Mesh& mesh, const Material& material, const glm::mat4& model, std::uint32_t materialIndex)
+{
+  Packet packet{};
+  packet.mesh          = &mesh;
+  packet.material      = &material;
+  packet.model         = model;
+  packet.materialIndex = materialIndex;
+
+  const Packet* last = m_Packets.empty() ? nullptr : &m_Packets.back();
+  if (!last || last->material->GetShader().Program() != material.GetShader().Program())
+  {
+    ++m_ProgramSwitches;
+  }
+  if (!last || last->material != &material)
+  {
+    ++m_MaterialSwitches;
+  }
+  if (!last || last->mesh->GetVertexArray().GetID() != mesh.GetVertexArray().GetID())
+  {
+    ++m_MeshSwitches;
+  }
+
+  SortEntry entry{};
+  entry.key   = m_Queue->EncodeKey(packet, m_Queue->FindMaterialIndex(material), m_Queue->FindMeshIndex(mesh));
+  entry.index = static_cast<std::uint32_t>(m_Packets.size());
+
+  m_Packets.push_back(packet);
+  m_Entries.push_back(entry);
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+#include <glm/glm.hpp>
+
+#include "Renderer/Mesh.h"
+#include "Renderer/Material.h"
+
+class RenderQueue;
+
+// draw packets of one render pass recorded by one thread, sort keys are generated while recording so merging
+// into the RenderQueue is a copy, see RenderQueue::Record, nothing here touches GL
+class CommandBuffer {
+public:
+  struct Packet {
+    const Mesh* mesh         = nullptr;
+    const Material* material = nullptr;
+    glm::mat4 model{};
+    std::uint32_t materialIndex = 0;
+  };
+
+  struct SortEntry {
+    std::uint64_t key   = 0;
+    std::uint32_t index = 0;
+  };
+
+  // keys are encoded against the queue's view position and registered meshes and materials
+  void Begin(const RenderQueue& queue);
+  void Submit(const Mesh& mesh, const Material& material, const glm::mat4& model, std::uint32_t materialIndex = 0);
+
+  inline std::size_t GetSize() const
+  {
+    return m_Packets.size();
+  }
+
+private:
+  friend class RenderQueue;
+
+  const RenderQueue* m_Queue = nullptr;
+  std::vector<Packet> m_Packets{};
+  std::vector<SortEntry> m_Entries{};
+
+  // switches within this buffer in recording order, summed into the queue statistics on merge
+  std::size_t m_ProgramSwitches  = 0;
+  std::size_t m_MaterialSwitches = 0;
+  std::size_t m_MeshSwitches     = 0;
+};
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+
+#include <glm/glm.hpp>
+
+#include "Renderer/Mesh.h"
+#include "Renderer/Material.h"
+
+// everything the render thread needs to draw one frame, written by the simulation and immutable once handed over,
+// meshes and materials are referenced, they have to outlive the frames using them
+struct FrameSnapshot {
+  struct Light {
+    glm::vec3 position{};
+    glm::vec3 color{ 1.0f };
+  };
+
+  struct Instance {
+    const Mesh* mesh            = nullptr;
+    const Material* material    = nullptr;
+    glm::mat4 model{ 1.0f };
+    std::uint32_t materialIndex = 0;
+  };
+
+  glm::mat4 view{ 1.0f };
+  glm::mat4 projection{ 1.0f };
+  glm::vec3 cameraPosition{};
+  float farPlane = 1.0f;
+
+  std::vector<Light> lights{};
+  std::vector<Instance> instances{};
+
+  // keeps the capacity, the two pipeline slots stop allocating after a few frames
+  inline void Clear()
+  {
+    lights.clear();
+    instances.clear();
+  }
+};
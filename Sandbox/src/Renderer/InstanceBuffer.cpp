@@ -0,0 +1,40 @@
+#include "InstanceBuffer.h"
+
+void InstanceBuffer::Attach(VertexArray& vertexArray) const
+{
+  vertexArray.SetVertexBuffer(InstanceBuffer::binding, m_Buffer.GetID(), 0, sizeof(InstanceData));
+  vertexArray.SetBindingDivisor(InstanceBuffer::binding, 1);
+
+  for (unsigned int column = 0; column < 4; ++column)
+  {
+    vertexArray.SetAttribute(InstanceBuffer::modelLocation + column, InstanceBuffer::binding, 4, GL_FLOAT, false, column * sizeof(glm::vec4));
+  }
+  vertexArray.SetIntegerAttribute(InstanceBuffer::materialLocation, InstanceBuffer::binding, 1, GL_UNSIGNED_INT, sizeof(glm::mat4));
+}
+
+void InstanceBuffer::Clear()
+{
+  m_Instances.clear();
+}
+
+void InstanceBuffer::Upload()
+{
+  if (m_Instances.empty())
+  {
+    return;
+  }
+
+  // respecified every frame, the driver orphans the previous storage instead of waiting on draws still reading it
+  m_Buffer.SetData(m_Instances.size(), m_Instances.data(), GL_ARRAY_BUFFER, GL_STREAM_DRAW);
+}
+
+void InstanceBuffer::Bind(VertexArray& vertexArray, std::uint32_t firstInstance) const
+{
+  vertexArray.SetVertexBuffer(InstanceBuffer::binding, m_Buffer.GetID(), firstInstance * sizeof(InstanceData), sizeof(InstanceData));
+}
+
+void InstanceBuffer::Dispose()
+{
+  m_Buffer.Dispose();
+  m_Instances.clear();
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+#include <glm/glm.hpp>
+
+#include "Core/Buffer.h"
+#include "Core/VertexArray.h"
+
+struct InstanceData {
+  glm::mat4 model{ 1.0f };
+  std::uint32_t material = 0;
+  std::uint32_t padding[3]{};
+};
+
+// per instance attributes streamed once per frame, instanced shaders read
+// the model matrix at locations [modelLocation, modelLocation + 3] and the material index at materialLocation
+class InstanceBuffer {
+public:
+  static constexpr unsigned int binding          = 15;
+  static constexpr unsigned int modelLocation    = 8;
+  static constexpr unsigned int materialLocation = 12;
+
+  // adds the instance attributes to a vertex array, its own attributes stay untouched
+  void Attach(VertexArray& vertexArray) const;
+
+  inline std::uint32_t Append(const glm::mat4& model, std::uint32_t material)
+  {
+    InstanceData instance{};
+    instance.model    = model;
+    instance.material = material;
+    m_Instances.push_back(instance);
+    return static_cast<std::uint32_t>(m_Instances.size() - 1);
+  }
+
+  void Clear();
+  void Upload();
+
+  // points the instance binding of the vertex array at firstInstance
+  void Bind(VertexArray& vertexArray, std::uint32_t firstInstance) const;
+
+  inline std::size_t GetSize() const
+  {
+    return m_Instances.size();
+  }
+
+  void Dispose();
+
+private:
+  Buffer<InstanceData> m_Buffer{};
+  std::vector<InstanceData> m_Instances{};
+};
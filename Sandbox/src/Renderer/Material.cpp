@@ -0,0 +1,85 @@
+#include "Material.h"
+
+#include <algorithm>
+
+#include <glm/gtc/type_ptr.hpp>
+
+Material::Material(Shader& shader, bool transparent) :
+  m_Shader      { &shader     },
+  m_Transparent { transparent }
+{
+}
+
+void Material::SetTexture(unsigned int unit, const Texture& texture)
+{
+  m_Textures.at(unit) = &texture;
+}
+
+void Material::SetUniform(const char* uniform, int value)
+{
+  Uniform entry{};
+  entry.location = m_Shader->GetUniformLocation(uniform);
+  entry.type     = UniformType::INT;
+  entry.intValue = value;
+  SetUniform(entry);
+}
+
+void Material::SetUniform(const char* uniform, float value)
+{
+  Uniform entry{};
+  entry.location = m_Shader->GetUniformLocation(uniform);
+  entry.type     = UniformType::FLOAT;
+  entry.value.x  = value;
+  SetUniform(entry);
+}
+
+void Material::SetUniform(const char* uniform, const glm::vec3& value)
+{
+  Uniform entry{};
+  entry.location = m_Shader->GetUniformLocation(uniform);
+  entry.type     = UniformType::VEC3;
+  entry.value    = value;
+  SetUniform(entry);
+}
+
+void Material::SetUniform(const Uniform& uniform)
+{
+  auto it = std::find_if(
+    std::begin(m_Uniforms),
+    std::end(m_Uniforms),
+    [&](const Uniform& entry) -> bool
+    {
+      return entry.location == uniform.location;
+    }
+  );
+
+  if (it == std::end(m_Uniforms))
+  {
+    m_Uniforms.push_back(uniform);
+  }
+  else
+  {
+    *it = uniform;
+  }
+}
+
+void Material::Apply() const
+{
+  for (unsigned int unit = 0; unit < Material::maxTextureUnits; ++unit)
+  {
+    if (m_Textures[unit])
+    {
+      m_Textures[unit]->Bind(unit);
+    }
+  }
+
+  for (const Uniform& uniform : m_Uniforms)
+  {
+    switch (uniform.type)
+    {
+    case UniformType::INT:   m_Shader->SetUniform1i(uniform.location, uniform.intValue);                   break;
+    case UniformType::FLOAT: m_Shader->SetUniform1f(uniform.location, uniform.value.x);                    break;
+    case UniformType::VEC3:  m_Shader->SetUniform3fv(uniform.location, glm::value_ptr(uniform.value));     break;
+    }
+  }
+}
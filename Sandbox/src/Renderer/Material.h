@@ -0,0 +1,83 @@
+#pragma once
+
+#include <array>
+#include <vector>
+#include <cstdint>
+
+#include <glm/glm.hpp>
+
+#include "Core/Shader.h"
+#include "Core/Texture.h"
+
+// program, textures and constant uniforms shared by every draw using the material
+class Material {
+public:
+  Material(Shader& shader, bool transparent = false);
+
+  void SetTexture(unsigned int unit, const Texture& texture);
+  void SetUniform(const char* uniform, int value);
+  void SetUniform(const char* uniform, float value);
+  void SetUniform(const char* uniform, const glm::vec3& value);
+
+  // expects the material's shader to be bound
+  void Apply() const;
+
+  inline Shader& GetShader() const
+  {
+    return *m_Shader;
+  }
+
+  inline bool IsTransparent() const
+  {
+    return m_Transparent;
+  }
+
+  // instanced materials read their model matrix and material index from the InstanceBuffer attributes
+  inline void SetInstanced(bool instanced)
+  {
+    m_Instanced = instanced;
+  }
+
+  inline bool IsInstanced() const
+  {
+    return m_Instanced;
+  }
+
+  // draws of the material are profiled under this scope name, has to be a string literal
+  inline void SetPassName(const char* name)
+  {
+    m_PassName = name;
+  }
+
+  inline const char* GetPassName() const
+  {
+    return m_PassName;
+  }
+
+private:
+  enum class UniformType
+    : std::int32_t
+  {
+    INT,
+    FLOAT,
+    VEC3
+  };
+
+  struct Uniform {
+    unsigned int location = 0;
+    UniformType type      = UniformType::INT;
+    int intValue          = 0;
+    glm::vec3 value{};
+  };
+
+  void SetUniform(const Uniform& uniform);
+
+  static constexpr std::size_t maxTextureUnits = 8;
+
+  Shader* m_Shader = nullptr;
+  bool m_Transparent = false;
+  bool m_Instanced   = false;
+  const char* m_PassName = nullptr;
+  std::array<const Texture*, maxTextureUnits> m_Textures{};
+  std::vector<Uniform> m_Uniforms{};
+};
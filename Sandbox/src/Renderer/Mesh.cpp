@@ -0,0 +1,25 @@
+#include "Mesh.h"
+
+#include "Core/Draw.h"
+
+Mesh::Mesh(const VertexArray& vertexArray, int count, unsigned int indexType, unsigned int mode, unsigned int firstIndex, int baseVertex) :
+  m_VertexArray { &vertexArray },
+  m_Count       { count        },
+  m_IndexType   { indexType    },
+  m_Mode        { mode         },
+  m_FirstIndex  { firstIndex   },
+  m_BaseVertex  { baseVertex   }
+{
+}
+
+void Mesh::Draw(int instances) const
+{
+  if (m_IndexType)
+  {
+    DrawElements(m_Mode, m_Count, m_IndexType, m_FirstIndex * GetIndexSize(m_IndexType), instances, m_BaseVertex);
+  }
+  else
+  {
+    DrawArrays(m_Mode, 0, m_Count, instances);
+  }
+}
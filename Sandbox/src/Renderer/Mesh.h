@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstddef>
+
+#include <GL/glew.h>
+
+#include "Core/VertexArray.h"
+
+// drawable range of a vertex array, indexType 0 draws non-indexed,
+// firstIndex and baseVertex locate meshes packed into shared buffers (see MeshPool)
+class Mesh {
+public:
+  Mesh(const VertexArray& vertexArray                                   ,
+       int count                                                        ,
+       unsigned int indexType  = Mesh::defaultIndexType                 ,
+       unsigned int mode       = Mesh::defaultMode                      ,
+       unsigned int firstIndex = 0                                      ,
+       int baseVertex          = 0                                      );
+
+  void Draw(int instances = 1) const;
+
+  inline const VertexArray& GetVertexArray() const
+  {
+    return *m_VertexArray;
+  }
+
+  inline int GetCount() const
+  {
+    return m_Count;
+  }
+
+  inline unsigned int GetIndexType() const
+  {
+    return m_IndexType;
+  }
+
+  inline unsigned int GetMode() const
+  {
+    return m_Mode;
+  }
+
+  inline unsigned int GetFirstIndex() const
+  {
+    return m_FirstIndex;
+  }
+
+  inline int GetBaseVertex() const
+  {
+    return m_BaseVertex;
+  }
+
+private:
+  static constexpr unsigned int defaultIndexType = 0;
+  static constexpr unsigned int defaultMode      = GL_TRIANGLES;
+
+  const VertexArray* m_VertexArray = nullptr;
+  int m_Count                      = 0;
+  unsigned int m_IndexType         = 0;
+  unsigned int m_Mode              = 0;
+  unsigned int m_FirstIndex        = 0;
+  int m_BaseVertex                 = 0;
+};
@@ -0,0 +1,51 @@
+#include "MeshPool.h"
+
+#include <numeric>
+
+MeshPool::MeshPool(int vertexStride) :
+  m_Stride{ vertexStride }
+{
+}
+
+MeshPool::~MeshPool()
+{
+  Dispose();
+}
+
+Mesh MeshPool::Add(const std::vector<float>& vertices, const std::vector<std::uint32_t>& indices)
+{
+  unsigned int firstIndex = static_cast<unsigned int>(m_Indices.size());
+  int baseVertex          = static_cast<int>(m_Vertices.size() / m_Stride);
+
+  m_Vertices.insert(std::end(m_Vertices), std::begin(vertices), std::end(vertices));
+  m_Indices.insert(std::end(m_Indices), std::begin(indices), std::end(indices));
+
+  return Mesh{ m_VertexArray, static_cast<int>(indices.size()), GL_UNSIGNED_INT, GL_TRIANGLES, firstIndex, baseVertex };
+}
+
+Mesh MeshPool::Add(const std::vector<float>& vertices)
+{
+  std::vector<std::uint32_t> indices(vertices.size() / m_Stride);
+  std::iota(std::begin(indices), std::end(indices), 0);
+  return Add(vertices, indices);
+}
+
+void MeshPool::Upload()
+{
+  m_VertexBuffer.SetData(m_Vertices.size(), m_Vertices.data());
+  m_VertexArray.SetVertexBuffer(0, m_VertexBuffer.GetID(), 0, m_Stride * sizeof(float));
+
+  // the element array binding belongs to whichever vertex array is bound, attach it explicitly after the upload
+  m_VertexArray.Bind();
+  m_IndexBuffer.SetData(m_Indices.size(), m_Indices.data(), GL_ELEMENT_ARRAY_BUFFER);
+  m_VertexArray.SetIndexBuffer(m_IndexBuffer.GetID());
+}
+
+void MeshPool::Dispose()
+{
+  m_VertexArray.Dispose();
+  m_VertexBuffer.Dispose();
+  m_IndexBuffer.Dispose();
+  m_Vertices.clear();
+  m_Indices.clear();
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+#include "Core/Buffer.h"
+#include "Core/VertexArray.h"
+#include "Renderer/Mesh.h"
+
+// packs meshes of one vertex layout into shared vertex and index buffers behind a single vertex array,
+// so any mix of them can be drawn with one glMultiDrawElementsIndirect
+class MeshPool {
+public:
+  // stride in floats, the layout's attributes are set on GetVertexArray() against binding 0
+  MeshPool(int vertexStride);
+  ~MeshPool();
+
+  Mesh Add(const std::vector<float>& vertices, const std::vector<std::uint32_t>& indices);
+  Mesh Add(const std::vector<float>& vertices);
+
+  // uploads everything added so far, meshes are drawable after the first upload
+  void Upload();
+
+  inline VertexArray& GetVertexArray()
+  {
+    return m_VertexArray;
+  }
+
+  void Dispose();
+
+private:
+  int m_Stride = 0;
+  std::vector<float> m_Vertices{};
+  std::vector<std::uint32_t> m_Indices{};
+
+  Buffer<float> m_VertexBuffer{};
+  Buffer<std::uint32_t> m_IndexBuffer{};
+  VertexArray m_VertexArray{};
+};
@@ -0,0 +1,403 @@
+#include "RenderQueue.h"
+
+#include <array>
+#include <algorithm>
+
+#include <GL/glew.h>
+#include <glm/gtc/type_ptr.hpp>
+
+#include "Core/Core.h"
+#include "Core/GLStateCache.h"
+
+#include "Profiling/Profiler.h"
+#include "Profiling/GpuProfiler.h"
+
+void RenderQueue::EnableInstancing(VertexArray& vertexArray)
+{
+  m_InstanceBuffer.Attach(vertexArray);
+  m_InstancedArrays[vertexArray.GetID()] = &vertexArray;
+}
+
+void RenderQueue::Register(const Material& material)
+{
+  MaterialIndex(material);
+}
+
+void RenderQueue::Register(const Mesh& mesh)
+{
+  MeshIndex(mesh);
+}
+
+void RenderQueue::Begin(const glm::vec3& viewPosition, float farPlane)
+{
+  m_ViewPosition = viewPosition;
+  m_FarPlane     = std::max(farPlane, 1e-3f);
+
+  m_Packets.clear();
+  m_Entries.clear();
+  m_Statistics = Statistics{};
+}
+
+void RenderQueue::Submit(const Mesh& mesh, const Material& material, const glm::mat4& model, std::uint32_t materialIndex)
+{
+  Packet packet{};
+  packet.mesh          = &mesh;
+  packet.material      = &material;
+  packet.model         = model;
+  packet.materialIndex = materialIndex;
+
+  const Packet* last = m_Packets.empty() ? nullptr : &m_Packets.back();
+  if (!last || last->material->GetShader().Program() != material.GetShader().Program())
+  {
+    ++m_Statistics.unsortedProgramSwitches;
+  }
+  if (!last || last->material != &material)
+  {
+    ++m_Statistics.unsortedMaterialSwitches;
+  }
+  if (!last || last->mesh->GetVertexArray().GetID() != mesh.GetVertexArray().GetID())
+  {
+    ++m_Statistics.unsortedMeshSwitches;
+  }
+
+  SortEntry entry{};
+  entry.key   = EncodeKey(packet, MaterialIndex(material), MeshIndex(mesh));
+  entry.index = static_cast<std::uint32_t>(m_Packets.size());
+
+  m_Packets.push_back(packet);
+  m_Entries.push_back(entry);
+}
+
+void RenderQueue::Merge(const CommandBuffer& buffer)
+{
+  const std::uint32_t base = static_cast<std::uint32_t>(m_Packets.size());
+  m_Packets.insert(std::end(m_Packets), std::begin(buffer.m_Packets), std::end(buffer.m_Packets));
+
+  m_Entries.reserve(m_Entries.size() + buffer.m_Entries.size());
+  for (const SortEntry& entry : buffer.m_Entries)
+  {
+    m_Entries.push_back(SortEntry{ entry.key, entry.index + base });
+  }
+
+  m_Statistics.unsortedProgramSwitches  += buffer.m_ProgramSwitches;
+  m_Statistics.unsortedMaterialSwitches += buffer.m_MaterialSwitches;
+  m_Statistics.unsortedMeshSwitches     += buffer.m_MeshSwitches;
+}
+
+void RenderQueue::Sort()
+{
+  PROFILE_SCOPE("RenderQueue::Sort");
+  // LSD radix sort, 8 bits per pass, passes whose byte is equal for every key are skipped
+  std::array<std::array<std::uint32_t, 256>, sizeof(std::uint64_t)> histograms{};
+  for (const SortEntry& entry : m_Entries)
+  {
+    for (std::size_t pass = 0; pass < sizeof(std::uint64_t); ++pass)
+    {
+      ++histograms[pass][(entry.key >> (pass * 8)) & 0xFF];
+    }
+  }
+
+  m_Scratch.resize(m_Entries.size());
+  for (std::size_t pass = 0; pass < sizeof(std::uint64_t); ++pass)
+  {
+    std::array<std::uint32_t, 256>& histogram = histograms[pass];
+    if (m_Entries.empty() || histogram[(m_Entries.front().key >> (pass * 8)) & 0xFF] == m_Entries.size())
+    {
+      continue;
+    }
+
+    std::uint32_t offset = 0;
+    for (std::uint32_t& count : histogram)
+    {
+      std::uint32_t bucket = count;
+      count = offset;
+      offset += bucket;
+    }
+
+    for (const SortEntry& entry : m_Entries)
+    {
+      m_Scratch[histogram[(entry.key >> (pass * 8)) & 0xFF]++] = entry;
+    }
+    m_Entries.swap(m_Scratch);
+  }
+}
+
+void RenderQueue::Execute(const ProgramCallback& onProgram)
+{
+  PROFILE_GPU_SCOPE("RenderQueue::Execute");
+  BuildBatches();
+  m_InstanceBuffer.Upload();
+  if (!m_Commands.empty())
+  {
+    m_IndirectBuffer.SetData(m_Commands.size(), m_Commands.data(), GL_DRAW_INDIRECT_BUFFER, GL_STREAM_DRAW);
+  }
+
+  m_Statistics.packets = m_Packets.size();
+
+  const Material* material = nullptr;
+  unsigned int program     = 0;
+  unsigned int vertexArray = 0;
+  int modelLocation        = -1;
+  bool transparent         = false;
+
+#if PROFILE
+  // consecutive batches of one pass share a CPU and GPU scope, passes interleave only when materials sort in between
+  const char* pass        = nullptr;
+  std::uint64_t passBegin = 0;
+  std::uint32_t gpuPass   = GpuProfiler::invalidScope;
+  auto endPass = [&]()
+  {
+    if (pass)
+    {
+      GpuProfiler::Instance().End(gpuPass);
+      Profiler::Instance().Record(pass, passBegin, Profiler::Now());
+    }
+  };
+#endif
+
+  for (const Batch& batch : m_Batches)
+  {
+    const Packet& packet = m_Packets[m_Entries[batch.first].index];
+    Shader& shader = packet.material->GetShader();
+
+#if PROFILE
+    if (packet.material->GetPassName() != pass)
+    {
+      endPass();
+      pass = packet.material->GetPassName();
+      if (pass)
+      {
+        passBegin = Profiler::Now();
+        gpuPass   = GpuProfiler::Instance().Begin(pass);
+      }
+    }
+#endif
+
+    if (packet.material->IsTransparent() && !transparent)
+    {
+      transparent = true;
+      CALL(glEnable(GL_BLEND));
+      CALL(glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA));
+      CALL(glDepthMask(GL_FALSE));
+    }
+
+    if (shader.Program() != program)
+    {
+      program = shader.Program();
+      shader.Bind();
+      onProgram(shader);
+      modelLocation = -1;
+      material = nullptr;
+      ++m_Statistics.programSwitches;
+    }
+
+    if (packet.material != material)
+    {
+      material = packet.material;
+      material->Apply();
+      ++m_Statistics.materialSwitches;
+    }
+
+    if (packet.mesh->GetVertexArray().GetID() != vertexArray)
+    {
+      vertexArray = packet.mesh->GetVertexArray().GetID();
+      packet.mesh->GetVertexArray().Bind();
+      ++m_Statistics.meshSwitches;
+    }
+
+    ++m_Statistics.draws;
+    if (batch.commandCount)
+    {
+      // per draw data is fetched through the instance attributes, each command's baseInstance offsets into them
+      m_InstanceBuffer.Bind(*batch.instanced, 0);
+      GLStateCache::Instance().BindBuffer(GL_DRAW_INDIRECT_BUFFER, m_IndirectBuffer.GetID());
+      MultiDrawElementsIndirect(packet.mesh->GetMode()                                         ,
+                                packet.mesh->GetIndexType()                                    ,
+                                m_Commands.data() + batch.firstCommand                         ,
+                                static_cast<int>(batch.commandCount)                           ,
+                                batch.firstCommand * sizeof(DrawElementsIndirectCommand)       );
+      ++m_Statistics.instancedDraws;
+      m_Statistics.instances        += batch.count;
+      m_Statistics.indirectCommands += batch.commandCount;
+      continue;
+    }
+
+    if (batch.instanced)
+    {
+      m_InstanceBuffer.Bind(*batch.instanced, batch.firstInstance);
+      packet.mesh->Draw(static_cast<int>(batch.count));
+      ++m_Statistics.instancedDraws;
+      m_Statistics.instances += batch.count;
+      continue;
+    }
+
+    if (modelLocation < 0)
+    {
+      modelLocation = static_cast<int>(shader.GetUniformLocation("model"));
+    }
+    shader.SetUniformMatrix4fv(modelLocation, glm::value_ptr(packet.model));
+    packet.mesh->Draw();
+  }
+
+#if PROFILE
+  endPass();
+#endif
+
+  if (transparent)
+  {
+    CALL(glDepthMask(GL_TRUE));
+    CALL(glDisable(GL_BLEND));
+  }
+}
+
+void RenderQueue::Dispose()
+{
+  m_Packets.clear();
+  m_Entries.clear();
+  m_Scratch.clear();
+  m_Batches.clear();
+  m_MaterialIndices.clear();
+  m_MeshIndices.clear();
+  m_InstancedArrays.clear();
+  m_InstanceBuffer.Dispose();
+  m_Commands.clear();
+  m_IndirectBuffer.Dispose();
+  m_CommandBuffers.clear();
+}
+
+std::uint64_t RenderQueue::EncodeKey(const Packet& packet, std::uint32_t materialIndex, std::uint32_t meshIndex) const
+{
+  std::uint64_t program     = packet.material->GetShader().Program() & RenderQueue::idMask;
+  std::uint64_t material    = materialIndex & RenderQueue::idMask;
+  std::uint64_t vertexArray = packet.mesh->GetVertexArray().GetID() & RenderQueue::idMask;
+
+  float distance = glm::length(glm::vec3{ packet.model[3] } - m_ViewPosition) / m_FarPlane;
+  std::uint64_t depth = static_cast<std::uint64_t>(std::clamp(distance, 0.0f, 1.0f) * RenderQueue::depthMask);
+
+  if (packet.material->IsTransparent())
+  {
+    return 1ull << 63 |
+           (RenderQueue::depthMask - depth) << 39 |
+           program << 27 |
+           material << 15 |
+           vertexArray << 3;
+  }
+
+  // meshes of one vertex array stay grouped so instanced and indirect runs are not split by depth
+  std::uint64_t mesh = meshIndex & RenderQueue::meshMask;
+  return program << 51 |
+         material << 39 |
+         vertexArray << 27 |
+         mesh << 17 |
+         (depth >> (RenderQueue::depthBits - RenderQueue::opaqueDepthBits)) << 3;
+}
+
+std::uint32_t RenderQueue::MaterialIndex(const Material& material)
+{
+  auto it = m_MaterialIndices.find(&material);
+  if (it == std::end(m_MaterialIndices))
+  {
+    it = m_MaterialIndices.emplace(&material, static_cast<std::uint32_t>(m_MaterialIndices.size())).first;
+  }
+  return it->second;
+}
+
+std::uint32_t RenderQueue::MeshIndex(const Mesh& mesh)
+{
+  auto it = m_MeshIndices.find(&mesh);
+  if (it == std::end(m_MeshIndices))
+  {
+    it = m_MeshIndices.emplace(&mesh, static_cast<std::uint32_t>(m_MeshIndices.size())).first;
+  }
+  return it->second;
+}
+
+std::uint32_t RenderQueue::FindMaterialIndex(const Material& material) const
+{
+  auto it = m_MaterialIndices.find(&material);
+  return it != std::end(m_MaterialIndices) ? it->second : static_cast<std::uint32_t>(RenderQueue::idMask);
+}
+
+std::uint32_t RenderQueue::FindMeshIndex(const Mesh& mesh) const
+{
+  auto it = m_MeshIndices.find(&mesh);
+  return it != std::end(m_MeshIndices) ? it->second : static_cast<std::uint32_t>(RenderQueue::meshMask);
+}
+
+void RenderQueue::BuildBatches()
+{
+  m_Batches.clear();
+  m_Commands.clear();
+  m_InstanceBuffer.Clear();
+
+  bool multiDrawIndirect = m_MultiDrawIndirect && IsMultiDrawIndirectAvailable();
+
+  std::uint32_t first = 0;
+  while (first < m_Entries.size())
+  {
+    const Packet& packet = m_Packets[m_Entries[first].index];
+    const Mesh& mesh = *packet.mesh;
+
+    Batch batch{};
+    batch.first = first;
+    batch.count = 1;
+
+    auto it = m_InstancedArrays.find(mesh.GetVertexArray().GetID());
+    if (packet.material->IsInstanced() && it == std::end(m_InstancedArrays))
+    {
+      // the shader would read its per instance data from attributes nothing is bound to
+      throw std::exception{ "[ERROR::RENDERER] Instanced material drawn on a vertex array not passed to EnableInstancing" };
+    }
+
+    if (packet.material->IsInstanced())
+    {
+      bool indirect = multiDrawIndirect && mesh.GetIndexType();
+
+      batch.count         = 0;
+      batch.instanced     = it->second;
+      batch.firstInstance = static_cast<std::uint32_t>(m_InstanceBuffer.GetSize());
+      batch.firstCommand  = static_cast<std::uint32_t>(m_Commands.size());
+
+      const Mesh* run = nullptr;
+      while (first + batch.count < m_Entries.size())
+      {
+        const Packet& next = m_Packets[m_Entries[first + batch.count].index];
+        if (next.material != packet.material)
+        {
+          break;
+        }
+
+        if (next.mesh != &mesh &&
+            (!indirect                                                                 ||
+             next.mesh->GetVertexArray().GetID() != mesh.GetVertexArray().GetID()      ||
+             next.mesh->GetIndexType() != mesh.GetIndexType()                          ||
+             next.mesh->GetMode() != mesh.GetMode()))
+        {
+          break;
+        }
+
+        std::uint32_t instance = m_InstanceBuffer.Append(next.model, next.materialIndex);
+        if (indirect)
+        {
+          if (next.mesh != run)
+          {
+            DrawElementsIndirectCommand command{};
+            command.count        = static_cast<std::uint32_t>(next.mesh->GetCount());
+            command.firstIndex   = next.mesh->GetFirstIndex();
+            command.baseVertex   = next.mesh->GetBaseVertex();
+            command.baseInstance = instance;
+            m_Commands.push_back(command);
+            ++batch.commandCount;
+            run = next.mesh;
+          }
+          ++m_Commands.back().instanceCount;
+        }
+
+        ++batch.count;
+      }
+    }
+
+    m_Batches.push_back(batch);
+    first += batch.count;
+  }
+}
@@ -0,0 +1,173 @@
+#pragma once
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <functional>
+#include <unordered_map>
+
+#include <glm/glm.hpp>
+
+#include "Core/Draw.h"
+#include "Core/Shader.h"
+#include "Core/Buffer.h"
+#include "Renderer/Mesh.h"
+#include "Renderer/Material.h"
+#include "Renderer/InstanceBuffer.h"
+#include "Renderer/CommandBuffer.h"
+
+#include "Jobs/JobSystem.h"
+
+#include "Profiling/Profiler.h"
+
+// per frame draw packets sorted by 64-bit keys before execution:
+//   opaque      : [63] 0 | [62:51] program | [50:39] material | [38:27] vertex array | [26:17] mesh | [16:3] depth (front to back)
+//   transparent : [63] 1 | [62:39] inverted depth (back to front) | [38:27] program | [26:15] material | [14:3] vertex array
+// consecutive packets of one mesh with an instanced material are merged into a single instanced draw,
+// with multi-draw indirect consecutive instanced runs of meshes sharing a vertex array (MeshPool) become one call
+class RenderQueue {
+public:
+  struct Statistics {
+    std::size_t packets                   = 0;
+    std::size_t draws                     = 0;
+    std::size_t instancedDraws            = 0;
+    std::size_t instances                 = 0;
+    std::size_t indirectCommands          = 0;
+    std::size_t programSwitches           = 0;
+    std::size_t materialSwitches          = 0;
+    std::size_t meshSwitches              = 0;
+    // switches the same packets would have caused in submission order
+    std::size_t unsortedProgramSwitches   = 0;
+    std::size_t unsortedMaterialSwitches  = 0;
+    std::size_t unsortedMeshSwitches      = 0;
+  };
+
+  // invoked once per program switch with the program bound, sets the per frame uniforms (view, projection, lights)
+  using ProgramCallback = std::function<void(Shader&)>;
+
+  // vertex arrays drawn with instanced materials have to be registered once, the instance attributes are attached to them,
+  // Execute throws on an instanced material drawn on any other vertex array
+  void EnableInstancing(VertexArray& vertexArray);
+
+  // falls back to one instanced draw per mesh run when disabled or unavailable
+  inline void SetMultiDrawIndirectEnabled(bool enabled)
+  {
+    m_MultiDrawIndirect = enabled;
+  }
+
+  // meshes and materials recorded from command buffers have to be registered up front, recording threads
+  // only look the sort ids up, unregistered ones share the last id and batch worse
+  void Register(const Material& material);
+  void Register(const Mesh& mesh);
+
+  void Begin(const glm::vec3& viewPosition, float farPlane);
+  void Submit(const Mesh& mesh, const Material& material, const glm::mat4& model, std::uint32_t materialIndex = 0);
+
+  // appends the packets of a command buffer recorded since Begin, merging in a fixed order keeps the sort deterministic
+  void Merge(const CommandBuffer& buffer);
+
+  // record(buffer, begin, end) over [0, count) on the job system, one command buffer per chunk merged in chunk order,
+  // record must only submit into the buffer it is given
+  template <typename Function>
+  void Record(std::size_t count, const Function& record)
+  {
+    PROFILE_SCOPE("RenderQueue::Record");
+    JobSystem& jobs = JobSystem::Instance();
+    const std::size_t chunks = std::clamp<std::size_t>(count / RenderQueue::recordGrain, 1, jobs.GetWorkerCount() * RenderQueue::recordChunksPerWorker);
+    const std::size_t chunkSize = (count + chunks - 1) / chunks;
+    if (m_CommandBuffers.size() < chunks)
+    {
+      m_CommandBuffers.resize(chunks);
+    }
+
+    if (chunks == 1)
+    {
+      m_CommandBuffers.front().Begin(*this);
+      record(m_CommandBuffers.front(), std::size_t{ 0 }, count);
+      Merge(m_CommandBuffers.front());
+      return;
+    }
+
+    JobCounter counter{};
+    for (std::size_t chunk = 0; chunk < chunks; ++chunk)
+    {
+      CommandBuffer* buffer = &m_CommandBuffers[chunk];
+      std::size_t begin = std::min(chunk * chunkSize, count);
+      std::size_t end = std::min(begin + chunkSize, count);
+      buffer->Begin(*this);
+      jobs.Run([&record, buffer, begin, end]() { record(*buffer, begin, end); }, &counter);
+    }
+    jobs.Wait(counter);
+
+    for (std::size_t chunk = 0; chunk < chunks; ++chunk)
+    {
+      Merge(m_CommandBuffers[chunk]);
+    }
+  }
+
+  void Sort();
+  void Execute(const ProgramCallback& onProgram);
+
+  inline std::size_t GetSize() const
+  {
+    return m_Packets.size();
+  }
+
+  inline const Statistics& GetStatistics() const
+  {
+    return m_Statistics;
+  }
+
+  void Dispose();
+
+private:
+  friend class CommandBuffer;
+
+  using Packet = CommandBuffer::Packet;
+  using SortEntry = CommandBuffer::SortEntry;
+
+  struct Batch {
+    std::uint32_t first         = 0;
+    std::uint32_t count         = 0;
+    std::uint32_t firstInstance = 0;
+    std::uint32_t firstCommand  = 0;
+    std::uint32_t commandCount  = 0;
+    VertexArray* instanced      = nullptr;
+  };
+
+  std::uint64_t EncodeKey(const Packet& packet, std::uint32_t materialIndex, std::uint32_t meshIndex) const;
+  std::uint32_t MaterialIndex(const Material& material);
+  std::uint32_t MeshIndex(const Mesh& mesh);
+  std::uint32_t FindMaterialIndex(const Material& material) const;
+  std::uint32_t FindMeshIndex(const Mesh& mesh) const;
+  void BuildBatches();
+
+  static constexpr std::uint64_t idBits    = 12;
+  static constexpr std::uint64_t idMask    = (1ull << idBits) - 1;
+  static constexpr std::uint64_t depthBits = 24;
+  static constexpr std::uint64_t depthMask = (1ull << depthBits) - 1;
+  static constexpr std::uint64_t meshBits  = 10;
+  static constexpr std::uint64_t meshMask  = (1ull << meshBits) - 1;
+  static constexpr std::uint64_t opaqueDepthBits = 14;
+  static constexpr std::size_t recordGrain           = 1024;
+  static constexpr std::size_t recordChunksPerWorker = 2;
+
+  glm::vec3 m_ViewPosition{};
+  float m_FarPlane = 1.0f;
+
+  std::vector<Packet> m_Packets{};
+  std::vector<SortEntry> m_Entries{};
+  std::vector<SortEntry> m_Scratch{};
+  std::vector<Batch> m_Batches{};
+  std::unordered_map<const Material*, std::uint32_t> m_MaterialIndices{};
+  std::unordered_map<const Mesh*, std::uint32_t> m_MeshIndices{};
+  std::unordered_map<unsigned int, VertexArray*> m_InstancedArrays{};
+  InstanceBuffer m_InstanceBuffer{};
+  std::vector<DrawElementsIndirectCommand> m_Commands{};
+  Buffer<DrawElementsIndirectCommand> m_IndirectBuffer{};
+  std::vector<CommandBuffer> m_CommandBuffers{};
+  bool m_MultiDrawIndirect = true;
+
+  Statistics m_Statistics{};
+};
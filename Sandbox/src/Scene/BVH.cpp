@@ -0,0 +1,617 @@
+#include "BVH.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "Profiling/Profiler.h"
+
+void BVH::Build(const AABB* bounds, const std::uint32_t* objects, std::size_t count, Handle* handles)
+{
+  Clear();
+  if (count == 0)
+  {
+    return;
+  }
+
+  std::vector<BuildItem> items(count);
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    items[i].bounds   = bounds[i];
+    items[i].centroid = (bounds[i].min + bounds[i].max) * 0.5f;
+    items[i].index    = static_cast<std::uint32_t>(i);
+  }
+
+  m_Nodes.reserve(2 * count - 1);
+  m_Root = BuildRange(items.data(), count, objects, handles);
+  m_Nodes[m_Root].parent = BVH::nullHandle;
+}
+
+BVH::Handle BVH::Insert(const AABB& bounds, std::uint32_t object)
+{
+  Handle leaf = AllocateNode();
+  m_Nodes[leaf].bounds = bounds;
+  m_Nodes[leaf].object = object;
+
+  InsertLeaf(leaf);
+  ++m_LeafCount;
+  return leaf;
+}
+
+void BVH::Remove(Handle handle)
+{
+  RemoveLeaf(handle);
+  FreeNode(handle);
+  --m_LeafCount;
+}
+
+void BVH::Update(Handle handle, const AABB& bounds)
+{
+  Handle parent = m_Nodes[handle].parent;
+  if (parent == BVH::nullHandle || Contains(m_Nodes[parent].bounds, bounds))
+  {
+    // still inside the parent, every ancestor stays valid
+    m_Nodes[handle].bounds = bounds;
+    return;
+  }
+
+  RemoveLeaf(handle);
+  m_Nodes[handle].bounds = bounds;
+  InsertLeaf(handle);
+}
+
+void BVH::SetBounds(Handle handle, const AABB& bounds)
+{
+  m_Nodes[handle].bounds = bounds;
+}
+
+void BVH::Refit()
+{
+  if (m_Root == BVH::nullHandle)
+  {
+    return;
+  }
+
+  // pre-order walk, visited backwards every child comes before its parent
+  std::vector<Handle> order{};
+  order.reserve(m_Nodes.size());
+  order.push_back(m_Root);
+  for (std::size_t i = 0; i < order.size(); ++i)
+  {
+    const Node& node = m_Nodes[order[i]];
+    if (!node.IsLeaf())
+    {
+      order.push_back(node.left);
+      order.push_back(node.right);
+    }
+  }
+
+  for (auto it = order.rbegin(); it != order.rend(); ++it)
+  {
+    Node& node = m_Nodes[*it];
+    if (!node.IsLeaf())
+    {
+      node.bounds = Union(m_Nodes[node.left].bounds, m_Nodes[node.right].bounds);
+    }
+  }
+}
+
+void BVH::Query(const Frustum& frustum, std::vector<std::uint32_t>& objects) const
+{
+  PROFILE_SCOPE("BVH::Query");
+  if (m_Root == BVH::nullHandle)
+  {
+    return;
+  }
+
+  // the mask holds the planes the node still straddles, children of a node inside a plane skip it
+  constexpr std::uint32_t allPlanes = (1u << 6) - 1;
+  const auto& planes = frustum.GetPlanes();
+
+  std::vector<std::pair<Handle, std::uint32_t>> stack{};
+  stack.reserve(64);
+  stack.emplace_back(m_Root, allPlanes);
+  while (!stack.empty())
+  {
+    auto [index, mask] = stack.back();
+    stack.pop_back();
+
+    const Node& node = m_Nodes[index];
+    if (mask)
+    {
+      glm::vec3 center = (node.bounds.min + node.bounds.max) * 0.5f;
+      glm::vec3 extent = (node.bounds.max - node.bounds.min) * 0.5f;
+
+      bool outside = false;
+      for (std::uint32_t plane = 0; plane < planes.size(); ++plane)
+      {
+        if (!(mask & (1u << plane)))
+        {
+          continue;
+        }
+
+        float distance = glm::dot(planes[plane].normal, center) + planes[plane].distance;
+        float radius   = glm::dot(glm::abs(planes[plane].normal), extent);
+        if (distance + radius < 0.0f)
+        {
+          outside = true;
+          break;
+        }
+        if (distance - radius >= 0.0f)
+        {
+          mask &= ~(1u << plane);
+        }
+      }
+
+      if (outside)
+      {
+        continue;
+      }
+    }
+
+    if (node.IsLeaf())
+    {
+      objects.push_back(node.object);
+      continue;
+    }
+
+    stack.emplace_back(node.right, mask);
+    stack.emplace_back(node.left, mask);
+  }
+}
+
+bool BVH::Raycast(const Ray& ray, float maxDistance, RayHit& hit) const
+{
+  if (m_Root == BVH::nullHandle)
+  {
+    return false;
+  }
+
+  const glm::vec3 inverseDirection = 1.0f / ray.direction;
+
+  float distance = 0.0f;
+  if (!IntersectRay(ray.origin, inverseDirection, m_Nodes[m_Root].bounds, maxDistance, distance))
+  {
+    return false;
+  }
+
+  bool found = false;
+  float closest = maxDistance;
+
+  std::vector<std::pair<Handle, float>> stack{};
+  stack.reserve(64);
+  stack.emplace_back(m_Root, distance);
+  while (!stack.empty())
+  {
+    auto [index, entry] = stack.back();
+    stack.pop_back();
+
+    // a closer hit was found since this node was pushed
+    if (entry > closest)
+    {
+      continue;
+    }
+
+    const Node& node = m_Nodes[index];
+    if (node.IsLeaf())
+    {
+      if (!found || entry < closest)
+      {
+        found        = true;
+        closest      = entry;
+        hit.handle   = index;
+        hit.object   = node.object;
+        hit.distance = entry;
+      }
+      continue;
+    }
+
+    float leftEntry  = 0.0f;
+    float rightEntry = 0.0f;
+    bool leftHit  = IntersectRay(ray.origin, inverseDirection, m_Nodes[node.left].bounds, closest, leftEntry);
+    bool rightHit = IntersectRay(ray.origin, inverseDirection, m_Nodes[node.right].bounds, closest, rightEntry);
+
+    // nearer child goes on top so it is visited first and tightens closest early
+    if (leftHit && rightHit)
+    {
+      if (leftEntry < rightEntry)
+      {
+        stack.emplace_back(node.right, rightEntry);
+        stack.emplace_back(node.left, leftEntry);
+      }
+      else
+      {
+        stack.emplace_back(node.left, leftEntry);
+        stack.emplace_back(node.right, rightEntry);
+      }
+    }
+    else if (leftHit)
+    {
+      stack.emplace_back(node.left, leftEntry);
+    }
+    else if (rightHit)
+    {
+      stack.emplace_back(node.right, rightEntry);
+    }
+  }
+
+  return found;
+}
+
+const AABB& BVH::GetBounds(Handle handle) const
+{
+  return m_Nodes[handle].bounds;
+}
+
+std::uint32_t BVH::GetObject(Handle handle) const
+{
+  return m_Nodes[handle].object;
+}
+
+BVH::Statistics BVH::GetStatistics() const
+{
+  Statistics statistics{};
+  if (m_Root == BVH::nullHandle)
+  {
+    return statistics;
+  }
+
+  float internalArea = 0.0f;
+  std::vector<std::pair<Handle, std::size_t>> stack{};
+  stack.emplace_back(m_Root, 1);
+  while (!stack.empty())
+  {
+    auto [index, depth] = stack.back();
+    stack.pop_back();
+
+    const Node& node = m_Nodes[index];
+    ++statistics.nodes;
+    statistics.maxDepth = std::max(statistics.maxDepth, depth);
+    if (node.IsLeaf())
+    {
+      ++statistics.leaves;
+      continue;
+    }
+
+    internalArea += SurfaceArea(node.bounds);
+    stack.emplace_back(node.left, depth + 1);
+    stack.emplace_back(node.right, depth + 1);
+  }
+
+  float rootArea = SurfaceArea(m_Nodes[m_Root].bounds);
+  statistics.sahCost = rootArea > 0.0f ? internalArea / rootArea : 0.0f;
+  return statistics;
+}
+
+void BVH::Clear()
+{
+  m_Nodes.clear();
+  m_Root      = BVH::nullHandle;
+  m_FreeList  = BVH::nullHandle;
+  m_LeafCount = 0;
+}
+
+BVH::Handle BVH::AllocateNode()
+{
+  if (m_FreeList != BVH::nullHandle)
+  {
+    Handle node = m_FreeList;
+    m_FreeList = m_Nodes[node].parent;
+    m_Nodes[node] = Node{};
+    return node;
+  }
+
+  m_Nodes.emplace_back();
+  return static_cast<Handle>(m_Nodes.size() - 1);
+}
+
+void BVH::FreeNode(Handle node)
+{
+  m_Nodes[node] = Node{};
+  m_Nodes[node].parent = m_FreeList;
+  m_FreeList = node;
+}
+
+BVH::Handle BVH::BuildRange(BuildItem* items, std::size_t count, const std::uint32_t* objects, Handle* handles)
+{
+  Handle node = AllocateNode();
+  if (count == 1)
+  {
+    m_Nodes[node].bounds = items[0].bounds;
+    m_Nodes[node].object = objects[items[0].index];
+    handles[items[0].index] = node;
+    ++m_LeafCount;
+    return node;
+  }
+
+  AABB bounds = items[0].bounds;
+  AABB centroids{ items[0].centroid, items[0].centroid };
+  for (std::size_t i = 1; i < count; ++i)
+  {
+    bounds      = Union(bounds, items[i].bounds);
+    centroids   = Union(centroids, AABB{ items[i].centroid, items[i].centroid });
+  }
+
+  glm::vec3 extent = centroids.max - centroids.min;
+  int axis = 0;
+  if (extent.y > extent[axis]) axis = 1;
+  if (extent.z > extent[axis]) axis = 2;
+
+  std::size_t split = 0;
+  if (extent[axis] > 0.0f)
+  {
+    struct Bin {
+      AABB bounds{};
+      std::size_t count = 0;
+    };
+
+    const float scale = BVH::buildBins / extent[axis];
+    auto binOf = [&](const BuildItem& item) -> int
+    {
+      return std::min(static_cast<int>((item.centroid[axis] - centroids.min[axis]) * scale), BVH::buildBins - 1);
+    };
+
+    Bin bins[BVH::buildBins]{};
+    for (std::size_t i = 0; i < count; ++i)
+    {
+      Bin& bin = bins[binOf(items[i])];
+      bin.bounds = bin.count ? Union(bin.bounds, items[i].bounds) : items[i].bounds;
+      ++bin.count;
+    }
+
+    // cost of everything right of each split plane, swept from the right
+    float rightCost[BVH::buildBins - 1]{};
+    { AABB accumulated{};
+      std::size_t accumulatedCount = 0;
+      for (int i = BVH::buildBins - 1; i > 0; --i)
+      {
+        if (bins[i].count)
+        {
+          accumulated = accumulatedCount ? Union(accumulated, bins[i].bounds) : bins[i].bounds;
+          accumulatedCount += bins[i].count;
+        }
+        rightCost[i - 1] = accumulatedCount ? SurfaceArea(accumulated) * accumulatedCount : 0.0f;
+      }
+    }
+
+    int bestBin = -1;
+    float bestCost = 0.0f;
+    { AABB accumulated{};
+      std::size_t accumulatedCount = 0;
+      for (int i = 0; i < BVH::buildBins - 1; ++i)
+      {
+        if (bins[i].count)
+        {
+          accumulated = accumulatedCount ? Union(accumulated, bins[i].bounds) : bins[i].bounds;
+          accumulatedCount += bins[i].count;
+        }
+        if (accumulatedCount == 0 || accumulatedCount == count)
+        {
+          continue;
+        }
+
+        float cost = SurfaceArea(accumulated) * accumulatedCount + rightCost[i];
+        if (bestBin < 0 || cost < bestCost)
+        {
+          bestBin  = i;
+          bestCost = cost;
+        }
+      }
+    }
+
+    if (bestBin >= 0)
+    {
+      BuildItem* middle = std::partition(items, items + count, [&](const BuildItem& item) -> bool { return binOf(item) <= bestBin; });
+      split = static_cast<std::size_t>(middle - items);
+    }
+  }
+
+  // all centroids in one bin, fall back to a median split
+  if (split == 0 || split == count)
+  {
+    split = count / 2;
+    std::nth_element(
+      items,
+      items + split,
+      items + count,
+      [axis](const BuildItem& lhs, const BuildItem& rhs) -> bool
+      {
+        return lhs.centroid[axis] < rhs.centroid[axis];
+      }
+    );
+  }
+
+  Handle left  = BuildRange(items, split, objects, handles);
+  Handle right = BuildRange(items + split, count - split, objects, handles);
+
+  m_Nodes[node].bounds = bounds;
+  m_Nodes[node].left   = left;
+  m_Nodes[node].right  = right;
+  m_Nodes[left].parent  = node;
+  m_Nodes[right].parent = node;
+  return node;
+}
+
+void BVH::InsertLeaf(Handle leaf)
+{
+  if (m_Root == BVH::nullHandle)
+  {
+    m_Root = leaf;
+    m_Nodes[leaf].parent = BVH::nullHandle;
+    return;
+  }
+
+  // descend towards the sibling that grows the total surface area the least
+  const AABB bounds = m_Nodes[leaf].bounds;
+  Handle sibling = m_Root;
+  while (!m_Nodes[sibling].IsLeaf())
+  {
+    const Node& node = m_Nodes[sibling];
+
+    float area        = SurfaceArea(node.bounds);
+    float combined    = SurfaceArea(Union(node.bounds, bounds));
+    float cost        = 2.0f * combined;
+    float inheritance = 2.0f * (combined - area);
+
+    auto descendCost = [&](Handle child) -> float
+    {
+      const Node& childNode = m_Nodes[child];
+      float childCost = SurfaceArea(Union(childNode.bounds, bounds)) + inheritance;
+      return childNode.IsLeaf() ? childCost : childCost - SurfaceArea(childNode.bounds);
+    };
+
+    float leftCost  = descendCost(node.left);
+    float rightCost = descendCost(node.right);
+    if (cost < leftCost && cost < rightCost)
+    {
+      break;
+    }
+
+    sibling = leftCost < rightCost ? node.left : node.right;
+  }
+
+  Handle oldParent = m_Nodes[sibling].parent;
+  Handle newParent = AllocateNode();
+  m_Nodes[newParent].parent = oldParent;
+  m_Nodes[newParent].bounds = Union(bounds, m_Nodes[sibling].bounds);
+  m_Nodes[newParent].left   = sibling;
+  m_Nodes[newParent].right  = leaf;
+  m_Nodes[sibling].parent   = newParent;
+  m_Nodes[leaf].parent      = newParent;
+
+  if (oldParent == BVH::nullHandle)
+  {
+    m_Root = newParent;
+  }
+  else if (m_Nodes[oldParent].left == sibling)
+  {
+    m_Nodes[oldParent].left = newParent;
+  }
+  else
+  {
+    m_Nodes[oldParent].right = newParent;
+  }
+
+  RefitAncestors(oldParent);
+}
+
+void BVH::RemoveLeaf(Handle leaf)
+{
+  if (leaf == m_Root)
+  {
+    m_Root = BVH::nullHandle;
+    return;
+  }
+
+  Handle parent      = m_Nodes[leaf].parent;
+  Handle grandParent = m_Nodes[parent].parent;
+  Handle sibling     = m_Nodes[parent].left == leaf ? m_Nodes[parent].right : m_Nodes[parent].left;
+
+  m_Nodes[sibling].parent = grandParent;
+  m_Nodes[leaf].parent    = BVH::nullHandle;
+  FreeNode(parent);
+
+  if (grandParent == BVH::nullHandle)
+  {
+    m_Root = sibling;
+    return;
+  }
+
+  if (m_Nodes[grandParent].left == parent)
+  {
+    m_Nodes[grandParent].left = sibling;
+  }
+  else
+  {
+    m_Nodes[grandParent].right = sibling;
+  }
+
+  RefitAncestors(grandParent);
+}
+
+void BVH::RefitAncestors(Handle node)
+{
+  while (node != BVH::nullHandle)
+  {
+    Node& current = m_Nodes[node];
+    current.bounds = Union(m_Nodes[current.left].bounds, m_Nodes[current.right].bounds);
+    Rotate(node);
+    node = current.parent;
+  }
+}
+
+void BVH::Rotate(Handle node)
+{
+  // swaps a child with one of its sibling's children when that shrinks the sibling,
+  // the node's own bounds cover the same leaves either way
+  Node& current = m_Nodes[node];
+
+  Handle child      = BVH::nullHandle;
+  Handle sibling    = BVH::nullHandle;
+  Handle grandChild = BVH::nullHandle;
+  AABB rotated{};
+  float bestGain = 0.0f;
+
+  auto consider = [&](Handle candidate, Handle candidateSibling)
+  {
+    const Node& siblingNode = m_Nodes[candidateSibling];
+    if (siblingNode.IsLeaf())
+    {
+      return;
+    }
+
+    const AABB& bounds = m_Nodes[candidate].bounds;
+    float area = SurfaceArea(siblingNode.bounds);
+
+    // candidate takes the place of siblingNode.left, then of siblingNode.right
+    AABB keepRight = Union(bounds, m_Nodes[siblingNode.right].bounds);
+    float gain = area - SurfaceArea(keepRight);
+    if (gain > bestGain)
+    {
+      bestGain   = gain;
+      child      = candidate;
+      sibling    = candidateSibling;
+      grandChild = siblingNode.left;
+      rotated    = keepRight;
+    }
+
+    AABB keepLeft = Union(bounds, m_Nodes[siblingNode.left].bounds);
+    gain = area - SurfaceArea(keepLeft);
+    if (gain > bestGain)
+    {
+      bestGain   = gain;
+      child      = candidate;
+      sibling    = candidateSibling;
+      grandChild = siblingNode.right;
+      rotated    = keepLeft;
+    }
+  };
+
+  consider(current.left, current.right);
+  consider(current.right, current.left);
+  if (child == BVH::nullHandle)
+  {
+    return;
+  }
+
+  Node& siblingNode = m_Nodes[sibling];
+  if (siblingNode.left == grandChild)
+  {
+    siblingNode.left = child;
+  }
+  else
+  {
+    siblingNode.right = child;
+  }
+  siblingNode.bounds = rotated;
+  m_Nodes[child].parent = sibling;
+
+  if (current.left == child)
+  {
+    current.left = grandChild;
+  }
+  else
+  {
+    current.right = grandChild;
+  }
+  m_Nodes[grandChild].parent = node;
+}
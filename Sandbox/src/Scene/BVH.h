@@ -0,0 +1,100 @@
+#pragma once
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+#include "Scene/Bounds.h"
+#include "Scene/Frustum.h"
+
+// dynamic bounding volume hierarchy over object bounds, one object per leaf
+// built top-down with a binned SAH, then kept up to date incrementally by insert / remove / refit,
+// refits rotate nodes to keep the surface area of moving objects' subtrees low
+class BVH {
+public:
+  using Handle = std::int32_t;
+  static constexpr Handle nullHandle = -1;
+
+  struct RayHit {
+    Handle handle         = nullHandle;
+    std::uint32_t object  = 0;
+    float distance        = 0.0f;
+  };
+
+  struct Statistics {
+    std::size_t nodes     = 0;
+    std::size_t leaves    = 0;
+    std::size_t maxDepth  = 0;
+    float sahCost         = 0.0f; // sum of internal node areas relative to the root, lower is better
+  };
+
+  BVH() = default;
+
+  // replaces the whole tree, handles[i] receives the leaf of bounds[i] / objects[i]
+  void Build(const AABB* bounds, const std::uint32_t* objects, std::size_t count, Handle* handles);
+
+  Handle Insert(const AABB& bounds, std::uint32_t object);
+  void Remove(Handle handle);
+
+  // moves a leaf and refits its ancestors, for the odd moving object
+  void Update(Handle handle, const AABB& bounds);
+
+  // only writes the leaf, call Refit once after moving many objects
+  void SetBounds(Handle handle, const AABB& bounds);
+  void Refit();
+
+  // appends the objects of every leaf intersecting the frustum, subtrees fully inside are not tested further
+  void Query(const Frustum& frustum, std::vector<std::uint32_t>& objects) const;
+
+  // closest leaf hit within maxDistance
+  bool Raycast(const Ray& ray, float maxDistance, RayHit& hit) const;
+
+  const AABB& GetBounds(Handle handle) const;
+  std::uint32_t GetObject(Handle handle) const;
+
+  inline std::size_t GetSize() const
+  {
+    return m_LeafCount;
+  }
+
+  Statistics GetStatistics() const;
+
+  void Clear();
+
+private:
+  struct Node {
+    AABB bounds{};
+    Handle parent         = nullHandle; // next free node while on the free list
+    Handle left           = nullHandle;
+    Handle right          = nullHandle;
+    std::uint32_t object  = 0;
+
+    inline bool IsLeaf() const
+    {
+      return left == nullHandle;
+    }
+  };
+
+  struct BuildItem {
+    AABB bounds{};
+    glm::vec3 centroid{ 0.0f };
+    std::uint32_t index = 0;
+  };
+
+  Handle AllocateNode();
+  void FreeNode(Handle node);
+
+  Handle BuildRange(BuildItem* items, std::size_t count, const std::uint32_t* objects, Handle* handles);
+
+  void InsertLeaf(Handle leaf);
+  void RemoveLeaf(Handle leaf);
+  void RefitAncestors(Handle node);
+  void Rotate(Handle node);
+
+  static constexpr int buildBins = 16;
+
+  std::vector<Node> m_Nodes{};
+  Handle m_Root         = nullHandle;
+  Handle m_FreeList     = nullHandle;
+  std::size_t m_LeafCount = 0;
+};
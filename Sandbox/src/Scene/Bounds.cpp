@@ -0,0 +1,119 @@
+#include "Bounds.h"
+
+#include <algorithm>
+
+AABB Union(const AABB& lhs, const AABB& rhs)
+{
+  return AABB{ glm::min(lhs.min, rhs.min), glm::max(lhs.max, rhs.max) };
+}
+
+bool Contains(const AABB& outer, const AABB& inner)
+{
+  return glm::all(glm::lessThanEqual(outer.min, inner.min)) && glm::all(glm::greaterThanEqual(outer.max, inner.max));
+}
+
+float SurfaceArea(const AABB& box)
+{
+  glm::vec3 size = box.max - box.min;
+  return 2.0f * (size.x * size.y + size.y * size.z + size.z * size.x);
+}
+
+bool IntersectRay(const glm::vec3& origin, const glm::vec3& inverseDirection, const AABB& box, float maxDistance, float& distance)
+{
+  glm::vec3 t0 = (box.min - origin) * inverseDirection;
+  glm::vec3 t1 = (box.max - origin) * inverseDirection;
+  glm::vec3 tMin = glm::min(t0, t1);
+  glm::vec3 tMax = glm::max(t0, t1);
+
+  float entry = std::max(std::max(tMin.x, tMin.y), std::max(tMin.z, 0.0f));
+  float exit  = std::min(std::min(tMax.x, tMax.y), std::min(tMax.z, maxDistance));
+  if (entry > exit)
+  {
+    return false;
+  }
+
+  distance = entry;
+  return true;
+}
+
+void AABBArray::Reserve(std::size_t count)
+{
+  centerX.reserve(count);
+  centerY.reserve(count);
+  centerZ.reserve(count);
+  extentX.reserve(count);
+  extentY.reserve(count);
+  extentZ.reserve(count);
+}
+
+void AABBArray::Add(const AABB& box)
+{
+  centerX.push_back(0.0f);
+  centerY.push_back(0.0f);
+  centerZ.push_back(0.0f);
+  extentX.push_back(0.0f);
+  extentY.push_back(0.0f);
+  extentZ.push_back(0.0f);
+  Set(Size() - 1, box);
+}
+
+void AABBArray::Set(std::size_t index, const AABB& box)
+{
+  glm::vec3 center = (box.min + box.max) * 0.5f;
+  glm::vec3 extent = (box.max - box.min) * 0.5f;
+  centerX[index] = center.x;
+  centerY[index] = center.y;
+  centerZ[index] = center.z;
+  extentX[index] = extent.x;
+  extentY[index] = extent.y;
+  extentZ[index] = extent.z;
+}
+
+AABB AABBArray::Get(std::size_t index) const
+{
+  glm::vec3 center{ centerX[index], centerY[index], centerZ[index] };
+  glm::vec3 extent{ extentX[index], extentY[index], extentZ[index] };
+  return AABB{ center - extent, center + extent };
+}
+
+void AABBArray::Clear()
+{
+  centerX.clear();
+  centerY.clear();
+  centerZ.clear();
+  extentX.clear();
+  extentY.clear();
+  extentZ.clear();
+}
+
+void SphereArray::Reserve(std::size_t count)
+{
+  centerX.reserve(count);
+  centerY.reserve(count);
+  centerZ.reserve(count);
+  radius.reserve(count);
+}
+
+void SphereArray::Add(const BoundingSphere& sphere)
+{
+  centerX.push_back(sphere.center.x);
+  centerY.push_back(sphere.center.y);
+  centerZ.push_back(sphere.center.z);
+  radius.push_back(sphere.radius);
+}
+
+void SphereArray::Set(std::size_t index, const BoundingSphere& sphere)
+{
+  centerX[index] = sphere.center.x;
+  centerY[index] = sphere.center.y;
+  centerZ[index] = sphere.center.z;
+  radius[index]  = sphere.radius;
+}
+
+void SphereArray::Clear()
+{
+  centerX.clear();
+  centerY.clear();
+  centerZ.clear();
+  radius.clear();
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <vector>
+#include <cstddef>
+
+#include <glm/glm.hpp>
+
+struct AABB {
+  glm::vec3 min{ 0.0f };
+  glm::vec3 max{ 0.0f };
+};
+
+struct BoundingSphere {
+  glm::vec3 center{ 0.0f };
+  float radius = 0.0f;
+};
+
+struct Ray {
+  glm::vec3 origin{ 0.0f };
+  glm::vec3 direction{ 0.0f, 0.0f, -1.0f };
+};
+
+AABB Union(const AABB& lhs, const AABB& rhs);
+bool Contains(const AABB& outer, const AABB& inner);
+float SurfaceArea(const AABB& box);
+
+// slab test, inverseDirection is 1 / ray.direction, distance is the entry distance along the ray (0 when the origin is inside)
+bool IntersectRay(const glm::vec3& origin, const glm::vec3& inverseDirection, const AABB& box, float maxDistance, float& distance);
+
+// structure of arrays layout consumed by the SIMD culling kernels, boxes are stored as center and half extent
+struct AABBArray {
+  std::vector<float> centerX{};
+  std::vector<float> centerY{};
+  std::vector<float> centerZ{};
+  std::vector<float> extentX{};
+  std::vector<float> extentY{};
+  std::vector<float> extentZ{};
+
+  inline std::size_t Size() const
+  {
+    return centerX.size();
+  }
+
+  void Reserve(std::size_t count);
+  void Add(const AABB& box);
+  void Set(std::size_t index, const AABB& box);
+  AABB Get(std::size_t index) const;
+  void Clear();
+};
+
+struct SphereArray {
+  std::vector<float> centerX{};
+  std::vector<float> centerY{};
+  std::vector<float> centerZ{};
+  std::vector<float> radius{};
+
+  inline std::size_t Size() const
+  {
+    return centerX.size();
+  }
+
+  void Reserve(std::size_t count);
+  void Add(const BoundingSphere& sphere);
+  void Set(std::size_t index, const BoundingSphere& sphere);
+  void Clear();
+};
@@ -0,0 +1,58 @@
+#include "Frustum.h"
+
+#include <cmath>
+
+Frustum Frustum::FromMatrix(const glm::mat4& viewProjection)
+{
+  // glm is column major, row i is (m[0][i], m[1][i], m[2][i], m[3][i])
+  auto row = [&](int i) -> glm::vec4
+  {
+    return glm::vec4{ viewProjection[0][i], viewProjection[1][i], viewProjection[2][i], viewProjection[3][i] };
+  };
+
+  const glm::vec4 planes[6]{
+    row(3) + row(0),
+    row(3) - row(0),
+    row(3) + row(1),
+    row(3) - row(1),
+    row(3) + row(2),
+    row(3) - row(2),
+  };
+
+  Frustum frustum{};
+  for (std::size_t i = 0; i < 6; ++i)
+  {
+    float length = glm::length(glm::vec3{ planes[i] });
+    frustum.m_Planes[i].normal   = glm::vec3{ planes[i] } / length;
+    frustum.m_Planes[i].distance = planes[i].w / length;
+  }
+  return frustum;
+}
+
+bool Frustum::Intersects(const AABB& box) const
+{
+  glm::vec3 center = (box.min + box.max) * 0.5f;
+  glm::vec3 extent = (box.max - box.min) * 0.5f;
+  for (const Plane& plane : m_Planes)
+  {
+    float distance = glm::dot(plane.normal, center) + plane.distance;
+    float radius   = glm::dot(glm::abs(plane.normal), extent);
+    if (distance + radius < 0.0f)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool Frustum::Intersects(const BoundingSphere& sphere) const
+{
+  for (const Plane& plane : m_Planes)
+  {
+    if (glm::dot(plane.normal, sphere.center) + plane.distance < -sphere.radius)
+    {
+      return false;
+    }
+  }
+  return true;
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+#include <glm/glm.hpp>
+
+#include "Scene/Bounds.h"
+
+// dot(normal, p) + distance >= 0 inside
+struct Plane {
+  glm::vec3 normal{ 0.0f };
+  float distance = 0.0f;
+};
+
+class Frustum {
+public:
+  enum class Side
+    : std::int32_t
+  {
+    LEFT,
+    RIGHT,
+    BOTTOM,
+    TOP,
+    NEAR_PLANE,
+    FAR_PLANE,
+    COUNT
+  };
+
+  Frustum() = default;
+
+  // Gribb/Hartmann extraction from a GL clip space matrix, planes come out normalized
+  static Frustum FromMatrix(const glm::mat4& viewProjection);
+
+  bool Intersects(const AABB& box) const;
+  bool Intersects(const BoundingSphere& sphere) const;
+
+  inline const Plane& GetPlane(Side side) const
+  {
+    return m_Planes[static_cast<std::size_t>(side)];
+  }
+
+  inline const std::array<Plane, 6>& GetPlanes() const
+  {
+    return m_Planes;
+  }
+
+private:
+  std::array<Plane, 6> m_Planes{};
+};
@@ -0,0 +1,209 @@
+#include "FrustumCuller.h"
+
+#include <cmath>
+#include <algorithm>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+#define FRUSTUM_CULLER_SSE
+#include <emmintrin.h>
+#endif
+
+#include "Jobs/JobSystem.h"
+
+#include "Utility/CpuFeatures/CpuFeatures.h"
+
+namespace {
+  void CullAABBsScalar(const Frustum& frustum, const AABBArray& boxes, std::size_t begin, std::size_t end, std::uint8_t* visible)
+  {
+    const auto& planes = frustum.GetPlanes();
+    for (std::size_t i = begin; i < end; ++i)
+    {
+      std::uint8_t inside = 1;
+      for (const Plane& plane : planes)
+      {
+        float distance = plane.normal.x * boxes.centerX[i] + plane.normal.y * boxes.centerY[i] + plane.normal.z * boxes.centerZ[i] + plane.distance;
+        float radius   = std::fabs(plane.normal.x) * boxes.extentX[i] + std::fabs(plane.normal.y) * boxes.extentY[i] + std::fabs(plane.normal.z) * boxes.extentZ[i];
+        inside &= static_cast<std::uint8_t>(distance + radius >= 0.0f);
+      }
+      visible[i] = inside;
+    }
+  }
+
+  void CullSpheresScalar(const Frustum& frustum, const SphereArray& spheres, std::size_t begin, std::size_t end, std::uint8_t* visible)
+  {
+    const auto& planes = frustum.GetPlanes();
+    for (std::size_t i = begin; i < end; ++i)
+    {
+      std::uint8_t inside = 1;
+      for (const Plane& plane : planes)
+      {
+        float distance = plane.normal.x * spheres.centerX[i] + plane.normal.y * spheres.centerY[i] + plane.normal.z * spheres.centerZ[i] + plane.distance;
+        inside &= static_cast<std::uint8_t>(distance >= -spheres.radius[i]);
+      }
+      visible[i] = inside;
+    }
+  }
+
+#ifdef FRUSTUM_CULLER_SSE
+  void CullAABBsSSE(const Frustum& frustum, const AABBArray& boxes, std::size_t begin, std::size_t end, std::uint8_t* visible)
+  {
+    const auto& planes = frustum.GetPlanes();
+    const __m128 signMask = _mm_set1_ps(-0.0f);
+
+    std::size_t i = begin;
+    for (; i + 4 <= end; i += 4)
+    {
+      __m128 cx = _mm_loadu_ps(&boxes.centerX[i]);
+      __m128 cy = _mm_loadu_ps(&boxes.centerY[i]);
+      __m128 cz = _mm_loadu_ps(&boxes.centerZ[i]);
+      __m128 ex = _mm_loadu_ps(&boxes.extentX[i]);
+      __m128 ey = _mm_loadu_ps(&boxes.extentY[i]);
+      __m128 ez = _mm_loadu_ps(&boxes.extentZ[i]);
+
+      __m128 outside = _mm_setzero_ps();
+      for (const Plane& plane : planes)
+      {
+        __m128 nx = _mm_set1_ps(plane.normal.x);
+        __m128 ny = _mm_set1_ps(plane.normal.y);
+        __m128 nz = _mm_set1_ps(plane.normal.z);
+
+        __m128 distance = _mm_add_ps(_mm_add_ps(_mm_mul_ps(nx, cx), _mm_mul_ps(ny, cy)), _mm_add_ps(_mm_mul_ps(nz, cz), _mm_set1_ps(plane.distance)));
+        __m128 radius   = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_andnot_ps(signMask, nx), ex), _mm_mul_ps(_mm_andnot_ps(signMask, ny), ey)), _mm_mul_ps(_mm_andnot_ps(signMask, nz), ez));
+        outside = _mm_or_ps(outside, _mm_cmplt_ps(_mm_add_ps(distance, radius), _mm_setzero_ps()));
+      }
+
+      int mask = _mm_movemask_ps(outside);
+      for (int lane = 0; lane < 4; ++lane)
+      {
+        visible[i + lane] = static_cast<std::uint8_t>(((mask >> lane) & 1) ^ 1);
+      }
+    }
+
+    CullAABBsScalar(frustum, boxes, i, end, visible);
+  }
+
+  void CullSpheresSSE(const Frustum& frustum, const SphereArray& spheres, std::size_t begin, std::size_t end, std::uint8_t* visible)
+  {
+    const auto& planes = frustum.GetPlanes();
+
+    std::size_t i = begin;
+    for (; i + 4 <= end; i += 4)
+    {
+      __m128 cx = _mm_loadu_ps(&spheres.centerX[i]);
+      __m128 cy = _mm_loadu_ps(&spheres.centerY[i]);
+      __m128 cz = _mm_loadu_ps(&spheres.centerZ[i]);
+      __m128 r  = _mm_loadu_ps(&spheres.radius[i]);
+      __m128 negativeRadius = _mm_sub_ps(_mm_setzero_ps(), r);
+
+      __m128 outside = _mm_setzero_ps();
+      for (const Plane& plane : planes)
+      {
+        __m128 distance = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(plane.normal.x), cx), _mm_mul_ps(_mm_set1_ps(plane.normal.y), cy)),
+                                     _mm_add_ps(_mm_mul_ps(_mm_set1_ps(plane.normal.z), cz), _mm_set1_ps(plane.distance)));
+        outside = _mm_or_ps(outside, _mm_cmplt_ps(distance, negativeRadius));
+      }
+
+      int mask = _mm_movemask_ps(outside);
+      for (int lane = 0; lane < 4; ++lane)
+      {
+        visible[i + lane] = static_cast<std::uint8_t>(((mask >> lane) & 1) ^ 1);
+      }
+    }
+
+    CullSpheresScalar(frustum, spheres, i, end, visible);
+  }
+#endif
+
+  CullKernel Resolve(CullKernel kernel)
+  {
+    if (kernel == CullKernel::AUTO)
+    {
+      return GetBestCullKernel();
+    }
+
+    // requested kernels the machine or build cannot run fall back to the best available one
+    if (kernel == CullKernel::AVX2 && !HasAVX2())
+    {
+      return GetBestCullKernel();
+    }
+#ifndef FRUSTUM_CULLER_SSE
+    if (kernel == CullKernel::SSE)
+    {
+      return CullKernel::SCALAR;
+    }
+#endif
+    return kernel;
+  }
+}
+
+CullKernel GetBestCullKernel()
+{
+  if (HasAVX2())
+  {
+    return CullKernel::AVX2;
+  }
+#ifdef FRUSTUM_CULLER_SSE
+  return CullKernel::SSE;
+#else
+  return CullKernel::SCALAR;
+#endif
+}
+
+void CullAABBs(const Frustum& frustum, const AABBArray& boxes, std::size_t begin, std::size_t end, std::uint8_t* visible, CullKernel kernel)
+{
+  switch (Resolve(kernel))
+  {
+  case CullKernel::AVX2:
+    Detail::CullAABBsAVX2(frustum, boxes, begin, end, visible);
+    break;
+#ifdef FRUSTUM_CULLER_SSE
+  case CullKernel::SSE:
+    CullAABBsSSE(frustum, boxes, begin, end, visible);
+    break;
+#endif
+  default:
+    CullAABBsScalar(frustum, boxes, begin, end, visible);
+    break;
+  }
+}
+
+void CullSpheres(const Frustum& frustum, const SphereArray& spheres, std::size_t begin, std::size_t end, std::uint8_t* visible, CullKernel kernel)
+{
+  switch (Resolve(kernel))
+  {
+  case CullKernel::AVX2:
+    Detail::CullSpheresAVX2(frustum, spheres, begin, end, visible);
+    break;
+#ifdef FRUSTUM_CULLER_SSE
+  case CullKernel::SSE:
+    CullSpheresSSE(frustum, spheres, begin, end, visible);
+    break;
+#endif
+  default:
+    CullSpheresScalar(frustum, spheres, begin, end, visible);
+    break;
+  }
+}
+
+void CullAABBsParallel(const Frustum& frustum, const AABBArray& boxes, std::uint8_t* visible, CullKernel kernel)
+{
+  // ranges are rounded to 8 boxes, the AVX2 kernel only falls back to scalar at the very end
+  constexpr std::size_t grainSize = 16 * 1024;
+  const std::size_t groups = (boxes.Size() + 7) / 8;
+  JobSystem::Instance().ParallelFor(groups, grainSize / 8, [&](std::size_t begin, std::size_t end)
+  {
+    CullAABBs(frustum, boxes, begin * 8, std::min(end * 8, boxes.Size()), visible, kernel);
+  });
+}
+
+std::size_t CompactVisible(const std::uint8_t* visible, std::size_t begin, std::size_t end, std::uint32_t* indices)
+{
+  std::size_t count = 0;
+  for (std::size_t i = begin; i < end; ++i)
+  {
+    // branchless, the slot is always written and only kept when visible
+    indices[count] = static_cast<std::uint32_t>(i);
+    count += visible[i];
+  }
+  return count;
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "Scene/Bounds.h"
+#include "Scene/Frustum.h"
+
+enum class CullKernel
+  : std::int32_t
+{
+  AUTO,
+  SCALAR,
+  SSE,
+  AVX2
+};
+
+// kernels work on [begin, end) and only write visible[begin, end), disjoint ranges can be culled concurrently
+void CullAABBs(const Frustum& frustum, const AABBArray& boxes, std::size_t begin, std::size_t end, std::uint8_t* visible, CullKernel kernel = CullKernel::AUTO);
+void CullSpheres(const Frustum& frustum, const SphereArray& spheres, std::size_t begin, std::size_t end, std::uint8_t* visible, CullKernel kernel = CullKernel::AUTO);
+
+// splits the whole array over the job system, every worker culls its own range
+void CullAABBsParallel(const Frustum& frustum, const AABBArray& boxes, std::uint8_t* visible, CullKernel kernel = CullKernel::AUTO);
+
+// writes the indices of visible entries in [begin, end) and returns their count
+std::size_t CompactVisible(const std::uint8_t* visible, std::size_t begin, std::size_t end, std::uint32_t* indices);
+
+// the kernel AUTO resolves to on this machine
+CullKernel GetBestCullKernel();
+
+namespace Detail {
+  // 8 wide kernels, compiled for AVX2 in their own translation unit and only called when the CPU supports it
+  void CullAABBsAVX2(const Frustum& frustum, const AABBArray& boxes, std::size_t begin, std::size_t end, std::uint8_t* visible);
+  void CullSpheresAVX2(const Frustum& frustum, const SphereArray& spheres, std::size_t begin, std::size_t end, std::uint8_t* visible);
+}
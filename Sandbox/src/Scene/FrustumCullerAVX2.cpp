@@ -0,0 +1,84 @@
+#include "FrustumCuller.h"
+
+// MSVC accepts AVX2 intrinsics without /arch:AVX2, GCC and clang need the target enabled for this file only
+#if defined(__GNUC__) && !defined(__AVX2__)
+#pragma GCC target("avx2")
+#endif
+
+#include <immintrin.h>
+
+namespace Detail {
+  void CullAABBsAVX2(const Frustum& frustum, const AABBArray& boxes, std::size_t begin, std::size_t end, std::uint8_t* visible)
+  {
+    const auto& planes = frustum.GetPlanes();
+    const __m256 signMask = _mm256_set1_ps(-0.0f);
+
+    std::size_t i = begin;
+    for (; i + 8 <= end; i += 8)
+    {
+      __m256 cx = _mm256_loadu_ps(&boxes.centerX[i]);
+      __m256 cy = _mm256_loadu_ps(&boxes.centerY[i]);
+      __m256 cz = _mm256_loadu_ps(&boxes.centerZ[i]);
+      __m256 ex = _mm256_loadu_ps(&boxes.extentX[i]);
+      __m256 ey = _mm256_loadu_ps(&boxes.extentY[i]);
+      __m256 ez = _mm256_loadu_ps(&boxes.extentZ[i]);
+
+      __m256 outside = _mm256_setzero_ps();
+      for (const Plane& plane : planes)
+      {
+        __m256 nx = _mm256_set1_ps(plane.normal.x);
+        __m256 ny = _mm256_set1_ps(plane.normal.y);
+        __m256 nz = _mm256_set1_ps(plane.normal.z);
+
+        __m256 distance = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(nx, cx), _mm256_mul_ps(ny, cy)), _mm256_add_ps(_mm256_mul_ps(nz, cz), _mm256_set1_ps(plane.distance)));
+        __m256 radius   = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(_mm256_andnot_ps(signMask, nx), ex), _mm256_mul_ps(_mm256_andnot_ps(signMask, ny), ey)), _mm256_mul_ps(_mm256_andnot_ps(signMask, nz), ez));
+        outside = _mm256_or_ps(outside, _mm256_cmp_ps(_mm256_add_ps(distance, radius), _mm256_setzero_ps(), _CMP_LT_OQ));
+      }
+
+      int mask = _mm256_movemask_ps(outside);
+      for (int lane = 0; lane < 8; ++lane)
+      {
+        visible[i + lane] = static_cast<std::uint8_t>(((mask >> lane) & 1) ^ 1);
+      }
+    }
+
+    if (i < end)
+    {
+      CullAABBs(frustum, boxes, i, end, visible, CullKernel::SCALAR);
+    }
+  }
+
+  void CullSpheresAVX2(const Frustum& frustum, const SphereArray& spheres, std::size_t begin, std::size_t end, std::uint8_t* visible)
+  {
+    const auto& planes = frustum.GetPlanes();
+
+    std::size_t i = begin;
+    for (; i + 8 <= end; i += 8)
+    {
+      __m256 cx = _mm256_loadu_ps(&spheres.centerX[i]);
+      __m256 cy = _mm256_loadu_ps(&spheres.centerY[i]);
+      __m256 cz = _mm256_loadu_ps(&spheres.centerZ[i]);
+      __m256 r  = _mm256_loadu_ps(&spheres.radius[i]);
+      __m256 negativeRadius = _mm256_sub_ps(_mm256_setzero_ps(), r);
+
+      __m256 outside = _mm256_setzero_ps();
+      for (const Plane& plane : planes)
+      {
+        __m256 distance = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(plane.normal.x), cx), _mm256_mul_ps(_mm256_set1_ps(plane.normal.y), cy)),
+                                        _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(plane.normal.z), cz), _mm256_set1_ps(plane.distance)));
+        outside = _mm256_or_ps(outside, _mm256_cmp_ps(distance, negativeRadius, _CMP_LT_OQ));
+      }
+
+      int mask = _mm256_movemask_ps(outside);
+      for (int lane = 0; lane < 8; ++lane)
+      {
+        visible[i + lane] = static_cast<std::uint8_t>(((mask >> lane) & 1) ^ 1);
+      }
+    }
+
+    if (i < end)
+    {
+      CullSpheres(frustum, spheres, i, end, visible, CullKernel::SCALAR);
+    }
+  }
+}
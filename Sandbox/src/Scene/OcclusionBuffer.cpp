@@ -0,0 +1,317 @@
+#include "OcclusionBuffer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <exception>
+
+#include "Profiling/Profiler.h"
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+#define OCCLUSION_BUFFER_SSE
+#include <emmintrin.h>
+#endif
+
+namespace {
+  // corners of an AABB as 12 triangles, both windings are rasterized so the order does not matter
+  constexpr std::uint32_t boxIndices[36]{
+    0, 1, 2,  2, 1, 3,
+    4, 6, 5,  5, 6, 7,
+    0, 2, 4,  4, 2, 6,
+    1, 5, 3,  3, 5, 7,
+    0, 4, 1,  1, 4, 5,
+    2, 3, 6,  6, 3, 7,
+  };
+
+  void GetCorners(const AABB& box, glm::vec3* corners)
+  {
+    for (int i = 0; i < 8; ++i)
+    {
+      corners[i] = glm::vec3{
+        (i & 1) ? box.max.x : box.min.x,
+        (i & 2) ? box.max.y : box.min.y,
+        (i & 4) ? box.max.z : box.min.z,
+      };
+    }
+  }
+}
+
+OcclusionBuffer::OcclusionBuffer() :
+  OcclusionBuffer(OcclusionBuffer::defaultWidth, OcclusionBuffer::defaultHeight)
+{
+}
+
+OcclusionBuffer::OcclusionBuffer(int width, int height) :
+  m_Width { width  },
+  m_Height{ height }
+{
+  if (width <= 0 || height <= 0 || width % 4 != 0)
+  {
+    throw std::exception{ "[ERROR::OCCLUSION] Buffer width must be a positive multiple of 4" };
+  }
+
+  // every level halves rounding up, down to a single texel
+  int levelWidth  = width;
+  int levelHeight = height;
+  while (true)
+  {
+    Level level{};
+    level.width  = levelWidth;
+    level.height = levelHeight;
+    level.depth.assign(static_cast<std::size_t>(levelWidth) * levelHeight, 1.0f);
+    m_Levels.push_back(std::move(level));
+
+    if (levelWidth == 1 && levelHeight == 1)
+    {
+      break;
+    }
+    levelWidth  = std::max(1, (levelWidth + 1) / 2);
+    levelHeight = std::max(1, (levelHeight + 1) / 2);
+  }
+}
+
+void OcclusionBuffer::Begin(const glm::mat4& viewProjection)
+{
+  m_ViewProjection = viewProjection;
+  m_OccluderTriangles = 0;
+  std::fill(std::begin(m_Levels[0].depth), std::end(m_Levels[0].depth), 1.0f);
+}
+
+void OcclusionBuffer::AddOccluder(const glm::vec3* positions, const std::uint32_t* indices, std::size_t indexCount, const glm::mat4& model)
+{
+  const glm::mat4 modelViewProjection = m_ViewProjection * model;
+  for (std::size_t i = 0; i + 2 < indexCount; i += 3)
+  {
+    RasterizeTriangle(modelViewProjection * glm::vec4{ positions[indices[i + 0]], 1.0f },
+                      modelViewProjection * glm::vec4{ positions[indices[i + 1]], 1.0f },
+                      modelViewProjection * glm::vec4{ positions[indices[i + 2]], 1.0f });
+  }
+}
+
+void OcclusionBuffer::AddOccluder(const AABB& box)
+{
+  glm::vec3 corners[8]{};
+  GetCorners(box, corners);
+  AddOccluder(corners, boxIndices, 36, glm::mat4{ 1.0f });
+}
+
+void OcclusionBuffer::End()
+{
+  PROFILE_SCOPE("OcclusionBuffer::End");
+  for (std::size_t index = 1; index < m_Levels.size(); ++index)
+  {
+    const Level& source = m_Levels[index - 1];
+    Level& target = m_Levels[index];
+    for (int y = 0; y < target.height; ++y)
+    {
+      int y0 = std::min(y * 2, source.height - 1);
+      int y1 = std::min(y * 2 + 1, source.height - 1);
+      for (int x = 0; x < target.width; ++x)
+      {
+        int x0 = std::min(x * 2, source.width - 1);
+        int x1 = std::min(x * 2 + 1, source.width - 1);
+        target.depth[static_cast<std::size_t>(y) * target.width + x] = std::max(
+          std::max(source.depth[static_cast<std::size_t>(y0) * source.width + x0], source.depth[static_cast<std::size_t>(y0) * source.width + x1]),
+          std::max(source.depth[static_cast<std::size_t>(y1) * source.width + x0], source.depth[static_cast<std::size_t>(y1) * source.width + x1]));
+      }
+    }
+  }
+}
+
+bool OcclusionBuffer::IsVisible(const AABB& box) const
+{
+  glm::vec3 corners[8]{};
+  GetCorners(box, corners);
+
+  glm::vec2 screenMin{ static_cast<float>(m_Width), static_cast<float>(m_Height) };
+  glm::vec2 screenMax{ 0.0f };
+  float nearestDepth = 1.0f;
+  for (const glm::vec3& corner : corners)
+  {
+    glm::vec4 clip = m_ViewProjection * glm::vec4{ corner, 1.0f };
+    if (clip.w <= OcclusionBuffer::nearClipEpsilon)
+    {
+      return true;
+    }
+
+    glm::vec3 screen = ToScreen(clip);
+    screenMin    = glm::min(screenMin, glm::vec2{ screen });
+    screenMax    = glm::max(screenMax, glm::vec2{ screen });
+    nearestDepth = std::min(nearestDepth, screen.z);
+  }
+
+  int x0 = std::max(0, static_cast<int>(std::floor(screenMin.x)));
+  int y0 = std::max(0, static_cast<int>(std::floor(screenMin.y)));
+  int x1 = std::min(m_Width - 1, static_cast<int>(std::floor(screenMax.x)));
+  int y1 = std::min(m_Height - 1, static_cast<int>(std::floor(screenMax.y)));
+  if (x0 > x1 || y0 > y1)
+  {
+    // off screen, that is the frustum culler's call
+    return true;
+  }
+
+  // coarsest level that still covers the rectangle with at most maxTestTexels per axis
+  int levelIndex = 0;
+  while (levelIndex + 1 < static_cast<int>(m_Levels.size()) &&
+         ((x1 >> levelIndex) - (x0 >> levelIndex) >= OcclusionBuffer::maxTestTexels ||
+          (y1 >> levelIndex) - (y0 >> levelIndex) >= OcclusionBuffer::maxTestTexels))
+  {
+    ++levelIndex;
+  }
+
+  const Level& level = m_Levels[levelIndex];
+  for (int y = y0 >> levelIndex; y <= (y1 >> levelIndex); ++y)
+  {
+    for (int x = x0 >> levelIndex; x <= (x1 >> levelIndex); ++x)
+    {
+      if (nearestDepth <= level.depth[static_cast<std::size_t>(y) * level.width + x])
+      {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+const std::vector<float>& OcclusionBuffer::GetDepth(int level) const
+{
+  return m_Levels.at(level).depth;
+}
+
+int OcclusionBuffer::GetLevelCount() const
+{
+  return static_cast<int>(m_Levels.size());
+}
+
+void OcclusionBuffer::RasterizeTriangle(const glm::vec4& clip0, const glm::vec4& clip1, const glm::vec4& clip2)
+{
+  // clip against the near plane (z >= -w), walls the camera stands next to are the best occluders
+  const glm::vec4 input[3]{ clip0, clip1, clip2 };
+  glm::vec4 clipped[4]{};
+  int count = 0;
+  for (int i = 0; i < 3; ++i)
+  {
+    const glm::vec4& current = input[i];
+    const glm::vec4& next    = input[(i + 1) % 3];
+    float currentDistance = current.z + current.w;
+    float nextDistance    = next.z + next.w;
+
+    if (currentDistance >= 0.0f)
+    {
+      clipped[count++] = current;
+    }
+    if ((currentDistance >= 0.0f) != (nextDistance >= 0.0f))
+    {
+      clipped[count++] = glm::mix(current, next, currentDistance / (currentDistance - nextDistance));
+    }
+  }
+
+  for (int i = 2; i < count; ++i)
+  {
+    if (clipped[0].w > OcclusionBuffer::nearClipEpsilon && clipped[i - 1].w > OcclusionBuffer::nearClipEpsilon && clipped[i].w > OcclusionBuffer::nearClipEpsilon)
+    {
+      RasterizeScreenTriangle(ToScreen(clipped[0]), ToScreen(clipped[i - 1]), ToScreen(clipped[i]));
+    }
+  }
+}
+
+void OcclusionBuffer::RasterizeScreenTriangle(glm::vec3 v0, glm::vec3 v1, glm::vec3 v2)
+{
+  float area = (v1.x - v0.x) * (v2.y - v0.y) - (v1.y - v0.y) * (v2.x - v0.x);
+  if (std::fabs(area) < 1.0e-8f)
+  {
+    return;
+  }
+  if (area < 0.0f)
+  {
+    std::swap(v1, v2);
+    area = -area;
+  }
+
+  int minX = std::max(0, static_cast<int>(std::floor(std::min({ v0.x, v1.x, v2.x }))));
+  int minY = std::max(0, static_cast<int>(std::floor(std::min({ v0.y, v1.y, v2.y }))));
+  int maxX = std::min(m_Width - 1, static_cast<int>(std::ceil(std::max({ v0.x, v1.x, v2.x }))));
+  int maxY = std::min(m_Height - 1, static_cast<int>(std::ceil(std::max({ v0.y, v1.y, v2.y }))));
+  if (minX > maxX || minY > maxY)
+  {
+    return;
+  }
+  minX &= ~3;
+
+  ++m_OccluderTriangles;
+
+  // edge functions a * x + b * y + c, positive inside, each one is zero on the edge opposite a vertex
+  auto edge = [](const glm::vec3& from, const glm::vec3& to) -> glm::vec3
+  {
+    float a = from.y - to.y;
+    float b = to.x - from.x;
+    return glm::vec3{ a, b, -(a * from.x + b * from.y) };
+  };
+
+  const glm::vec3 e0 = edge(v1, v2);
+  const glm::vec3 e1 = edge(v2, v0);
+  const glm::vec3 e2 = edge(v0, v1);
+
+  // depth is affine in screen space, z = dot(barycentrics, vertex depths)
+  const glm::vec3 z = (e0 * v0.z + e1 * v1.z + e2 * v2.z) / area;
+
+  std::vector<float>& depth = m_Levels[0].depth;
+
+#ifdef OCCLUSION_BUFFER_SSE
+  const __m128 laneOffsets = _mm_set_ps(3.5f, 2.5f, 1.5f, 0.5f);
+  const __m128 zero = _mm_setzero_ps();
+  for (int y = minY; y <= maxY; ++y)
+  {
+    const float py = y + 0.5f;
+    const __m128 row0 = _mm_set1_ps(e0.y * py + e0.z);
+    const __m128 row1 = _mm_set1_ps(e1.y * py + e1.z);
+    const __m128 row2 = _mm_set1_ps(e2.y * py + e2.z);
+    const __m128 rowZ = _mm_set1_ps(z.y * py + z.z);
+
+    float* line = &depth[static_cast<std::size_t>(y) * m_Width];
+    for (int x = minX; x <= maxX; x += 4)
+    {
+      __m128 px = _mm_add_ps(_mm_set1_ps(static_cast<float>(x)), laneOffsets);
+
+      __m128 w0 = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(e0.x), px), row0);
+      __m128 w1 = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(e1.x), px), row1);
+      __m128 w2 = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(e2.x), px), row2);
+      __m128 inside = _mm_and_ps(_mm_and_ps(_mm_cmpge_ps(w0, zero), _mm_cmpge_ps(w1, zero)), _mm_cmpge_ps(w2, zero));
+      if (!_mm_movemask_ps(inside))
+      {
+        continue;
+      }
+
+      __m128 pixelDepth = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(z.x), px), rowZ);
+      __m128 current = _mm_loadu_ps(line + x);
+      __m128 nearest = _mm_min_ps(current, pixelDepth);
+      _mm_storeu_ps(line + x, _mm_or_ps(_mm_and_ps(inside, nearest), _mm_andnot_ps(inside, current)));
+    }
+  }
+#else
+  for (int y = minY; y <= maxY; ++y)
+  {
+    const float py = y + 0.5f;
+    float* line = &depth[static_cast<std::size_t>(y) * m_Width];
+    for (int x = minX; x <= maxX; ++x)
+    {
+      const float px = x + 0.5f;
+      if (e0.x * px + e0.y * py + e0.z >= 0.0f &&
+          e1.x * px + e1.y * py + e1.z >= 0.0f &&
+          e2.x * px + e2.y * py + e2.z >= 0.0f)
+      {
+        line[x] = std::min(line[x], z.x * px + z.y * py + z.z);
+      }
+    }
+  }
+#endif
+}
+
+glm::vec3 OcclusionBuffer::ToScreen(const glm::vec4& clip) const
+{
+  glm::vec3 ndc = glm::vec3{ clip } / clip.w;
+  return glm::vec3{
+    (ndc.x * 0.5f + 0.5f) * m_Width,
+    (ndc.y * 0.5f + 0.5f) * m_Height,
+    ndc.z * 0.5f + 0.5f,
+  };
+}
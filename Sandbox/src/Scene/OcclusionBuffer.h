@@ -0,0 +1,71 @@
+#pragma once
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+#include <glm/glm.hpp>
+
+#include "Scene/Bounds.h"
+
+// low resolution CPU depth buffer for occlusion culling, occluders are rasterized once per frame,
+// reduced into a max depth pyramid and object bounds are tested against it before submission
+class OcclusionBuffer {
+public:
+  OcclusionBuffer();
+  // width must be a multiple of 4, the rasterizer writes 4 pixels at a time
+  OcclusionBuffer(int width, int height);
+
+  // resets depth to the far plane, viewProjection is used for every following occluder and test
+  void Begin(const glm::mat4& viewProjection);
+
+  void AddOccluder(const glm::vec3* positions, const std::uint32_t* indices, std::size_t indexCount, const glm::mat4& model);
+  void AddOccluder(const AABB& box);
+
+  // builds the depth pyramid, required before IsVisible
+  void End();
+
+  // conservative, anything crossing the near plane or straddling uncovered pixels is visible
+  bool IsVisible(const AABB& box) const;
+
+  inline int GetWidth() const
+  {
+    return m_Width;
+  }
+
+  inline int GetHeight() const
+  {
+    return m_Height;
+  }
+
+  inline std::size_t GetOccluderTriangleCount() const
+  {
+    return m_OccluderTriangles;
+  }
+
+  // level 0 is the full resolution depth, values are [0, 1] window depth
+  const std::vector<float>& GetDepth(int level = 0) const;
+  int GetLevelCount() const;
+
+private:
+  struct Level {
+    int width  = 0;
+    int height = 0;
+    std::vector<float> depth{};
+  };
+
+  void RasterizeTriangle(const glm::vec4& clip0, const glm::vec4& clip1, const glm::vec4& clip2);
+  void RasterizeScreenTriangle(glm::vec3 v0, glm::vec3 v1, glm::vec3 v2);
+  glm::vec3 ToScreen(const glm::vec4& clip) const;
+
+  static constexpr int   defaultWidth     = 256;
+  static constexpr int   defaultHeight    = 128;
+  static constexpr float nearClipEpsilon  = 1.0e-4f;
+  static constexpr int   maxTestTexels    = 4; // per axis, picks the pyramid level for each test
+
+  int m_Width  = 0;
+  int m_Height = 0;
+  glm::mat4 m_ViewProjection{ 1.0f };
+  std::vector<Level> m_Levels{};
+  std::size_t m_OccluderTriangles = 0;
+};
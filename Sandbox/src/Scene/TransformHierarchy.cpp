@@ -0,0 +1,376 @@
+#include "TransformHierarchy.h"
+
+#include <algorithm>
+#include <numeric>
+
+#include "Jobs/JobSystem.h"
+
+#include "Profiling/Profiler.h"
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+#define TRANSFORM_HIERARCHY_SSE
+#include <xmmintrin.h>
+#endif
+
+namespace {
+  template <typename T>
+  void Permute(std::vector<T>& values, const std::vector<std::uint32_t>& order)
+  {
+    std::vector<T> sorted(values.size());
+    for (std::size_t i = 0; i < order.size(); ++i)
+    {
+      sorted[i] = values[order[i]];
+    }
+    values.swap(sorted);
+  }
+
+  inline void ComposeLocal(float px, float py, float pz, float qx, float qy, float qz, float qw, float sx, float sy, float sz, glm::mat4& local)
+  {
+    float xx = qx * qx, yy = qy * qy, zz = qz * qz;
+    float xy = qx * qy, xz = qx * qz, yz = qy * qz;
+    float wx = qw * qx, wy = qw * qy, wz = qw * qz;
+
+    local[0] = glm::vec4{ (1.0f - 2.0f * (yy + zz)) * sx, 2.0f * (xy + wz) * sx, 2.0f * (xz - wy) * sx, 0.0f };
+    local[1] = glm::vec4{ 2.0f * (xy - wz) * sy, (1.0f - 2.0f * (xx + zz)) * sy, 2.0f * (yz + wx) * sy, 0.0f };
+    local[2] = glm::vec4{ 2.0f * (xz + wy) * sz, 2.0f * (yz - wx) * sz, (1.0f - 2.0f * (xx + yy)) * sz, 0.0f };
+    local[3] = glm::vec4{ px, py, pz, 1.0f };
+  }
+}
+
+void TransformHierarchy::Reserve(std::size_t count)
+{
+  m_PositionX.reserve(count);
+  m_PositionY.reserve(count);
+  m_PositionZ.reserve(count);
+  m_RotationX.reserve(count);
+  m_RotationY.reserve(count);
+  m_RotationZ.reserve(count);
+  m_RotationW.reserve(count);
+  m_ScaleX.reserve(count);
+  m_ScaleY.reserve(count);
+  m_ScaleZ.reserve(count);
+  m_Parent.reserve(count);
+  m_Flags.reserve(count);
+  m_Local.reserve(count);
+  m_World.reserve(count);
+  m_HandleToIndex.reserve(count);
+  m_IndexToHandle.reserve(count);
+}
+
+TransformHierarchy::Handle TransformHierarchy::Create(Handle parent)
+{
+  // appending keeps parents first, the parent already has a lower index
+  std::uint32_t index = static_cast<std::uint32_t>(m_Parent.size());
+  Handle handle = static_cast<Handle>(m_HandleToIndex.size());
+
+  m_PositionX.push_back(0.0f);
+  m_PositionY.push_back(0.0f);
+  m_PositionZ.push_back(0.0f);
+  m_RotationX.push_back(0.0f);
+  m_RotationY.push_back(0.0f);
+  m_RotationZ.push_back(0.0f);
+  m_RotationW.push_back(1.0f);
+  m_ScaleX.push_back(1.0f);
+  m_ScaleY.push_back(1.0f);
+  m_ScaleZ.push_back(1.0f);
+  m_Parent.push_back(parent == TransformHierarchy::nullHandle ? TransformHierarchy::nullHandle : m_HandleToIndex[parent]);
+  m_Flags.push_back(TransformHierarchy::localDirty);
+  m_Local.emplace_back(1.0f);
+  m_World.emplace_back(1.0f);
+
+  m_HandleToIndex.push_back(index);
+  m_IndexToHandle.push_back(handle);
+  m_AnyDirty = true;
+  return handle;
+}
+
+void TransformHierarchy::SetParent(Handle node, Handle parent)
+{
+  std::uint32_t index = m_HandleToIndex[node];
+  std::uint32_t parentIndex = parent == TransformHierarchy::nullHandle ? TransformHierarchy::nullHandle : m_HandleToIndex[parent];
+
+  m_Parent[index] = parentIndex;
+  m_Flags[index] |= TransformHierarchy::worldDirty;
+  m_AnyDirty = true;
+  if (parentIndex != TransformHierarchy::nullHandle && parentIndex > index)
+  {
+    m_NeedsSort = true;
+  }
+}
+
+TransformHierarchy::Handle TransformHierarchy::GetParent(Handle node) const
+{
+  std::uint32_t parentIndex = m_Parent[m_HandleToIndex[node]];
+  return parentIndex == TransformHierarchy::nullHandle ? TransformHierarchy::nullHandle : m_IndexToHandle[parentIndex];
+}
+
+void TransformHierarchy::SetPosition(Handle node, const glm::vec3& position)
+{
+  std::uint32_t index = m_HandleToIndex[node];
+  m_PositionX[index] = position.x;
+  m_PositionY[index] = position.y;
+  m_PositionZ[index] = position.z;
+  m_Flags[index] |= TransformHierarchy::localDirty;
+  m_AnyDirty = true;
+}
+
+void TransformHierarchy::SetRotation(Handle node, const glm::quat& rotation)
+{
+  std::uint32_t index = m_HandleToIndex[node];
+  m_RotationX[index] = rotation.x;
+  m_RotationY[index] = rotation.y;
+  m_RotationZ[index] = rotation.z;
+  m_RotationW[index] = rotation.w;
+  m_Flags[index] |= TransformHierarchy::localDirty;
+  m_AnyDirty = true;
+}
+
+void TransformHierarchy::SetScale(Handle node, const glm::vec3& scale)
+{
+  std::uint32_t index = m_HandleToIndex[node];
+  m_ScaleX[index] = scale.x;
+  m_ScaleY[index] = scale.y;
+  m_ScaleZ[index] = scale.z;
+  m_Flags[index] |= TransformHierarchy::localDirty;
+  m_AnyDirty = true;
+}
+
+glm::vec3 TransformHierarchy::GetPosition(Handle node) const
+{
+  std::uint32_t index = m_HandleToIndex[node];
+  return glm::vec3{ m_PositionX[index], m_PositionY[index], m_PositionZ[index] };
+}
+
+glm::quat TransformHierarchy::GetRotation(Handle node) const
+{
+  std::uint32_t index = m_HandleToIndex[node];
+  return glm::quat{ m_RotationW[index], m_RotationX[index], m_RotationY[index], m_RotationZ[index] };
+}
+
+glm::vec3 TransformHierarchy::GetScale(Handle node) const
+{
+  std::uint32_t index = m_HandleToIndex[node];
+  return glm::vec3{ m_ScaleX[index], m_ScaleY[index], m_ScaleZ[index] };
+}
+
+void TransformHierarchy::Update()
+{
+  PROFILE_SCOPE("TransformHierarchy::Update");
+  if (m_NeedsSort)
+  {
+    Sort();
+    m_NeedsSort = false;
+  }
+
+  m_LocalList.clear();
+  m_WorldList.clear();
+  if (!m_AnyDirty)
+  {
+    return;
+  }
+  m_AnyDirty = false;
+
+  // parents come first, so a parent's world flag is final by the time its children read it
+  for (std::uint32_t i = 0; i < m_Flags.size(); ++i)
+  {
+    std::uint8_t flags = m_Flags[i];
+    std::uint32_t parent = m_Parent[i];
+    if (flags & TransformHierarchy::localDirty)
+    {
+      flags |= TransformHierarchy::worldDirty;
+      m_LocalList.push_back(i);
+    }
+    if (parent != TransformHierarchy::nullHandle && (m_Flags[parent] & TransformHierarchy::worldDirty))
+    {
+      flags |= TransformHierarchy::worldDirty;
+    }
+    if (flags & TransformHierarchy::worldDirty)
+    {
+      m_WorldList.push_back(i);
+    }
+    m_Flags[i] = flags;
+  }
+
+  // local matrices are independent, large batches go wide, world matrices depend on their parents and stay serial
+  JobSystem::Instance().ParallelFor(m_LocalList.size(), TransformHierarchy::parallelLocalGrain, [this](std::size_t begin, std::size_t end)
+  {
+    UpdateLocalMatrices(begin, end);
+  });
+  UpdateWorldMatrices();
+
+  for (std::uint32_t i : m_WorldList)
+  {
+    m_Flags[i] = 0;
+  }
+}
+
+const glm::mat4& TransformHierarchy::GetWorldMatrix(Handle node) const
+{
+  return m_World[m_HandleToIndex[node]];
+}
+
+void TransformHierarchy::Sort()
+{
+  // stable sort by depth, every parent is one level above its children
+  const std::size_t count = m_Parent.size();
+  std::vector<std::uint32_t> depth(count, 0);
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    for (std::uint32_t parent = m_Parent[i]; parent != TransformHierarchy::nullHandle; parent = m_Parent[parent])
+    {
+      ++depth[i];
+    }
+  }
+
+  std::vector<std::uint32_t> order(count);
+  std::iota(std::begin(order), std::end(order), 0);
+  std::stable_sort(
+    std::begin(order),
+    std::end(order),
+    [&](std::uint32_t lhs, std::uint32_t rhs) -> bool
+    {
+      return depth[lhs] < depth[rhs];
+    }
+  );
+
+  std::vector<std::uint32_t> newIndex(count);
+  for (std::uint32_t i = 0; i < count; ++i)
+  {
+    newIndex[order[i]] = i;
+  }
+
+  Permute(m_PositionX, order);
+  Permute(m_PositionY, order);
+  Permute(m_PositionZ, order);
+  Permute(m_RotationX, order);
+  Permute(m_RotationY, order);
+  Permute(m_RotationZ, order);
+  Permute(m_RotationW, order);
+  Permute(m_ScaleX, order);
+  Permute(m_ScaleY, order);
+  Permute(m_ScaleZ, order);
+  Permute(m_Parent, order);
+  Permute(m_Flags, order);
+  Permute(m_Local, order);
+  Permute(m_World, order);
+  Permute(m_IndexToHandle, order);
+
+  for (std::uint32_t& parent : m_Parent)
+  {
+    if (parent != TransformHierarchy::nullHandle)
+    {
+      parent = newIndex[parent];
+    }
+  }
+  for (std::uint32_t i = 0; i < count; ++i)
+  {
+    m_HandleToIndex[m_IndexToHandle[i]] = i;
+  }
+}
+
+void TransformHierarchy::UpdateLocalMatrices(std::size_t begin, std::size_t end)
+{
+  std::size_t i = begin;
+
+#ifdef TRANSFORM_HIERARCHY_SSE
+  // four nodes per iteration, lanes are gathered from the SoA arrays and the 4x4 results transposed into matrices
+  const __m128 one = _mm_set1_ps(1.0f);
+  const __m128 two = _mm_set1_ps(2.0f);
+  for (; i + 4 <= end; i += 4)
+  {
+    const std::uint32_t a = m_LocalList[i + 0];
+    const std::uint32_t b = m_LocalList[i + 1];
+    const std::uint32_t c = m_LocalList[i + 2];
+    const std::uint32_t d = m_LocalList[i + 3];
+
+    auto gather = [&](const std::vector<float>& values) -> __m128
+    {
+      return _mm_set_ps(values[d], values[c], values[b], values[a]);
+    };
+
+    __m128 qx = gather(m_RotationX), qy = gather(m_RotationY), qz = gather(m_RotationZ), qw = gather(m_RotationW);
+    __m128 sx = gather(m_ScaleX), sy = gather(m_ScaleY), sz = gather(m_ScaleZ);
+
+    __m128 xx = _mm_mul_ps(qx, qx), yy = _mm_mul_ps(qy, qy), zz = _mm_mul_ps(qz, qz);
+    __m128 xy = _mm_mul_ps(qx, qy), xz = _mm_mul_ps(qx, qz), yz = _mm_mul_ps(qy, qz);
+    __m128 wx = _mm_mul_ps(qw, qx), wy = _mm_mul_ps(qw, qy), wz = _mm_mul_ps(qw, qz);
+
+    __m128 c0x = _mm_mul_ps(_mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(yy, zz))), sx);
+    __m128 c0y = _mm_mul_ps(_mm_mul_ps(two, _mm_add_ps(xy, wz)), sx);
+    __m128 c0z = _mm_mul_ps(_mm_mul_ps(two, _mm_sub_ps(xz, wy)), sx);
+    __m128 c1x = _mm_mul_ps(_mm_mul_ps(two, _mm_sub_ps(xy, wz)), sy);
+    __m128 c1y = _mm_mul_ps(_mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(xx, zz))), sy);
+    __m128 c1z = _mm_mul_ps(_mm_mul_ps(two, _mm_add_ps(yz, wx)), sy);
+    __m128 c2x = _mm_mul_ps(_mm_mul_ps(two, _mm_add_ps(xz, wy)), sz);
+    __m128 c2y = _mm_mul_ps(_mm_mul_ps(two, _mm_sub_ps(yz, wx)), sz);
+    __m128 c2z = _mm_mul_ps(_mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(xx, yy))), sz);
+    __m128 c3x = gather(m_PositionX), c3y = gather(m_PositionY), c3z = gather(m_PositionZ);
+
+    __m128 c0w = _mm_setzero_ps(), c1w = _mm_setzero_ps(), c2w = _mm_setzero_ps(), c3w = one;
+    _MM_TRANSPOSE4_PS(c0x, c0y, c0z, c0w);
+    _MM_TRANSPOSE4_PS(c1x, c1y, c1z, c1w);
+    _MM_TRANSPOSE4_PS(c2x, c2y, c2z, c2w);
+    _MM_TRANSPOSE4_PS(c3x, c3y, c3z, c3w);
+
+    // after the transpose register n of each column group holds that column of lane n
+    const std::uint32_t lanes[4]{ a, b, c, d };
+    const __m128 columns[4][4]{
+      { c0x, c1x, c2x, c3x },
+      { c0y, c1y, c2y, c3y },
+      { c0z, c1z, c2z, c3z },
+      { c0w, c1w, c2w, c3w },
+    };
+    for (int lane = 0; lane < 4; ++lane)
+    {
+      float* local = &m_Local[lanes[lane]][0][0];
+      _mm_storeu_ps(local + 0,  columns[lane][0]);
+      _mm_storeu_ps(local + 4,  columns[lane][1]);
+      _mm_storeu_ps(local + 8,  columns[lane][2]);
+      _mm_storeu_ps(local + 12, columns[lane][3]);
+    }
+  }
+#endif
+
+  for (; i < end; ++i)
+  {
+    std::uint32_t n = m_LocalList[i];
+    ComposeLocal(m_PositionX[n], m_PositionY[n], m_PositionZ[n],
+                 m_RotationX[n], m_RotationY[n], m_RotationZ[n], m_RotationW[n],
+                 m_ScaleX[n], m_ScaleY[n], m_ScaleZ[n],
+                 m_Local[n]);
+  }
+}
+
+void TransformHierarchy::UpdateWorldMatrices()
+{
+  for (std::uint32_t i : m_WorldList)
+  {
+    std::uint32_t parent = m_Parent[i];
+    if (parent == TransformHierarchy::nullHandle)
+    {
+      m_World[i] = m_Local[i];
+      continue;
+    }
+
+#ifdef TRANSFORM_HIERARCHY_SSE
+    // world column j = sum over k of parent column k * local[j][k]
+    const float* parentWorld = &m_World[parent][0][0];
+    const float* local = &m_Local[i][0][0];
+    float* world = &m_World[i][0][0];
+
+    const __m128 p0 = _mm_loadu_ps(parentWorld + 0);
+    const __m128 p1 = _mm_loadu_ps(parentWorld + 4);
+    const __m128 p2 = _mm_loadu_ps(parentWorld + 8);
+    const __m128 p3 = _mm_loadu_ps(parentWorld + 12);
+    for (int column = 0; column < 4; ++column)
+    {
+      const float* l = local + column * 4;
+      __m128 result = _mm_add_ps(_mm_add_ps(_mm_mul_ps(p0, _mm_set1_ps(l[0])), _mm_mul_ps(p1, _mm_set1_ps(l[1]))),
+                                 _mm_add_ps(_mm_mul_ps(p2, _mm_set1_ps(l[2])), _mm_mul_ps(p3, _mm_set1_ps(l[3]))));
+      _mm_storeu_ps(world + column * 4, result);
+    }
+#else
+    m_World[i] = m_World[parent] * m_Local[i];
+#endif
+  }
+}
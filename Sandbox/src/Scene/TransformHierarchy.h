@@ -0,0 +1,92 @@
+#pragma once
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+// scene graph transforms, local TRS is stored as structure of arrays and nodes are kept sorted so that
+// every parent precedes its children, Update then resolves world matrices in one forward pass,
+// touching only nodes whose local transform or an ancestor's changed
+class TransformHierarchy {
+public:
+  using Handle = std::uint32_t;
+  static constexpr Handle nullHandle = 0xffffffff;
+
+  TransformHierarchy() = default;
+
+  void Reserve(std::size_t count);
+
+  Handle Create(Handle parent = TransformHierarchy::nullHandle);
+
+  // parent must not be a descendant of node, nodes are re-sorted on the next Update when needed
+  void SetParent(Handle node, Handle parent);
+  Handle GetParent(Handle node) const;
+
+  void SetPosition(Handle node, const glm::vec3& position);
+  void SetRotation(Handle node, const glm::quat& rotation);
+  void SetScale(Handle node, const glm::vec3& scale);
+
+  glm::vec3 GetPosition(Handle node) const;
+  glm::quat GetRotation(Handle node) const;
+  glm::vec3 GetScale(Handle node) const;
+
+  void Update();
+
+  // valid after Update
+  const glm::mat4& GetWorldMatrix(Handle node) const;
+
+  inline std::size_t GetSize() const
+  {
+    return m_Parent.size();
+  }
+
+  // local and world matrices rebuilt by the last Update
+  inline std::size_t GetLastLocalUpdates() const
+  {
+    return m_LocalList.size();
+  }
+
+  inline std::size_t GetLastWorldUpdates() const
+  {
+    return m_WorldList.size();
+  }
+
+private:
+  static constexpr std::uint8_t localDirty = 1 << 0;
+  static constexpr std::uint8_t worldDirty = 1 << 1;
+
+  void Sort();
+  void UpdateLocalMatrices(std::size_t begin, std::size_t end);
+  void UpdateWorldMatrices();
+
+  // SoA local TRS, indexed by sorted position
+  std::vector<float> m_PositionX{};
+  std::vector<float> m_PositionY{};
+  std::vector<float> m_PositionZ{};
+  std::vector<float> m_RotationX{};
+  std::vector<float> m_RotationY{};
+  std::vector<float> m_RotationZ{};
+  std::vector<float> m_RotationW{};
+  std::vector<float> m_ScaleX{};
+  std::vector<float> m_ScaleY{};
+  std::vector<float> m_ScaleZ{};
+
+  std::vector<std::uint32_t> m_Parent{};  // sorted index of the parent, nullHandle for roots
+  std::vector<std::uint8_t> m_Flags{};
+  std::vector<glm::mat4> m_Local{};
+  std::vector<glm::mat4> m_World{};
+
+  // handles stay stable across sorts
+  std::vector<std::uint32_t> m_HandleToIndex{};
+  std::vector<Handle> m_IndexToHandle{};
+
+  static constexpr std::size_t parallelLocalGrain = 8 * 1024;
+
+  std::vector<std::uint32_t> m_LocalList{};
+  std::vector<std::uint32_t> m_WorldList{};
+  bool m_NeedsSort = false;
+  bool m_AnyDirty  = false;
+};
@@ -1,4 +1,7 @@
 #include <cmath>
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
 #include <fstream>
 #include <sstream>
 #include <algorithm>
@@ -10,16 +13,46 @@
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
+#include <glm/gtc/constants.hpp>
 
 #include "Core/Core.h"
+#include "Core/DebugOutput.h"
+#include "Core/GLStateCache.h"
 #include "Core/Window.h"
 #include "Core/Shader.h"
 #include "Core/Texture.h"
+#include "Core/SamplerCache.h"
 #include "Core/Buffer.h"
+#include "Core/VertexArray.h"
 #include "Core/Camera.h"
+#include "Core/Draw.h"
+#include "Core/FramePipeline.h"
+#include "Core/ResourceLoader.h"
+
+#include "Renderer/Mesh.h"
+#include "Renderer/MeshPool.h"
+#include "Renderer/Material.h"
+#include "Renderer/RenderQueue.h"
+#include "Renderer/FrameSnapshot.h"
+
+#include "Scene/Bounds.h"
+#include "Scene/Frustum.h"
+#include "Scene/BVH.h"
+#include "Scene/OcclusionBuffer.h"
+#include "Scene/TransformHierarchy.h"
+
+#include "Jobs/JobSystem.h"
 
 #include "Logging/Logger.h"
 
+#include "Profiling/Profiler.h"
+#include "Profiling/GpuProfiler.h"
+#include "Profiling/FrameStats.h"
+#include "Profiling/Counters.h"
+#include "Profiling/BenchmarkRun.h"
+
+#include "Trace/GLTrace.h"
+
 #include "Utility/SystemInfo/SystemInfo.h"
 
 #include "Vendor/stb_image/stb_image.h"
@@ -39,6 +72,8 @@ constexpr const char* SHDR_VERT_PATH_MATERIAL = "res/shaders/material.vert";
 constexpr const char* SHDR_FRAG_PATH_MATERIAL = "res/shaders/material.frag";
 constexpr const char* SHDR_VERT_PATH_LIGHTING_MAP = "res/shaders/lighting_map.vert";
 constexpr const char* SHDR_FRAG_PATH_LIGHTING_MAP = "res/shaders/lighting_map.frag";
+constexpr const char* SHDR_VERT_PATH_INSTANCED = "res/shaders/instanced.vert";
+constexpr const char* SHDR_FRAG_PATH_INSTANCED = "res/shaders/instanced.frag";
 
 constexpr const char* DATA_PATH_CUBE = "res/data/cube.txt";
 
@@ -47,6 +82,57 @@ constexpr const char* WINDOW_NAME = "Sandbox";
 constexpr int         WINDOW_WIDTH = 800;
 constexpr int         WINDOW_HEIGHT = 600;
 
+// HEADLESS, "--headless [frames]" renders offscreen with a fixed timestep and writes the last frame as a PPM image
+constexpr std::uint64_t HEADLESS_FRAMES = 600;
+constexpr double        HEADLESS_TIMESTEP = 1.0 / 60.0;
+constexpr const char*   HEADLESS_IMAGE_PATH = "sandbox.ppm";
+
+// CUBE GRID, drawn through the instanced / multi-draw indirect path
+constexpr int         CUBE_GRID_SIZE = 316;      // ~100k cubes
+constexpr float       CUBE_GRID_SPACING = 2.0f;
+constexpr int         CUBE_GRID_TINTS = 8;
+
+// BENCHMARK, "--benchmark <scene> [warmup frames] [measured frames]" runs a scene headless with the fixed timestep
+// along a scripted camera path and writes a JSON report
+struct BenchmarkScene {
+  const char* name;
+  int gridSize;
+  int orbitLights;      // light source cubes circling over the grid, the shading still uses the scene light only
+};
+
+constexpr BenchmarkScene BENCHMARK_SCENES[]{
+  { "cubes-1k",   32,  0   },
+  { "cubes-10k",  100, 0   },
+  { "cubes-100k", 316, 0   },
+  { "lights",     100, 256 },
+};
+constexpr std::uint64_t BENCHMARK_WARMUP_FRAMES = 120;
+constexpr std::uint64_t BENCHMARK_FRAMES = 600;
+constexpr const char*   BENCHMARK_REPORT_PATH = "sandbox.benchmark.json";
+constexpr float         BENCHMARK_CAMERA_SPEED = 4.0f;
+
+// PROJECTION
+constexpr float       NEAR_PLANE = 0.1f;
+constexpr float       FAR_PLANE = 100.0f;
+
+// FRAME PIPELINE, the simulation of frame N+1 overlaps rendering frame N
+constexpr bool        FRAME_PIPELINING = true;
+constexpr double      PIPELINE_STATISTICS_INTERVAL = 5.0;
+
+// LOADER, SINGLE_THREADED uploads inside the frame loop on the render thread
+constexpr ResourceLoader::Mode LOADER_MODE = ResourceLoader::Mode::SHARED_CONTEXT;
+
+// PROFILER, only used by PROFILE builds, F9 toggles a capture
+constexpr const char* PROFILE_PATH_CHROME = "sandbox.profile.json";
+constexpr const char* PROFILE_PATH_BINARY = "sandbox.profile";
+constexpr std::size_t PROFILE_LOGGED_SCOPES = 8;
+
+// COUNTERS, F10 toggles recording the per frame counters
+constexpr const char* COUNTERS_PATH_CSV = "sandbox.counters.csv";
+
+// CAPTURE, only used by GL_TRACE builds, analysed or replayed by TraceTool
+constexpr const char* TRACE_PATH = "sandbox.gltrace";
+
 // TIMING
 float deltaTime = 0.0f;
 float lastFrame = 0.0f;
@@ -64,15 +150,87 @@ glm::vec3 objectColor{ 1.0f, 0.5f, 0.31f };
 
 // FUNCTION DECLARATIONS
 void WindowErrorCallback(int error, const char* description);
-void UpdateCamera(Window& window);
-void UpdateLight(Window& window);
+void UpdateCamera(const InputState& input);
+void UpdateLight(const InputState& input);
+void LogFrameStatistics(const FrameStats::Summary& summary);
+void LogPipelineStatistics(bool pipelined, const FramePipeline<InputState, FrameSnapshot>::Statistics& statistics);
+void LogProfileStatistics();
+void ToggleProfileCapture();
+void LogCounters();
+void WriteFrameImage(const Window& window, const char* path);
+void UpdateScriptedCamera(double time);
+glm::vec3 OrbitLightPosition(int index, int count, float time, int gridSize);
+void ToggleCounterRecording();
 
 template <typename T>
 void ReadFile(const char* filename, std::vector<T>& dest);
 
-int main()
+int main(int argc, char** argv)
 {
   Window window{ WINDOW_NAME, WINDOW_WIDTH, WINDOW_HEIGHT, false, WindowErrorCallback };
+  int gridSize    = CUBE_GRID_SIZE;
+  int orbitLights = 0;
+  std::unique_ptr<BenchmarkRun> benchmark{};
+  for (int i = 1; i < argc; ++i)
+  {
+    if (std::strcmp(argv[i], "--headless") == 0)
+    {
+      std::uint64_t frames = HEADLESS_FRAMES;
+      if (i + 1 < argc && std::isdigit(static_cast<unsigned char>(argv[i + 1][0])))
+      {
+        frames = std::strtoull(argv[++i], nullptr, 10);
+      }
+      window.SetHeadless(true);
+      window.SetFrameLimit(frames);
+      window.SetFixedTimestep(HEADLESS_TIMESTEP);
+    }
+    else if (std::strcmp(argv[i], "--benchmark") == 0)
+    {
+      const BenchmarkScene* scene = nullptr;
+      for (const BenchmarkScene& candidate : BENCHMARK_SCENES)
+      {
+        if (i + 1 < argc && std::strcmp(argv[i + 1], candidate.name) == 0)
+        {
+          scene = &candidate;
+        }
+      }
+
+      if (!scene)
+      {
+        OStreamDelegate log = Logger::Instance(std::cerr).Log();
+        log << "[ERROR::BENCHMARK] Unknown benchmark scene, available :";
+        for (const BenchmarkScene& candidate : BENCHMARK_SCENES)
+        {
+          log << " " << candidate.name;
+        }
+        return EXIT_FAILURE;
+      }
+      ++i;
+
+      std::uint64_t frames[2]{ BENCHMARK_WARMUP_FRAMES, BENCHMARK_FRAMES };
+      for (std::uint64_t& frameCount : frames)
+      {
+        if (i + 1 < argc && std::isdigit(static_cast<unsigned char>(argv[i + 1][0])))
+        {
+          frameCount = std::strtoull(argv[++i], nullptr, 10);
+        }
+      }
+
+      gridSize    = scene->gridSize;
+      orbitLights = scene->orbitLights;
+      benchmark   = std::make_unique<BenchmarkRun>(scene->name, frames[0], frames[1]);
+      benchmark->SetParameter("cubes", static_cast<double>(gridSize) * gridSize);
+      benchmark->SetParameter("lights", 1.0 + orbitLights);
+      benchmark->SetParameter("timestep", HEADLESS_TIMESTEP);
+      benchmark->SetParameter("width", WINDOW_WIDTH);
+      benchmark->SetParameter("height", WINDOW_HEIGHT);
+
+      window.SetHeadless(true);
+      window.SetFrameLimit(benchmark->GetTotalFrames());
+      window.SetFixedTimestep(HEADLESS_TIMESTEP);
+    }
+  }
+
   try {
     window.Initialize();
   }
@@ -82,6 +240,23 @@ int main()
     return EXIT_FAILURE;
   }
   SystemInfo();
+  JobSystem::Instance().Initialize();
+  PROFILE_THREAD("Render");
+  ResourceLoader::Instance().Initialize(window, LOADER_MODE);
+  GpuProfiler::Instance().Initialize();
+  if (benchmark)
+  {
+    benchmark->SetParameter("workers", JobSystem::Instance().GetWorkerCount());
+  }
+
+#ifndef NDEBUG
+  DebugOutput::Instance().SetMinimumSeverity(GL_DEBUG_SEVERITY_LOW);
+  DebugOutput::Instance().Install(DebugOutput::Mode::SYNCHRONOUS);
+#endif
+
+#ifdef GL_TRACE
+  GLTrace::Instance().Begin(TRACE_PATH);
+#endif
 
   Shader objShdr{};
   try
@@ -109,6 +284,19 @@ int main()
     return EXIT_FAILURE;
   }
 
+  Shader instancedShdr{};
+  try
+  {
+    instancedShdr.LoadFromFile(GL_VERTEX_SHADER, SHDR_VERT_PATH_INSTANCED);
+    instancedShdr.LoadFromFile(GL_FRAGMENT_SHADER, SHDR_FRAG_PATH_INSTANCED);
+    instancedShdr.Link();
+  }
+  catch (const std::exception& err)
+  {
+    Logger::Instance(std::cerr).Log() << err.what();
+    return EXIT_FAILURE;
+  }
+
   std::vector<float> data{};
   try
   {
@@ -121,177 +309,472 @@ int main()
   }
   Buffer<float> buffer{ data };
 
-  GLuint objectVAO;
+  VertexArray objectVAO{};
+  objectVAO.SetVertexBuffer(0, buffer.GetID(), 0, 8 * sizeof(float));
+  try
+  {
+    objectVAO.SetAttribute(objShdr.GetAttributeLocation("position"), 0, 3, GL_FLOAT, false, 0 * sizeof(float));
+    objectVAO.SetAttribute(objShdr.GetAttributeLocation("normal"), 0, 3, GL_FLOAT, false, 3 * sizeof(float));
+    objectVAO.SetAttribute(objShdr.GetAttributeLocation("texCoords"), 0, 2, GL_FLOAT, false, 6 * sizeof(float));
+  }
+  catch (const std::exception& err)
   {
-    CALL(glGenVertexArrays(1, &objectVAO));
-    CALL(glBindVertexArray(objectVAO));
-    buffer.Bind();
+    Logger::Instance(std::cerr).Log() << err.what();
+    return EXIT_FAILURE;
+  }
 
-    try
-    {
-      CALL(glVertexAttribPointer(objShdr.GetAttributeLocation("position"), 3, GL_FLOAT, GL_FALSE, 8 * sizeof(float), reinterpret_cast<const void*>(0 * sizeof(float))));
-      CALL(glEnableVertexAttribArray(objShdr.GetAttributeLocation("position")));
+  VertexArray lightVAO{};
+  lightVAO.SetVertexBuffer(0, buffer.GetID(), 0, 8 * sizeof(float));
+  try
+  {
+    lightVAO.SetAttribute(lightSrcShdr.GetAttributeLocation("position"), 0, 3, GL_FLOAT, false, 0 * sizeof(float));
+  }
+  catch (const std::exception& err)
+  {
+    Logger::Instance(std::cerr).Log() << err.what();
+    return EXIT_FAILURE;
+  }
 
-      CALL(glVertexAttribPointer(objShdr.GetAttributeLocation("normal"), 3, GL_FLOAT, GL_FALSE, 8 * sizeof(float), reinterpret_cast<const void*>(3 * sizeof(float))));
-      CALL(glEnableVertexAttribArray(objShdr.GetAttributeLocation("normal")));
+  // heterogeneous grid meshes share one vertex array, the whole grid is a single multi-draw indirect call
+  std::vector<float> slabData{ data };
+  for (std::size_t i = 1; i < slabData.size(); i += 8)
+  {
+    slabData[i] *= 0.25f;
+  }
 
-      CALL(glVertexAttribPointer(objShdr.GetAttributeLocation("texCoords"), 2, GL_FLOAT, GL_FALSE, 8 * sizeof(float), reinterpret_cast<const void*>(6 * sizeof(float))));
-      CALL(glEnableVertexAttribArray(objShdr.GetAttributeLocation("texCoords")));
-    }
-    catch (const std::exception& err)
+  MeshPool meshPool{ 8 };
+  Mesh gridCubeMesh = meshPool.Add(data);
+  Mesh gridSlabMesh = meshPool.Add(slabData);
+  meshPool.Upload();
+  try
+  {
+    VertexArray& gridVAO = meshPool.GetVertexArray();
+    gridVAO.SetAttribute(instancedShdr.GetAttributeLocation("position"), 0, 3, GL_FLOAT, false, 0 * sizeof(float));
+    gridVAO.SetAttribute(instancedShdr.GetAttributeLocation("normal"), 0, 3, GL_FLOAT, false, 3 * sizeof(float));
+    gridVAO.SetAttribute(instancedShdr.GetAttributeLocation("texCoords"), 0, 2, GL_FLOAT, false, 6 * sizeof(float));
+  }
+  catch (const std::exception& err)
+  {
+    Logger::Instance(std::cerr).Log() << err.what();
+    return EXIT_FAILURE;
+  }
+
+  Texture diffuseMap{};
+  Texture specularMap{};
+
+  Mesh objectMesh{ objectVAO, 36 };
+  Mesh lightMesh{ lightVAO, 36 };
+
+  Material objectMaterial{ objShdr };
+  Material lightMaterial{ lightSrcShdr };
+  Material gridMaterial{ instancedShdr };
+  gridMaterial.SetInstanced(true);
+  objectMaterial.SetPassName("Objects");
+  lightMaterial.SetPassName("Light sources");
+  gridMaterial.SetPassName("Cube grid");
+  try
+  {
+    objectMaterial.SetUniform("material.diffuse", 0);
+    objectMaterial.SetUniform("material.specular", 1);
+    objectMaterial.SetUniform("material.shininess", 64.0f);            // radius fo the specular highlight
+    objectMaterial.SetUniform("light.ambient", glm::vec3{ 0.2f });      // low intensity
+    objectMaterial.SetUniform("light.diffuse", glm::vec3{ 0.8f });      // darkened -> usually around light color
+    objectMaterial.SetUniform("light.specular", glm::vec3{ 1.0f });     // usually 1.0f (full intensity)
+
+    lightMaterial.SetUniform("lightColor", lightColor);
+
+    gridMaterial.SetUniform("material.diffuse", 0);
+    gridMaterial.SetUniform("material.specular", 1);
+    gridMaterial.SetUniform("material.shininess", 64.0f);
+    gridMaterial.SetUniform("light.ambient", glm::vec3{ 0.2f });
+    gridMaterial.SetUniform("light.diffuse", glm::vec3{ 0.8f });
+    gridMaterial.SetUniform("light.specular", glm::vec3{ 1.0f });
+    for (int tint = 0; tint < CUBE_GRID_TINTS; ++tint)
     {
-      Logger::Instance(std::cerr).Log() << err.what();
-      return EXIT_FAILURE;
+      std::string uniform = "material.tints[" + std::to_string(tint) + "]";
+      gridMaterial.SetUniform(uniform.c_str(), glm::vec3{ 0.5f + 0.5f * ((tint >> 0) & 1), 0.5f + 0.5f * ((tint >> 1) & 1), 0.5f + 0.5f * ((tint >> 2) & 1) });
     }
-
-    CALL(glBindVertexArray(0));
-    buffer.UnBind();
   }
-
-  GLuint lightVAO;
+  catch (const std::exception& err)
   {
-    CALL(glGenVertexArrays(1, &lightVAO));
-    CALL(glBindVertexArray(lightVAO));
-    buffer.Bind();
+    Logger::Instance(std::cerr).Log() << err.what();
+    return EXIT_FAILURE;
+  }
 
-    try
+  // the textures are decoded and uploaded on the loader thread, the materials pick them up once the upload fence signalled
+  ResourceLoader::Instance().LoadTexture(diffuseMap, TEX_PATH_STEEL_WOOD_CONTAINER, GL_TEXTURE_2D, GL_FALSE,
+    [&]()
     {
-      CALL(glVertexAttribPointer(lightSrcShdr.GetAttributeLocation("position"), 3, GL_FLOAT, GL_FALSE, 8 * sizeof(float), reinterpret_cast<const void*>(0 * sizeof(float))));
-      CALL(glEnableVertexAttribArray(lightSrcShdr.GetAttributeLocation("position")));
+      objectMaterial.SetTexture(0, diffuseMap);
+      gridMaterial.SetTexture(0, diffuseMap);
     }
-    catch (const std::exception& err)
+  );
+  ResourceLoader::Instance().LoadTexture(specularMap, TEX_PATH_STEEL_WOOD_CONTAINER_SPECULAR, GL_TEXTURE_2D, GL_FALSE,
+    [&]()
     {
-      Logger::Instance(std::cerr).Log() << err.what();
-      return EXIT_FAILURE;
+      objectMaterial.SetTexture(1, specularMap);
+      gridMaterial.SetTexture(1, specularMap);
+      Logger::Instance(std::cout).Log() << "[INFO] Peak RSS after texture load : " << PeakResidentSetSize() / 1024 << " KiB";
+    }
+  );
+
+  // the grid hangs off one root node, it is never dirty again after the first update
+  TransformHierarchy transforms{};
+  transforms.Reserve(static_cast<std::size_t>(gridSize) * gridSize + orbitLights + 3);
+  TransformHierarchy::Handle objectNode = transforms.Create();
+  TransformHierarchy::Handle lightNode  = transforms.Create();
+  TransformHierarchy::Handle gridRoot   = transforms.Create();
+  transforms.SetScale(lightNode, glm::vec3{ 0.2f });
+  transforms.SetPosition(gridRoot, glm::vec3{ 0.0f, -3.0f, 0.0f });
+
+  std::vector<TransformHierarchy::Handle> gridNodes{};
+  gridNodes.reserve(static_cast<std::size_t>(gridSize) * gridSize);
+  for (int z = 0; z < gridSize; ++z)
+  {
+    for (int x = 0; x < gridSize; ++x)
+    {
+      TransformHierarchy::Handle node = transforms.Create(gridRoot);
+      transforms.SetPosition(node, glm::vec3{ (x - gridSize / 2) * CUBE_GRID_SPACING, 0.0f, -(z + 2) * CUBE_GRID_SPACING });
+      gridNodes.push_back(node);
     }
-
-    CALL(glBindVertexArray(0));
-    buffer.UnBind();
   }
 
-  Texture diffuseMap{};
-  Texture specularMap{};
-  try
+  // benchmark scenes only, each one is a separate draw through the per draw path
+  std::vector<TransformHierarchy::Handle> orbitNodes{};
+  for (int i = 0; i < orbitLights; ++i)
   {
-    diffuseMap.LoadFromFile(TEX_PATH_STEEL_WOOD_CONTAINER, GL_TEXTURE_2D, GL_FALSE);
-    specularMap.LoadFromFile(TEX_PATH_STEEL_WOOD_CONTAINER_SPECULAR, GL_TEXTURE_2D, GL_FALSE);
+    orbitNodes.push_back(transforms.Create());
+    transforms.SetScale(orbitNodes.back(), glm::vec3{ 0.2f });
   }
-  catch (const std::exception& err)
+  transforms.Update();
+
+  // scene objects are ids into the BVH, the grid cubes come first, the cube bounds are used for slabs too
+  const std::uint32_t objectId = static_cast<std::uint32_t>(gridNodes.size());
+  const std::uint32_t lightId  = objectId + 1;
+  const AABB objectBounds{ glm::vec3{ -0.5f }, glm::vec3{ 0.5f } };
+
+  std::vector<AABB> gridBounds{};
+  std::vector<std::uint32_t> gridIds{};
+  gridBounds.reserve(gridNodes.size());
+  gridIds.reserve(gridNodes.size());
+  for (TransformHierarchy::Handle node : gridNodes)
   {
-    Logger::Instance(std::cerr).Log() << err.what();
-    return EXIT_FAILURE;
+    glm::vec3 position{ transforms.GetWorldMatrix(node)[3] };
+    gridBounds.push_back(AABB{ position - glm::vec3{ 0.5f }, position + glm::vec3{ 0.5f } });
+    gridIds.push_back(static_cast<std::uint32_t>(gridIds.size()));
   }
 
-  objShdr.Bind();
-  objShdr.SetUniform1i(objShdr.GetUniformLocation("material.diffuse"), GL_TEXTURE0 - GL_TEXTURE0);
-  objShdr.SetUniform1i(objShdr.GetUniformLocation("material.specular"), GL_TEXTURE1 - GL_TEXTURE0);
-  objShdr.UnBind();
+  BVH bvh{};
+  std::vector<BVH::Handle> gridHandles(gridNodes.size());
+  bvh.Build(gridBounds.data(), gridIds.data(), gridBounds.size(), gridHandles.data());
+  bvh.Insert(objectBounds, objectId);
+  BVH::Handle lightHandle = bvh.Insert(AABB{ lightPosition - glm::vec3{ 0.1f }, lightPosition + glm::vec3{ 0.1f } }, lightId);
 
-  CALL(glEnable(GL_DEPTH_TEST));
-  CALL(glPolygonMode(GL_FRONT_AND_BACK, GL_FILL));
-  while (!window.ShouldClose())
+  // the orbiting lights follow the scene light's id
+  std::vector<BVH::Handle> orbitHandles{};
+  for (int i = 0; i < orbitLights; ++i)
   {
-    float currentFrame = static_cast<float>(glfwGetTime());
+    glm::vec3 position = OrbitLightPosition(i, orbitLights, 0.0f, gridSize);
+    orbitHandles.push_back(bvh.Insert(AABB{ position - glm::vec3{ 0.1f }, position + glm::vec3{ 0.1f } }, lightId + 1 + i));
+  }
+
+  BVH::Statistics bvhStatistics = bvh.GetStatistics();
+  Logger::Instance(std::cout).Log() << "[INFO] Scene BVH : " << bvhStatistics.leaves << " objects, depth " << bvhStatistics.maxDepth << ", SAH cost " << bvhStatistics.sahCost;
+
+  // the container cube is the only occluder, grid cubes hidden behind it are dropped before submission
+  OcclusionBuffer occlusionBuffer{};
+
+  std::vector<std::uint32_t> visibleObjects{};
+  bool pickHeld = false;
+
+  // runs on the simulation thread one frame ahead of rendering, it owns the camera, light, BVH and transforms,
+  // the render thread only sees the snapshot it produces
+  auto simulate = [&](const InputState& input, FrameSnapshot& frame)
+  {
+    float currentFrame = static_cast<float>(input.time);
     deltaTime = currentFrame - lastFrame;
     lastFrame = currentFrame;
 
-    window.CalculateFPS();
-    glfwPollEvents();
+    if (benchmark)
+    {
+      UpdateScriptedCamera(input.time);
+    }
+    else
+    {
+      UpdateCamera(input);
+    }
 
-    UpdateCamera(window);
+    UpdateLight(input);
 
-    UpdateLight(window);
+    glm::mat4 view = camera.GetViewMatrix();
+    glm::mat4 projection = camera.GetProjectionMatrix(static_cast<float>(input.width) / input.height, NEAR_PLANE, FAR_PLANE);
 
-    CALL(glClearColor(0.0f, 0.0f, 0.0f, 1.0f));
-    CALL(glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT));
+    bvh.Update(lightHandle, AABB{ lightPosition - glm::vec3{ 0.1f }, lightPosition + glm::vec3{ 0.1f } });
+    for (int i = 0; i < orbitLights; ++i)
+    {
+      glm::vec3 position = OrbitLightPosition(i, orbitLights, currentFrame, gridSize);
+      transforms.SetPosition(orbitNodes[i], position);
+      bvh.Update(orbitHandles[i], AABB{ position - glm::vec3{ 0.1f }, position + glm::vec3{ 0.1f } });
+    }
 
-    glm::mat4 view = camera.GetViewMatrix();
-    glm::mat4 projection = glm::perspective(glm::radians(camera.GetZoom()), static_cast<float>(window.GetWidth()) / window.GetHeight(), 0.1f, 100.0f);
+    // picking a grid cube removes it from the scene
+    bool pickPressed = input.GetKeyState(GLFW_KEY_P) == GLFW_PRESS;
+    if (pickPressed && !pickHeld)
+    {
+      BVH::RayHit hit{};
+      Ray ray = camera.ScreenPointToRay(input.cursorX, input.cursorY, input.width, input.height);
+      if (bvh.Raycast(ray, FAR_PLANE, hit))
+      {
+        Logger::Instance(std::cout).Log() << "[INFO] Picked object " << hit.object << " at distance " << hit.distance;
+        if (hit.object < objectId)
+        {
+          bvh.Remove(hit.handle);
+        }
+      }
+    }
+    pickHeld = pickPressed;
+
+    visibleObjects.clear();
+    bvh.Query(Frustum::FromMatrix(projection * view), visibleObjects);
+
+    { PROFILE_SCOPE("Occlusion");
+      occlusionBuffer.Begin(projection * view);
+      occlusionBuffer.AddOccluder(objectBounds);
+      occlusionBuffer.End();
+    }
 
+    transforms.SetPosition(lightNode, lightPosition);
+    transforms.Update();
+
+    PROFILE_SCOPE("Snapshot");
+    frame.Clear();
+    frame.view           = view;
+    frame.projection     = projection;
+    frame.cameraPosition = camera.GetPosition();
+    frame.farPlane       = FAR_PLANE;
+    frame.lights.push_back(FrameSnapshot::Light{ lightPosition, lightColor });
+    for (TransformHierarchy::Handle node : orbitNodes)
     {
-      objShdr.Bind();
-      glm::mat4 model = glm::mat4{ 1.0f };
+      frame.lights.push_back(FrameSnapshot::Light{ glm::vec3{ transforms.GetWorldMatrix(node)[3] }, lightColor });
+    }
+    for (std::uint32_t id : visibleObjects)
+    {
+      if (id == objectId)
+      {
+        frame.instances.push_back(FrameSnapshot::Instance{ &objectMesh, &objectMaterial, transforms.GetWorldMatrix(objectNode) });
+      }
+      else if (id == lightId)
+      {
+        frame.instances.push_back(FrameSnapshot::Instance{ &lightMesh, &lightMaterial, transforms.GetWorldMatrix(lightNode) });
+      }
+      else if (id > lightId)
+      {
+        frame.instances.push_back(FrameSnapshot::Instance{ &lightMesh, &lightMaterial, transforms.GetWorldMatrix(orbitNodes[id - lightId - 1]) });
+      }
+      else if (occlusionBuffer.IsVisible(gridBounds[id]))
+      {
+        const Mesh& gridMesh = (id / gridSize + id) % 2 ? gridSlabMesh : gridCubeMesh;
+        frame.instances.push_back(FrameSnapshot::Instance{ &gridMesh, &gridMaterial, transforms.GetWorldMatrix(gridNodes[id]), id % CUBE_GRID_TINTS });
+      }
+    }
+  };
+  FramePipeline<InputState, FrameSnapshot> pipeline{ simulate, FRAME_PIPELINING };
+
+  RenderQueue renderQueue{};
+  renderQueue.EnableInstancing(meshPool.GetVertexArray());
+  renderQueue.Register(objectMaterial);
+  renderQueue.Register(lightMaterial);
+  renderQueue.Register(gridMaterial);
+  renderQueue.Register(objectMesh);
+  renderQueue.Register(lightMesh);
+  renderQueue.Register(gridCubeMesh);
+  renderQueue.Register(gridSlabMesh);
 
-      objShdr.SetUniformMatrix4fv(objShdr.GetUniformLocation("model"), glm::value_ptr(model));
-      objShdr.SetUniformMatrix4fv(objShdr.GetUniformLocation("view"), glm::value_ptr(view));
-      objShdr.SetUniformMatrix4fv(objShdr.GetUniformLocation("projection"), glm::value_ptr(projection));
+  CALL(glEnable(GL_DEPTH_TEST));
+  CALL(glPolygonMode(GL_FRONT_AND_BACK, GL_FILL));
+  FrameStats frameStats{};
+  bool countersKeyHeld = false;
+  double statisticsTime = glfwGetTime();
+#if PROFILE
+  bool captureKeyHeld = false;
+#endif
+
+  // unattended runs have to look the same every time, nothing may pop in halfway
+  if (window.IsHeadless())
+  {
+    try
+    {
+      ResourceLoader::Instance().Flush();
+    }
+    catch (const std::exception& err)
+    {
+      Logger::Instance(std::cerr).Log() << err.what();
+      return EXIT_FAILURE;
+    }
+  }
 
-      objShdr.SetUniform3fv(objShdr.GetUniformLocation("cameraPosition"), glm::value_ptr(camera.GetPosition()));
+  while (!window.ShouldClose())
+  {
+    frameStats.Tick();
+    glfwPollEvents();
 
-      //objShdr.SetUniform3fv(objShdr.GetUniformLocation("material.specular"), glm::value_ptr(glm::vec3{ 0.5f })); // specular highlight of the surface
-      objShdr.SetUniform1f(objShdr.GetUniformLocation("material.shininess"), 64.0f); // radius fo the specular highlight
+    pipeline.Submit(window.CaptureInput());
 
-      objShdr.SetUniform3fv(objShdr.GetUniformLocation("light.position"), glm::value_ptr(lightPosition));
-      objShdr.SetUniform3fv(objShdr.GetUniformLocation("light.ambient"), glm::value_ptr(glm::vec3{ 0.2f })); // low intensity
-      objShdr.SetUniform3fv(objShdr.GetUniformLocation("light.diffuse"), glm::value_ptr(glm::vec3{ 0.8f })); // darkened -> usually around light color
-      objShdr.SetUniform3fv(objShdr.GetUniformLocation("light.specular"), glm::value_ptr(glm::vec3{ 1.0f })); // usually 1.0f (full intensity)
+    try
+    {
+      ResourceLoader::Instance().Update();
+    }
+    catch (const std::exception& err)
+    {
+      Logger::Instance(std::cerr).Log() << err.what();
+      return EXIT_FAILURE;
+    }
 
-      CALL(glActiveTexture(GL_TEXTURE0));
-      diffuseMap.Bind();
+    { PROFILE_GPU_SCOPE("Clear");
+      CALL(glClearColor(0.0f, 0.0f, 0.0f, 1.0f));
+      CALL(glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT));
+    }
 
-      CALL(glActiveTexture(GL_TEXTURE1));
-      specularMap.Bind();
+    // the first pipelined iteration has nothing to draw yet
+    if (pipeline.HasFrame())
+    {
+      const FrameSnapshot& frame = pipeline.GetFrame();
+
+      // sort keys are generated on the workers, only the merged queue is sorted and executed here
+      renderQueue.Begin(frame.cameraPosition, frame.farPlane);
+      renderQueue.Record(frame.instances.size(),
+        [&frame](CommandBuffer& commands, std::size_t begin, std::size_t end)
+        {
+          for (std::size_t i = begin; i < end; ++i)
+          {
+            const FrameSnapshot::Instance& instance = frame.instances[i];
+            commands.Submit(*instance.mesh, *instance.material, instance.model, instance.materialIndex);
+          }
+        }
+      );
+      renderQueue.Sort();
+      renderQueue.Execute(
+        [&](Shader& shader)
+        {
+          shader.SetUniformMatrix4fv(shader.GetUniformLocation("view"), glm::value_ptr(frame.view));
+          shader.SetUniformMatrix4fv(shader.GetUniformLocation("projection"), glm::value_ptr(frame.projection));
+
+          if (&shader == &objShdr || &shader == &instancedShdr)
+          {
+            shader.SetUniform3fv(shader.GetUniformLocation("cameraPosition"), glm::value_ptr(frame.cameraPosition));
+            shader.SetUniform3fv(shader.GetUniformLocation("light.position"), glm::value_ptr(frame.lights.front().position));
+          }
+        }
+      );
+    }
 
-      CALL(glBindVertexArray(objectVAO));
-      CALL(glDrawArrays(GL_TRIANGLES, 0, 36));
-      CALL(glBindVertexArray(0));
-      objShdr.UnBind();
+    CheckFrameErrors();
+    { PROFILE_SCOPE("SwapBuffers");
+      window.SwapBuffers();
     }
+    GLStateCache::Instance().EndFrame();
+    GL_TRACE_RECORD(EndFrame());
 
+    try
+    {
+      pipeline.Advance();
+    }
+    catch (const std::exception& err)
     {
-      lightSrcShdr.Bind();
-      glm::mat4 model = glm::translate(glm::mat4{ 1.0f }, lightPosition);
-                model = glm::scale(model, glm::vec3{ 0.2f });
+      Logger::Instance(std::cerr).Log() << err.what();
+      return EXIT_FAILURE;
+    }
 
-      lightSrcShdr.SetUniformMatrix4fv(lightSrcShdr.GetUniformLocation("model"), glm::value_ptr(model));
-      lightSrcShdr.SetUniformMatrix4fv(lightSrcShdr.GetUniformLocation("view"), glm::value_ptr(view));
-      lightSrcShdr.SetUniformMatrix4fv(lightSrcShdr.GetUniformLocation("projection"), glm::value_ptr(projection));
+    GpuProfiler::Instance().EndFrame();
+    Counters::Instance().EndFrame();
+    if (benchmark)
+    {
+      benchmark->EndFrame();
+    }
+    PROFILE_FRAME();
 
-      lightSrcShdr.SetUniform3fv(lightSrcShdr.GetUniformLocation("lightColor"), glm::value_ptr(lightColor));
+    bool countersKeyPressed = window.GetKeyState(GLFW_KEY_F10) == GLFW_PRESS;
+    if (countersKeyPressed && !countersKeyHeld)
+    {
+      ToggleCounterRecording();
+    }
+    countersKeyHeld = countersKeyPressed;
 
-      CALL(glBindVertexArray(lightVAO));
-      CALL(glDrawArrays(GL_TRIANGLES, 0, 36));
-      CALL(glBindVertexArray(0));
-      lightSrcShdr.UnBind();
+#if PROFILE
+    // F9 starts a capture, the second press writes it out
+    bool captureKeyPressed = window.GetKeyState(GLFW_KEY_F9) == GLFW_PRESS;
+    if (captureKeyPressed && !captureKeyHeld)
+    {
+      ToggleProfileCapture();
     }
+    captureKeyHeld = captureKeyPressed;
+#endif
 
-    window.SwapBuffers();
+    if (glfwGetTime() - statisticsTime > PIPELINE_STATISTICS_INTERVAL)
+    {
+      LogFrameStatistics(frameStats.GetSummary());
+      LogCounters();
+      frameStats.Reset();
+      LogPipelineStatistics(pipeline.IsPipelined(), pipeline.GetStatistics());
+      LogProfileStatistics();
+      pipeline.ResetStatistics();
+      statisticsTime = glfwGetTime();
+    }
   }
 
-  CALL(glBindVertexArray(objectVAO));
-  try
-  {
-    CALL(glDisableVertexAttribArray(objShdr.GetAttributeLocation("position")));
-    CALL(glDisableVertexAttribArray(objShdr.GetAttributeLocation("normal")));
-    CALL(glDisableVertexAttribArray(objShdr.GetAttributeLocation("texCoords")));
-  }
-  catch (const std::exception& err)
-  {
-    Logger::Instance(std::cerr).Log() << err.what();
-    return EXIT_FAILURE;
-  }
-  CALL(glBindVertexArray(0));
+#ifdef GL_TRACE
+  GLTrace::Instance().End();
+#endif
 
-  CALL(glBindVertexArray(lightVAO));
-  try
+  if (window.IsHeadless())
   {
-    CALL(glDisableVertexAttribArray(lightSrcShdr.GetAttributeLocation("position")));
+    try
+    {
+      WriteFrameImage(window, HEADLESS_IMAGE_PATH);
+    }
+    catch (const std::exception& err)
+    {
+      Logger::Instance(std::cerr).Log() << err.what();
+    }
   }
-  catch (const std::exception& err)
+
+  if (benchmark)
   {
-    Logger::Instance(std::cerr).Log() << err.what();
-    return EXIT_FAILURE;
+    try
+    {
+      benchmark->WriteJson(BENCHMARK_REPORT_PATH);
+      FrameStats::Summary summary = benchmark->GetSummary();
+      Logger::Instance(std::cout).Log()
+        << "[INFO::BENCHMARK] " << summary.frames << " frames, p50 " << summary.p50Milliseconds << " ms, p99 "
+        << summary.p99Milliseconds << " ms, report written to " << BENCHMARK_REPORT_PATH;
+    }
+    catch (const std::exception& err)
+    {
+      Logger::Instance(std::cerr).Log() << err.what();
+      return EXIT_FAILURE;
+    }
   }
-  CALL(glBindVertexArray(0));
 
-  CALL(glDeleteVertexArrays(1, &objectVAO));
-  CALL(glDeleteVertexArrays(1, &lightVAO));
+  ResourceLoader::Instance().Shutdown();
+
+  objectVAO.Dispose();
+  lightVAO.Dispose();
+  meshPool.Dispose();
+  renderQueue.Dispose();
+  GpuProfiler::Instance().Dispose();
 
   diffuseMap.Dispose();
   specularMap.Dispose();
+  SamplerCache::Instance().Dispose();
+
+  DebugOutput::Instance().Flush();
+  DebugOutput::Instance().Uninstall();
   buffer.Dispose();
   objShdr.Dispose();
   lightSrcShdr.Dispose();
+  instancedShdr.Dispose();
+
+  JobSystem::Instance().Shutdown();
 
   return EXIT_SUCCESS;
 }
@@ -301,38 +784,196 @@ void WindowErrorCallback(int error, const char* description)
   Logger::Instance(std::cerr).Log() << u8"[ERROR::GLFW] : code: " << error << " msg: " << description;
 }
 
-void UpdateCamera(Window& window)
+void UpdateCamera(const InputState& input)
 {
-  if (window.GetKeyState(GLFW_KEY_W) == GLFW_PRESS)
+  if (input.GetKeyState(GLFW_KEY_W) == GLFW_PRESS)
     camera.ProcessKeyboard(Camera::MovementDirection::FORWARD, deltaTime);
-  if (window.GetKeyState(GLFW_KEY_S) == GLFW_PRESS)
+  if (input.GetKeyState(GLFW_KEY_S) == GLFW_PRESS)
     camera.ProcessKeyboard(Camera::MovementDirection::BACKWARD, deltaTime);
-  if (window.GetKeyState(GLFW_KEY_D) == GLFW_PRESS)
+  if (input.GetKeyState(GLFW_KEY_D) == GLFW_PRESS)
     camera.ProcessKeyboard(Camera::MovementDirection::RIGHT, deltaTime);
-  if (window.GetKeyState(GLFW_KEY_A) == GLFW_PRESS)
+  if (input.GetKeyState(GLFW_KEY_A) == GLFW_PRESS)
     camera.ProcessKeyboard(Camera::MovementDirection::LEFT, deltaTime);
 
-  camera.ProcessMouseMovement(window.GetMouseXOffset(), window.GetMouseYOffset());
+  camera.ProcessMouseMovement(input.mouseXOffset, input.mouseYOffset);
 
-  camera.ProcessMouseScroll(window.GetScrollYOffset());
+  camera.ProcessMouseScroll(input.scrollYOffset);
 }
 
-void UpdateLight(Window& window)
+void UpdateScriptedCamera(double time)
 {
-  if (window.GetKeyState(GLFW_KEY_UP) == GLFW_PRESS)
+  // a function of time only, every run sees the same frames: flies over the grid while sweeping left and right
+  float t = static_cast<float>(time);
+  glm::vec3 position{ 8.0f * std::sin(t * 0.4f), 2.0f + std::sin(t * 0.25f), 3.0f - BENCHMARK_CAMERA_SPEED * t };
+  float yaw   = -90.0f + 35.0f * std::sin(t * 0.3f);
+  float pitch = -12.0f;
+  camera = Camera{ position, glm::vec3{ 0.0f, 1.0f, 0.0f }, yaw, pitch };
+}
+
+glm::vec3 OrbitLightPosition(int index, int count, float time, int gridSize)
+{
+  // one ring over the middle of the grid, neighbours circle in opposite directions at different heights
+  float radius = 0.25f * gridSize * CUBE_GRID_SPACING;
+  float angle  = glm::two_pi<float>() * index / count + (index % 2 ? -0.5f : 0.5f) * time;
+  return glm::vec3{ radius * std::cos(angle), -1.0f + index % 4, -(gridSize / 2 + 2) * CUBE_GRID_SPACING + radius * std::sin(angle) };
+}
+
+void UpdateLight(const InputState& input)
+{
+  if (input.GetKeyState(GLFW_KEY_UP) == GLFW_PRESS)
     lightPosition.z -= 2.5f * deltaTime;
-  if (window.GetKeyState(GLFW_KEY_DOWN) == GLFW_PRESS)
+  if (input.GetKeyState(GLFW_KEY_DOWN) == GLFW_PRESS)
     lightPosition.z += 2.5f * deltaTime;
-  if (window.GetKeyState(GLFW_KEY_RIGHT) == GLFW_PRESS)
+  if (input.GetKeyState(GLFW_KEY_RIGHT) == GLFW_PRESS)
     lightPosition.x += 2.5f * deltaTime;
-  if (window.GetKeyState(GLFW_KEY_LEFT) == GLFW_PRESS)
+  if (input.GetKeyState(GLFW_KEY_LEFT) == GLFW_PRESS)
     lightPosition.x -= 2.5f * deltaTime;
-  if (window.GetKeyState(GLFW_KEY_RIGHT_SHIFT) == GLFW_PRESS)
+  if (input.GetKeyState(GLFW_KEY_RIGHT_SHIFT) == GLFW_PRESS)
     lightPosition.y += 2.5f * deltaTime;
-  if (window.GetKeyState(GLFW_KEY_RIGHT_CONTROL) == GLFW_PRESS)
+  if (input.GetKeyState(GLFW_KEY_RIGHT_CONTROL) == GLFW_PRESS)
     lightPosition.y -= 2.5f * deltaTime;
 }
 
+void LogFrameStatistics(const FrameStats::Summary& summary)
+{
+  Logger::Instance(std::cout).Log()
+    << "[INFO::FRAMES] " << summary.frames << " frames, " << summary.fps << " fps, frame time avg "
+    << summary.averageMilliseconds << " ms, p50 " << summary.p50Milliseconds << " ms, p95 " << summary.p95Milliseconds
+    << " ms, p99 " << summary.p99Milliseconds << " ms, max " << summary.maxMilliseconds << " ms, " << summary.hitches << " hitches";
+
+  OStreamDelegate log = Logger::Instance(std::cout).Log();
+  log << "[INFO::FRAMES] histogram";
+  for (std::size_t i = 0; i < FrameStats::histogramBins; ++i)
+  {
+    if (i < FrameStats::histogramEdges.size())
+    {
+      log << " <" << FrameStats::histogramEdges[i] << " ms: " << summary.histogram[i];
+    }
+    else
+    {
+      log << " >=" << FrameStats::histogramEdges.back() << " ms: " << summary.histogram[i];
+    }
+  }
+}
+
+void LogPipelineStatistics(bool pipelined, const FramePipeline<InputState, FrameSnapshot>::Statistics& statistics)
+{
+  Logger::Instance(std::cout).Log()
+    << "[INFO::PIPELINE] " << (pipelined ? "pipelined" : "serial")
+    << " : " << statistics.framesPerSecond << " fps"
+    << ", frame " << statistics.frameMilliseconds << " ms"
+    << ", simulation " << statistics.simulationMilliseconds << " ms"
+    << ", render " << statistics.renderMilliseconds << " ms"
+    << ", waiting " << statistics.waitMilliseconds << " ms"
+    << ", latency " << statistics.latencyMilliseconds << " ms (max " << statistics.maxLatencyMilliseconds << " ms)";
+}
+
+void LogProfileStatistics()
+{
+#if PROFILE
+  const std::vector<Profiler::ScopeStatistics>& scopes = Profiler::Instance().GetFrameStatistics();
+  for (std::size_t i = 0; i < scopes.size() && i < PROFILE_LOGGED_SCOPES; ++i)
+  {
+    Logger::Instance(std::cout).Log()
+      << "[INFO::PROFILER] " << scopes[i].name << " : " << scopes[i].milliseconds << " ms, "
+      << scopes[i].calls << " calls, max " << scopes[i].maxMilliseconds << " ms";
+  }
+
+  // read back a few frames late
+  const std::vector<Profiler::ScopeStatistics>& gpuScopes = GpuProfiler::Instance().GetFrameStatistics();
+  for (std::size_t i = 0; i < gpuScopes.size() && i < PROFILE_LOGGED_SCOPES; ++i)
+  {
+    Logger::Instance(std::cout).Log()
+      << "[INFO::PROFILER] GPU " << gpuScopes[i].name << " : " << gpuScopes[i].milliseconds << " ms, "
+      << gpuScopes[i].calls << " calls, max " << gpuScopes[i].maxMilliseconds << " ms";
+  }
+#endif
+}
+
+void ToggleProfileCapture()
+{
+  Profiler& profiler = Profiler::Instance();
+  if (!profiler.IsCapturing())
+  {
+    profiler.BeginCapture();
+    Logger::Instance(std::cout).Log() << "[INFO::PROFILER] Capture started";
+    return;
+  }
+
+  profiler.EndCapture();
+  try
+  {
+    profiler.WriteChromeTrace(PROFILE_PATH_CHROME);
+    profiler.WriteBinary(PROFILE_PATH_BINARY);
+    Logger::Instance(std::cout).Log() << "[INFO::PROFILER] Capture of " << profiler.GetCapturedEvents() << " events written to " << PROFILE_PATH_CHROME << " and " << PROFILE_PATH_BINARY;
+  }
+  catch (const std::exception& err)
+  {
+    Logger::Instance(std::cerr).Log() << err.what();
+  }
+}
+
+void LogCounters()
+{
+  // values of the last frame
+  const Counters& counters = Counters::Instance();
+  OStreamDelegate log = Logger::Instance(std::cout).Log();
+  log << "[INFO::COUNTERS]";
+  for (std::size_t i = 0; i < Counters::counterCount; ++i)
+  {
+    log << " " << Counters::GetName(static_cast<Counter>(i)) << " " << counters.Get(static_cast<Counter>(i));
+  }
+}
+
+void ToggleCounterRecording()
+{
+  Counters& counters = Counters::Instance();
+  if (!counters.IsRecording())
+  {
+    counters.BeginRecording();
+    Logger::Instance(std::cout).Log() << "[INFO::COUNTERS] Recording started";
+    return;
+  }
+
+  counters.EndRecording();
+  try
+  {
+    counters.WriteCsv(COUNTERS_PATH_CSV);
+    Logger::Instance(std::cout).Log() << "[INFO::COUNTERS] " << counters.GetRecordedFrames() << " frames written to " << COUNTERS_PATH_CSV;
+  }
+  catch (const std::exception& err)
+  {
+    Logger::Instance(std::cerr).Log() << err.what();
+  }
+}
+
+void WriteFrameImage(const Window& window, const char* path)
+{
+  std::vector<unsigned char> pixels{};
+  window.ReadPixels(pixels);
+
+  std::ofstream file{ path, std::ios::binary };
+  if (!file.is_open())
+  {
+    std::ostringstream outStream{};
+    outStream << "[ERROR] Could not write image : " << path;
+    throw std::exception{ outStream.str().c_str() };
+  }
+
+  // binary PPM, rows from the top down
+  const int width  = window.GetWidth();
+  const int height = window.GetHeight();
+  file << "P6\n" << width << " " << height << "\n255\n";
+  for (int y = height - 1; y >= 0; --y)
+  {
+    for (int x = 0; x < width; ++x)
+    {
+      file.write(reinterpret_cast<const char*>(&pixels[(static_cast<std::size_t>(y) * width + x) * 4]), 3);
+    }
+  }
+  Logger::Instance(std::cout).Log() << "[INFO] Frame " << window.GetFrameIndex() << " written to " << path;
+}
+
 template<typename T>
 void ReadFile(const char* filename, std::vector<T>& dest)
 {
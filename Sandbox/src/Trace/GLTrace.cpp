@@ -0,0 +1,343 @@
+#include "GLTrace.h"
+
+#include <sstream>
+#include <cstring>
+
+#include <GL/glew.h>
+
+#include "Core/Draw.h"
+#include "Core/Texture.h"
+
+GLTrace::~GLTrace()
+{
+  End();
+}
+
+void GLTrace::Begin(const char* path)
+{
+  std::lock_guard<std::recursive_mutex> lock{ m_Mutex };
+  if (m_File)
+  {
+    throw std::exception{ "[ERROR::TRACE] Trace already recording" };
+  }
+
+  m_File = std::fopen(path, "wb");
+  if (!m_File)
+  {
+    std::ostringstream outStream{};
+    outStream << "[ERROR::TRACE] Could not open trace file : " << path;
+    throw std::exception{ outStream.str().c_str() };
+  }
+
+  m_Frame = 0;
+  m_CallSites.clear();
+  m_Buffer.clear();
+  m_Buffer.reserve(GLTrace::flushThreshold);
+  WriteBytes(traceMagic, sizeof(traceMagic));
+  Write(traceVersion);
+}
+
+void GLTrace::End()
+{
+  std::lock_guard<std::recursive_mutex> lock{ m_Mutex };
+  if (!m_File)
+  {
+    return;
+  }
+
+  Flush();
+  std::fclose(m_File);
+  m_File = nullptr;
+}
+
+void GLTrace::EndFrame()
+{
+  std::lock_guard<std::recursive_mutex> lock{ m_Mutex };
+  BeginRecord(TraceRecordType::FRAME);
+  Write(m_Frame++);
+  EndRecord();
+
+  if (m_Buffer.size() >= GLTrace::flushThreshold)
+  {
+    Flush();
+  }
+}
+
+void GLTrace::Call(const char* text, const char* file, int line)
+{
+  std::lock_guard<std::recursive_mutex> lock{ m_Mutex };
+  auto it = m_CallSites.find(text);
+  if (it == std::end(m_CallSites))
+  {
+    std::uint32_t id = static_cast<std::uint32_t>(m_CallSites.size());
+    it = m_CallSites.emplace(text, id).first;
+
+    BeginRecord(TraceRecordType::CALL_SITE);
+    Write(id);
+    Write(static_cast<std::int32_t>(line));
+    WriteString(file);
+    WriteString(text);
+    EndRecord();
+  }
+
+  BeginRecord(TraceRecordType::CALL);
+  Write(it->second);
+  EndRecord();
+}
+
+void GLTrace::UseProgram(unsigned int program, bool issued)
+{
+  std::lock_guard<std::recursive_mutex> lock{ m_Mutex };
+  BeginRecord(TraceRecordType::USE_PROGRAM);
+  Write<std::uint8_t>(issued ? 1 : 0);
+  Write<std::uint32_t>(program);
+  EndRecord();
+}
+
+void GLTrace::BindVertexArray(unsigned int vertexArray, bool issued)
+{
+  std::lock_guard<std::recursive_mutex> lock{ m_Mutex };
+  BeginRecord(TraceRecordType::BIND_VERTEX_ARRAY);
+  Write<std::uint8_t>(issued ? 1 : 0);
+  Write<std::uint32_t>(vertexArray);
+  EndRecord();
+}
+
+void GLTrace::BindBuffer(unsigned int target, unsigned int buffer, bool issued)
+{
+  std::lock_guard<std::recursive_mutex> lock{ m_Mutex };
+  BeginRecord(TraceRecordType::BIND_BUFFER);
+  Write<std::uint8_t>(issued ? 1 : 0);
+  Write<std::uint32_t>(target);
+  Write<std::uint32_t>(buffer);
+  EndRecord();
+}
+
+void GLTrace::ActiveTexture(unsigned int unit, bool issued)
+{
+  std::lock_guard<std::recursive_mutex> lock{ m_Mutex };
+  BeginRecord(TraceRecordType::ACTIVE_TEXTURE);
+  Write<std::uint8_t>(issued ? 1 : 0);
+  Write<std::uint32_t>(unit);
+  EndRecord();
+}
+
+void GLTrace::BindTexture(unsigned int unit, unsigned int target, unsigned int texture, bool issued)
+{
+  std::lock_guard<std::recursive_mutex> lock{ m_Mutex };
+  BeginRecord(TraceRecordType::BIND_TEXTURE);
+  Write<std::uint8_t>(issued ? 1 : 0);
+  Write<std::uint32_t>(unit);
+  Write<std::uint32_t>(target);
+  Write<std::uint32_t>(texture);
+  EndRecord();
+}
+
+void GLTrace::BindSampler(unsigned int unit, unsigned int sampler, bool issued)
+{
+  std::lock_guard<std::recursive_mutex> lock{ m_Mutex };
+  BeginRecord(TraceRecordType::BIND_SAMPLER);
+  Write<std::uint8_t>(issued ? 1 : 0);
+  Write<std::uint32_t>(unit);
+  Write<std::uint32_t>(sampler);
+  EndRecord();
+}
+
+void GLTrace::BufferData(unsigned int buffer, unsigned int target, unsigned int usage, std::size_t size, const void* data)
+{
+  std::lock_guard<std::recursive_mutex> lock{ m_Mutex };
+  BeginRecord(TraceRecordType::BUFFER_DATA);
+  Write<std::uint32_t>(buffer);
+  Write<std::uint32_t>(target);
+  Write<std::uint32_t>(usage);
+  Write<std::uint64_t>(size);
+  Write<std::uint8_t>(data ? 1 : 0);
+  if (data)
+  {
+    WriteBytes(data, size);
+  }
+  EndRecord();
+}
+
+void GLTrace::TextureStorage(unsigned int texture, unsigned int target, int levels, unsigned int internalFormat, int width, int height)
+{
+  std::lock_guard<std::recursive_mutex> lock{ m_Mutex };
+  BeginRecord(TraceRecordType::TEXTURE_STORAGE);
+  Write<std::uint32_t>(texture);
+  Write<std::uint32_t>(target);
+  Write<std::int32_t>(levels);
+  Write<std::uint32_t>(internalFormat);
+  Write<std::int32_t>(width);
+  Write<std::int32_t>(height);
+  EndRecord();
+}
+
+void GLTrace::TextureLevel(unsigned int texture, int level, int width, int height, unsigned int format, unsigned int dataType, const void* data)
+{
+  std::lock_guard<std::recursive_mutex> lock{ m_Mutex };
+  std::size_t size = data ? static_cast<std::size_t>(width) * height * Texture::GetTexelSize(format, dataType) : 0;
+
+  BeginRecord(TraceRecordType::TEXTURE_LEVEL);
+  Write<std::uint32_t>(texture);
+  Write<std::int32_t>(level);
+  Write<std::int32_t>(width);
+  Write<std::int32_t>(height);
+  Write<std::uint32_t>(format);
+  Write<std::uint32_t>(dataType);
+  Write<std::uint64_t>(size);
+  WriteBytes(data, size);
+  EndRecord();
+}
+
+void GLTrace::GenerateMipmap(unsigned int texture)
+{
+  std::lock_guard<std::recursive_mutex> lock{ m_Mutex };
+  BeginRecord(TraceRecordType::GENERATE_MIPMAP);
+  Write<std::uint32_t>(texture);
+  EndRecord();
+}
+
+void GLTrace::Sampler(unsigned int sampler, const std::map<int, int>& parameters)
+{
+  std::lock_guard<std::recursive_mutex> lock{ m_Mutex };
+  BeginRecord(TraceRecordType::SAMPLER);
+  Write<std::uint32_t>(sampler);
+  Write<std::uint32_t>(static_cast<std::uint32_t>(parameters.size()));
+  for (const auto& parameter : parameters)
+  {
+    Write<std::int32_t>(parameter.first);
+    Write<std::int32_t>(parameter.second);
+  }
+  EndRecord();
+}
+
+void GLTrace::ShaderSource(unsigned int shader, unsigned int type, const std::string& source)
+{
+  std::lock_guard<std::recursive_mutex> lock{ m_Mutex };
+  BeginRecord(TraceRecordType::SHADER_SOURCE);
+  Write<std::uint32_t>(shader);
+  Write<std::uint32_t>(type);
+  WriteString(source.c_str());
+  EndRecord();
+}
+
+void GLTrace::ProgramLink(unsigned int program, const unsigned int* shaders, std::size_t count)
+{
+  std::lock_guard<std::recursive_mutex> lock{ m_Mutex };
+  BeginRecord(TraceRecordType::PROGRAM_LINK);
+  Write<std::uint32_t>(program);
+  Write<std::uint32_t>(static_cast<std::uint32_t>(count));
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    Write<std::uint32_t>(shaders[i]);
+  }
+  EndRecord();
+}
+
+void GLTrace::VertexAttribute(unsigned int vertexArray, unsigned int location, unsigned int buffer, std::int64_t offset, int stride, int size, unsigned int type, bool normalized, bool integer, unsigned int divisor)
+{
+  std::lock_guard<std::recursive_mutex> lock{ m_Mutex };
+  BeginRecord(TraceRecordType::VERTEX_ATTRIBUTE);
+  Write<std::uint32_t>(vertexArray);
+  Write<std::uint32_t>(location);
+  Write<std::uint32_t>(buffer);
+  Write<std::int64_t>(offset);
+  Write<std::int32_t>(stride);
+  Write<std::int32_t>(size);
+  Write<std::uint32_t>(type);
+  Write<std::uint8_t>(normalized ? 1 : 0);
+  Write<std::uint8_t>(integer ? 1 : 0);
+  Write<std::uint32_t>(divisor);
+  EndRecord();
+}
+
+void GLTrace::IndexBuffer(unsigned int vertexArray, unsigned int buffer)
+{
+  std::lock_guard<std::recursive_mutex> lock{ m_Mutex };
+  BeginRecord(TraceRecordType::INDEX_BUFFER);
+  Write<std::uint32_t>(vertexArray);
+  Write<std::uint32_t>(buffer);
+  EndRecord();
+}
+
+void GLTrace::Uniform(unsigned int location, TraceUniformType type, int count, const void* value)
+{
+  std::size_t components = 1;
+  switch (type)
+  {
+  case TraceUniformType::VEC3:           components = 3;  break;
+  case TraceUniformType::MAT4:
+  case TraceUniformType::MAT4_TRANSPOSE: components = 16; break;
+  default:                                                break;
+  }
+
+  std::lock_guard<std::recursive_mutex> lock{ m_Mutex };
+  BeginRecord(TraceRecordType::UNIFORM);
+  Write<std::uint32_t>(location);
+  Write(type);
+  Write<std::int32_t>(count);
+  WriteBytes(value, components * count * 4);
+  EndRecord();
+}
+
+void GLTrace::Draw(unsigned int mode, int first, int count, unsigned int indexType, std::int64_t indexOffset, int instances, int baseVertex, unsigned int baseInstance)
+{
+  std::lock_guard<std::recursive_mutex> lock{ m_Mutex };
+  BeginRecord(TraceRecordType::DRAW);
+  Write<std::uint32_t>(mode);
+  Write<std::int32_t>(first);
+  Write<std::int32_t>(count);
+  Write<std::uint32_t>(indexType);
+  Write<std::int64_t>(indexOffset);
+  Write<std::int32_t>(instances);
+  Write<std::int32_t>(baseVertex);
+  Write<std::uint32_t>(baseInstance);
+  EndRecord();
+}
+
+void GLTrace::MultiDrawIndirect(unsigned int mode, unsigned int indexType, const DrawElementsIndirectCommand* commands, int drawCount, std::int64_t indirectOffset)
+{
+  std::lock_guard<std::recursive_mutex> lock{ m_Mutex };
+  BeginRecord(TraceRecordType::MULTI_DRAW_INDIRECT);
+  Write<std::uint32_t>(mode);
+  Write<std::uint32_t>(indexType);
+  Write<std::int32_t>(drawCount);
+  Write<std::int64_t>(indirectOffset);
+  WriteBytes(commands, static_cast<std::size_t>(drawCount) * sizeof(DrawElementsIndirectCommand));
+  EndRecord();
+}
+
+void GLTrace::BeginRecord(TraceRecordType type)
+{
+  Write(type);
+  m_RecordStart = m_Buffer.size();
+  Write<std::uint32_t>(0);
+}
+
+void GLTrace::EndRecord()
+{
+  std::uint32_t size = static_cast<std::uint32_t>(m_Buffer.size() - m_RecordStart - sizeof(std::uint32_t));
+  std::memcpy(m_Buffer.data() + m_RecordStart, &size, sizeof(size));
+}
+
+void GLTrace::WriteBytes(const void* data, std::size_t size)
+{
+  const unsigned char* bytes = static_cast<const unsigned char*>(data);
+  m_Buffer.insert(std::end(m_Buffer), bytes, bytes + size);
+}
+
+void GLTrace::WriteString(const char* text)
+{
+  std::uint32_t length = static_cast<std::uint32_t>(std::strlen(text));
+  Write(length);
+  WriteBytes(text, length);
+}
+
+void GLTrace::Flush()
+{
+  if (m_File && !m_Buffer.empty())
+  {
+    std::fwrite(m_Buffer.data(), 1, m_Buffer.size(), m_File);
+  }
+  m_Buffer.clear();
+}
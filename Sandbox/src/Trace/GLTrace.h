@@ -0,0 +1,101 @@
+#pragma once
+
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <cstdio>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+
+#include "Trace/TraceFormat.h"
+
+struct DrawElementsIndirectCommand;
+
+// capture hooks compile to nothing unless GL_TRACE is defined
+#ifdef GL_TRACE
+#define GL_TRACE_RECORD(x) do { if (GLTrace::Instance().IsRecording()) GLTrace::Instance().x; } while (0)
+#else
+#define GL_TRACE_RECORD(x)
+#endif
+
+// binary capture of one context, two kinds of records:
+//   call sites : the text of every CALL expression and how often it ran, no argument values, analysis only
+//   typed      : GL_TRACE_RECORD sites with their arguments and payloads (binds, uploads, samplers, shaders,
+//                vertex setup, uniforms, draws), the only records TraceTool replays
+class GLTrace {
+public:
+  static GLTrace& Instance() {
+    static GLTrace instance{};
+    return instance;
+  }
+
+  ~GLTrace();
+
+  void Begin(const char* path);
+  void End();
+
+  inline bool IsRecording() const
+  {
+    return m_File != nullptr;
+  }
+
+  void EndFrame();
+  // TRACE_CALL, counts the site, nothing a replay could execute
+  void Call(const char* text, const char* file, int line);
+
+  // every bind requested from GLStateCache, issued is false for those it skipped as redundant
+  void UseProgram(unsigned int program, bool issued);
+  void BindVertexArray(unsigned int vertexArray, bool issued);
+  void BindBuffer(unsigned int target, unsigned int buffer, bool issued);
+  void ActiveTexture(unsigned int unit, bool issued);
+  void BindTexture(unsigned int unit, unsigned int target, unsigned int texture, bool issued);
+  void BindSampler(unsigned int unit, unsigned int sampler, bool issued);
+
+  void BufferData(unsigned int buffer, unsigned int target, unsigned int usage, std::size_t size, const void* data);
+  void TextureStorage(unsigned int texture, unsigned int target, int levels, unsigned int internalFormat, int width, int height);
+  void TextureLevel(unsigned int texture, int level, int width, int height, unsigned int format, unsigned int dataType, const void* data);
+  void GenerateMipmap(unsigned int texture);
+  void Sampler(unsigned int sampler, const std::map<int, int>& parameters);
+
+  void ShaderSource(unsigned int shader, unsigned int type, const std::string& source);
+  void ProgramLink(unsigned int program, const unsigned int* shaders, std::size_t count);
+
+  void VertexAttribute(unsigned int vertexArray, unsigned int location, unsigned int buffer, std::int64_t offset, int stride, int size, unsigned int type, bool normalized, bool integer, unsigned int divisor);
+  void IndexBuffer(unsigned int vertexArray, unsigned int buffer);
+  void Uniform(unsigned int location, TraceUniformType type, int count, const void* value);
+
+  void Draw(unsigned int mode, int first, int count, unsigned int indexType, std::int64_t indexOffset, int instances, int baseVertex, unsigned int baseInstance);
+  // one record per call, the commands are a copy of what the bound GL_DRAW_INDIRECT_BUFFER holds at indirectOffset
+  void MultiDrawIndirect(unsigned int mode, unsigned int indexType, const DrawElementsIndirectCommand* commands, int drawCount, std::int64_t indirectOffset);
+
+  GLTrace(const GLTrace&) = delete;
+  GLTrace& operator=(const GLTrace&) = delete;
+
+private:
+  GLTrace() = default;
+
+  void BeginRecord(TraceRecordType type);
+  void EndRecord();
+
+  template <typename T>
+  void Write(const T& value)
+  {
+    WriteBytes(&value, sizeof(T));
+  }
+  void WriteBytes(const void* data, std::size_t size);
+  void WriteString(const char* text);
+  void Flush();
+
+  static constexpr std::size_t flushThreshold = 4 * 1024 * 1024;
+
+  std::recursive_mutex m_Mutex{};
+  std::FILE* m_File = nullptr;
+  std::vector<unsigned char> m_Buffer{};
+  std::size_t m_RecordStart = 0;
+  std::uint32_t m_Frame     = 0;
+
+  // string literal addresses identify call sites, each site is written out once
+  std::unordered_map<const char*, std::uint32_t> m_CallSites{};
+};
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstdint>
+
+// every record is [u8 type][u32 payload size][payload], integers little endian as written by the capturing machine
+enum class TraceRecordType
+  : std::uint8_t
+{
+  FRAME,
+  CALL_SITE,
+  CALL,
+  // bind records start with a u8 issued flag, 0 for requests GLStateCache filtered out before they reached GL
+  USE_PROGRAM,
+  BIND_VERTEX_ARRAY,
+  BIND_BUFFER,
+  ACTIVE_TEXTURE,
+  BIND_TEXTURE,
+  BIND_SAMPLER,
+  BUFFER_DATA,
+  TEXTURE_STORAGE,
+  TEXTURE_LEVEL,
+  GENERATE_MIPMAP,
+  SAMPLER,
+  SHADER_SOURCE,
+  PROGRAM_LINK,
+  VERTEX_ATTRIBUTE,
+  INDEX_BUFFER,
+  UNIFORM,
+  DRAW,
+  MULTI_DRAW_INDIRECT,
+  COUNT
+};
+
+enum class TraceUniformType
+  : std::uint8_t
+{
+  INT,
+  FLOAT,
+  VEC3,
+  MAT4,
+  MAT4_TRANSPOSE
+};
+
+constexpr char          traceMagic[4] = { 'G', 'L', 'T', 'R' };
+constexpr std::uint32_t traceVersion  = 5;
@@ -0,0 +1,73 @@
+#include "TraceReader.h"
+
+#include <sstream>
+
+const unsigned char* TraceRecord::ReadBytes(std::size_t size)
+{
+  if (cursor + size > payload.size())
+  {
+    throw std::exception{ "[ERROR::TRACE] Record payload truncated" };
+  }
+
+  const unsigned char* bytes = payload.data() + cursor;
+  cursor += size;
+  return bytes;
+}
+
+std::string TraceRecord::ReadString()
+{
+  std::uint32_t length = Read<std::uint32_t>();
+  const char* text = reinterpret_cast<const char*>(ReadBytes(length));
+  return std::string{ text, text + length };
+}
+
+TraceReader::TraceReader(const char* path) :
+  m_File{ path             },
+  m_Data{ m_File.GetData() },
+  m_Size{ m_File.GetSize() }
+{
+  std::uint32_t version = 0;
+  if (m_Size < sizeof(traceMagic) + sizeof(version) || std::memcmp(m_Data, traceMagic, sizeof(traceMagic)) != 0)
+  {
+    std::ostringstream outStream{};
+    outStream << "[ERROR::TRACE] Not a trace file : " << path;
+    throw std::exception{ outStream.str().c_str() };
+  }
+
+  std::memcpy(&version, m_Data + sizeof(traceMagic), sizeof(version));
+  if (version != traceVersion)
+  {
+    std::ostringstream outStream{};
+    outStream << "[ERROR::TRACE] Unsupported trace version " << version << " : " << path;
+    throw std::exception{ outStream.str().c_str() };
+  }
+
+  m_Offset = sizeof(traceMagic) + sizeof(version);
+}
+
+TraceReader::~TraceReader()
+{
+}
+
+bool TraceReader::Next(TraceRecord& record)
+{
+  std::uint32_t size = 0;
+  if (m_Offset + sizeof(TraceRecordType) + sizeof(size) > m_Size)
+  {
+    return false;
+  }
+
+  record.type = static_cast<TraceRecordType>(m_Data[m_Offset]);
+  std::memcpy(&size, m_Data + m_Offset + sizeof(TraceRecordType), sizeof(size));
+  m_Offset += sizeof(TraceRecordType) + sizeof(size);
+
+  if (m_Offset + size > m_Size || record.type >= TraceRecordType::COUNT)
+  {
+    throw std::exception{ "[ERROR::TRACE] Trace file truncated or corrupt" };
+  }
+
+  record.payload.assign(m_Data + m_Offset, m_Data + m_Offset + size);
+  record.cursor = 0;
+  m_Offset += size;
+  return true;
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "Trace/TraceFormat.h"
+
+#include "Utility/MappedFile/MappedFile.h"
+
+struct TraceRecord {
+  TraceRecordType type = TraceRecordType::COUNT;
+  std::vector<unsigned char> payload{};
+  std::size_t cursor = 0;
+
+  template <typename T>
+  T Read()
+  {
+    T value{};
+    std::memcpy(&value, ReadBytes(sizeof(T)), sizeof(T));
+    return value;
+  }
+
+  const unsigned char* ReadBytes(std::size_t size);
+  std::string ReadString();
+};
+
+// sequential reader over a GLTrace capture, the file is mapped and records are copied out one at a time
+class TraceReader {
+public:
+  TraceReader(const char* path);
+  ~TraceReader();
+
+  bool Next(TraceRecord& record);
+
+  inline std::size_t GetSize() const {
+    return m_Size;
+  }
+
+  TraceReader(const TraceReader&) = delete;
+  TraceReader& operator=(const TraceReader&) = delete;
+
+private:
+  MappedFile m_File;
+  const unsigned char* m_Data = nullptr;
+  std::size_t m_Size          = 0;
+  std::size_t m_Offset        = 0;
+};
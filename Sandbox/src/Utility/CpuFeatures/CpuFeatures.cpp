@@ -0,0 +1,89 @@
+#include "CpuFeatures.h"
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#include <immintrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#endif
+
+namespace {
+  struct Features {
+    bool sse41 = false;
+    bool avx2  = false;
+  };
+
+  void Cpuid(int leaf, int subleaf, int registers[4])
+  {
+#if defined(_MSC_VER)
+    __cpuidex(registers, leaf, subleaf);
+#elif defined(__x86_64__) || defined(__i386__)
+    unsigned int eax = 0, ebx = 0, ecx = 0, edx = 0;
+    __cpuid_count(leaf, subleaf, eax, ebx, ecx, edx);
+    registers[0] = static_cast<int>(eax);
+    registers[1] = static_cast<int>(ebx);
+    registers[2] = static_cast<int>(ecx);
+    registers[3] = static_cast<int>(edx);
+#else
+    registers[0] = registers[1] = registers[2] = registers[3] = 0;
+    (void)leaf;
+    (void)subleaf;
+#endif
+  }
+
+  unsigned long long ExtendedControlRegister()
+  {
+#if defined(_MSC_VER)
+    return _xgetbv(0);
+#elif defined(__x86_64__) || defined(__i386__)
+    unsigned int eax = 0, edx = 0;
+    __asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+    return static_cast<unsigned long long>(edx) << 32 | eax;
+#else
+    return 0;
+#endif
+  }
+
+  Features Detect()
+  {
+    Features features{};
+
+    int registers[4]{};
+    Cpuid(0, 0, registers);
+    int maxLeaf = registers[0];
+    if (maxLeaf < 1)
+    {
+      return features;
+    }
+
+    Cpuid(1, 0, registers);
+    features.sse41 = (registers[2] & (1 << 19)) != 0;
+
+    // AVX state has to be enabled by the OS (OSXSAVE + XMM/YMM in XCR0) before AVX2 is usable
+    bool osxsave = (registers[2] & (1 << 27)) != 0;
+    bool avx     = (registers[2] & (1 << 28)) != 0;
+    if (maxLeaf >= 7 && osxsave && avx && (ExtendedControlRegister() & 0x6) == 0x6)
+    {
+      Cpuid(7, 0, registers);
+      features.avx2 = (registers[1] & (1 << 5)) != 0;
+    }
+
+    return features;
+  }
+
+  const Features& GetFeatures()
+  {
+    static const Features features = Detect();
+    return features;
+  }
+}
+
+bool HasSSE41()
+{
+  return GetFeatures().sse41;
+}
+
+bool HasAVX2()
+{
+  return GetFeatures().avx2;
+}
@@ -0,0 +1,5 @@
+#pragma once
+
+// runtime instruction set detection, results are computed once
+bool HasSSE41();
+bool HasAVX2();
@@ -0,0 +1,168 @@
+#include "DecodeBufferPool.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+
+DecodeBufferPool::~DecodeBufferPool()
+{
+  Trim();
+}
+
+void* DecodeBufferPool::Allocate(std::size_t size)
+{
+  std::size_t sizeClass = SizeClass(size);
+  if (sizeClass >= DecodeBufferPool::classCount)
+  {
+    return nullptr;
+  }
+
+  Header* header = nullptr;
+  {
+    std::lock_guard<std::mutex> lock{ m_Mutex };
+
+    // a slightly larger retained block beats a fresh allocation, otherwise every
+    // distinct image size would pin its own set of blocks
+    std::size_t lastClass = std::min(sizeClass + DecodeBufferPool::maxClassOvershoot, DecodeBufferPool::classCount - 1);
+    for (std::size_t candidate = sizeClass; candidate <= lastClass && !header; ++candidate)
+    {
+      std::vector<Header*>& freeList = m_FreeLists[candidate];
+      if (!freeList.empty())
+      {
+        header = freeList.back();
+        freeList.pop_back();
+        sizeClass = candidate;
+        m_Statistics.retainedBytes -= ClassBytes(sizeClass);
+        ++m_Statistics.reuses;
+      }
+    }
+
+    if (!header)
+    {
+      ++m_Statistics.allocations;
+    }
+
+    m_LiveBytes += ClassBytes(sizeClass);
+    m_Statistics.peakBytes = std::max(m_Statistics.peakBytes, m_LiveBytes + m_Statistics.retainedBytes);
+  }
+
+  if (!header)
+  {
+    header = static_cast<Header*>(std::malloc(sizeof(Header) + ClassBytes(sizeClass)));
+    if (!header)
+    {
+      std::lock_guard<std::mutex> lock{ m_Mutex };
+      m_LiveBytes -= ClassBytes(sizeClass);
+      return nullptr;
+    }
+    header->sizeClass = sizeClass;
+  }
+
+  return header + 1;
+}
+
+void* DecodeBufferPool::Reallocate(void* block, std::size_t size)
+{
+  if (!block)
+  {
+    return Allocate(size);
+  }
+
+  Header* header = static_cast<Header*>(block) - 1;
+  if (size <= ClassBytes(header->sizeClass))
+  {
+    return block;
+  }
+
+  void* grown = Allocate(size);
+  if (grown)
+  {
+    std::memcpy(grown, block, ClassBytes(header->sizeClass));
+    Free(block);
+  }
+  return grown;
+}
+
+void DecodeBufferPool::Free(void* block)
+{
+  if (!block)
+  {
+    return;
+  }
+
+  Header* header = static_cast<Header*>(block) - 1;
+  std::size_t bytes = ClassBytes(header->sizeClass);
+
+  {
+    std::lock_guard<std::mutex> lock{ m_Mutex };
+    m_LiveBytes -= bytes;
+    if (m_Statistics.retainedBytes + bytes <= m_RetainLimit)
+    {
+      m_FreeLists[header->sizeClass].push_back(header);
+      m_Statistics.retainedBytes += bytes;
+      return;
+    }
+  }
+
+  std::free(header);
+}
+
+void DecodeBufferPool::SetRetainLimit(std::size_t bytes)
+{
+  {
+    std::lock_guard<std::mutex> lock{ m_Mutex };
+    m_RetainLimit = bytes;
+  }
+  Trim();
+}
+
+void DecodeBufferPool::Trim()
+{
+  std::lock_guard<std::mutex> lock{ m_Mutex };
+  for (std::vector<Header*>& freeList : m_FreeLists)
+  {
+    for (Header* header : freeList)
+    {
+      std::free(header);
+    }
+    freeList.clear();
+    freeList.shrink_to_fit();
+  }
+  m_Statistics.retainedBytes = 0;
+}
+
+DecodeBufferPool::Statistics DecodeBufferPool::GetStatistics() const
+{
+  std::lock_guard<std::mutex> lock{ m_Mutex };
+  return m_Statistics;
+}
+
+std::size_t DecodeBufferPool::SizeClass(std::size_t size)
+{
+  std::size_t sizeClass = 0;
+  while (sizeClass < DecodeBufferPool::classCount && ClassBytes(sizeClass) < size)
+  {
+    ++sizeClass;
+  }
+  return sizeClass;
+}
+
+std::size_t DecodeBufferPool::ClassBytes(std::size_t sizeClass)
+{
+  return std::size_t{ 1 } << (sizeClass + DecodeBufferPool::minClassShift);
+}
+
+void* DecodeBufferAllocate(std::size_t size)
+{
+  return DecodeBufferPool::Instance().Allocate(size);
+}
+
+void* DecodeBufferReallocate(void* block, std::size_t size)
+{
+  return DecodeBufferPool::Instance().Reallocate(block, size);
+}
+
+void DecodeBufferFree(void* block)
+{
+  DecodeBufferPool::Instance().Free(block);
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <array>
+#include <vector>
+#include <mutex>
+#include <cstddef>
+
+class DecodeBufferPool {
+public:
+  struct Statistics {
+    std::size_t allocations   = 0;
+    std::size_t reuses        = 0;
+    std::size_t retainedBytes = 0;
+    std::size_t peakBytes     = 0;
+  };
+
+  static DecodeBufferPool& Instance() {
+    static DecodeBufferPool instance{};
+    return instance;
+  }
+
+  ~DecodeBufferPool();
+
+  void* Allocate(std::size_t size);
+  void* Reallocate(void* block, std::size_t size);
+  void Free(void* block);
+
+  void SetRetainLimit(std::size_t bytes);
+  void Trim();
+
+  Statistics GetStatistics() const;
+
+  DecodeBufferPool(const DecodeBufferPool&) = delete;
+  DecodeBufferPool& operator=(const DecodeBufferPool&) = delete;
+
+private:
+  DecodeBufferPool() = default;
+
+  // every block is prefixed with its size class so Free/Reallocate need no lookup
+  struct alignas(16) Header {
+    std::size_t sizeClass;
+  };
+
+  static std::size_t SizeClass(std::size_t size);
+  static std::size_t ClassBytes(std::size_t sizeClass);
+
+  static constexpr std::size_t minClassShift       = 6;  // 64 B
+  static constexpr std::size_t classCount          = 26; // up to 2 GB
+  static constexpr std::size_t maxClassOvershoot   = 2;
+  static constexpr std::size_t defaultRetainLimit  = 32 * 1024 * 1024;
+
+  mutable std::mutex m_Mutex{};
+  std::array<std::vector<Header*>, classCount> m_FreeLists{};
+  std::size_t m_RetainLimit = DecodeBufferPool::defaultRetainLimit;
+  std::size_t m_LiveBytes   = 0;
+  Statistics m_Statistics{};
+};
+
+// hooks for stb_image, see Vendor/stb_image/stb_image.cpp
+void* DecodeBufferAllocate(std::size_t size);
+void* DecodeBufferReallocate(void* block, std::size_t size);
+void DecodeBufferFree(void* block);
@@ -0,0 +1,96 @@
+#include "MappedFile.h"
+
+#include <sstream>
+#include <exception>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+MappedFile::MappedFile(const char* path)
+{
+#ifdef _WIN32
+  HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+  LARGE_INTEGER size{};
+  if (file != INVALID_HANDLE_VALUE && GetFileSizeEx(file, &size) && size.QuadPart > 0)
+  {
+    m_File = file;
+    m_Size = static_cast<std::size_t>(size.QuadPart);
+    m_Mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (m_Mapping)
+    {
+      m_Data = static_cast<const unsigned char*>(MapViewOfFile(m_Mapping, FILE_MAP_READ, 0, 0, 0));
+    }
+  }
+  else if (file != INVALID_HANDLE_VALUE)
+  {
+    CloseHandle(file);
+  }
+#else
+  m_File = open(path, O_RDONLY);
+  struct stat info{};
+  if (m_File != -1 && fstat(m_File, &info) == 0 && info.st_size > 0)
+  {
+    m_Size = static_cast<std::size_t>(info.st_size);
+    void* data = mmap(nullptr, m_Size, PROT_READ, MAP_PRIVATE, m_File, 0);
+    if (data != MAP_FAILED)
+    {
+      madvise(data, m_Size, MADV_SEQUENTIAL);
+      m_Data = static_cast<const unsigned char*>(data);
+    }
+  }
+#endif
+
+  if (!m_Data)
+  {
+    Dispose();
+    std::ostringstream outStream{};
+    outStream << "[ERROR] Could not map file : " << path;
+    throw std::exception{ outStream.str().c_str() };
+  }
+}
+
+MappedFile::~MappedFile()
+{
+  Dispose();
+}
+
+void MappedFile::Dispose()
+{
+#ifdef _WIN32
+  if (m_Data)
+  {
+    UnmapViewOfFile(m_Data);
+  }
+  if (m_Mapping)
+  {
+    CloseHandle(m_Mapping);
+    m_Mapping = nullptr;
+  }
+  if (m_File)
+  {
+    CloseHandle(m_File);
+    m_File = nullptr;
+  }
+#else
+  if (m_Data)
+  {
+    munmap(const_cast<unsigned char*>(m_Data), m_Size);
+  }
+  if (m_File != -1)
+  {
+    close(m_File);
+    m_File = -1;
+  }
+#endif
+
+  m_Data = nullptr;
+  m_Size = 0;
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstddef>
+
+class MappedFile {
+public:
+  MappedFile(const char* path);
+  ~MappedFile();
+
+  inline const unsigned char* GetData() const
+  {
+    return m_Data;
+  }
+
+  inline std::size_t GetSize() const
+  {
+    return m_Size;
+  }
+
+  void Dispose();
+
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+private:
+  const unsigned char* m_Data = nullptr;
+  std::size_t m_Size          = 0;
+
+#ifdef _WIN32
+  void* m_File    = nullptr;
+  void* m_Mapping = nullptr;
+#else
+  int m_File      = -1;
+#endif
+};
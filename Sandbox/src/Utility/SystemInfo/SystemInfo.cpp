@@ -4,6 +4,16 @@
 
 #include <GL/glew.h>
 
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#define PSAPI_VERSION 2
+#include <Windows.h>
+#include <Psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
 #include "Core/Core.h"
 #include "Logging/Logger.h"
 
@@ -52,4 +62,19 @@ void SystemInfo() {
   unsigned char flag = 0;
   CALL(glGetBooleanv(params[11], &flag));
   Logger::Instance(std::cout).Log() << "[INFO::GL] " << string_rep[11] << " : " << (flag > 0 ? 1 : 0);
+}
+
+std::size_t PeakResidentSetSize() {
+#ifdef _WIN32
+  PROCESS_MEMORY_COUNTERS counters{};
+  if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+  {
+    return static_cast<std::size_t>(counters.PeakWorkingSetSize);
+  }
+  return 0;
+#else
+  rusage usage{};
+  getrusage(RUSAGE_SELF, &usage);
+  return static_cast<std::size_t>(usage.ru_maxrss) * 1024;
+#endif
 }
\ No newline at end of file
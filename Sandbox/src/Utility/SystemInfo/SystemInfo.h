@@ -1,3 +1,7 @@
 #pragma once
 
-void SystemInfo();
\ No newline at end of file
+#include <cstddef>
+
+void SystemInfo();
+
+std::size_t PeakResidentSetSize();
\ No newline at end of file
@@ -1,2 +1,8 @@
+#include "Utility/DecodeBufferPool/DecodeBufferPool.h"
+
+#define STBI_MALLOC(size)           DecodeBufferAllocate(size)
+#define STBI_REALLOC(block, size)   DecodeBufferReallocate(block, size)
+#define STBI_FREE(block)            DecodeBufferFree(block)
+
 #define STB_IMAGE_IMPLEMENTATION
-#include "stb_image.h"
\ No newline at end of file
+#include "stb_image.h"
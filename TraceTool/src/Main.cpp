@@ -0,0 +1,88 @@
+#include <string>
+#include <memory>
+#include <iostream>
+
+#include <GL/glew.h>
+#include <GLFW/glfw3.h>
+
+#include "Core/Core.h"
+#include "Core/Window.h"
+
+#include "Logging/Logger.h"
+
+#include "Trace/TraceReader.h"
+
+#include "TraceAnalyzer.h"
+#include "TraceReplayer.h"
+
+// TraceTool <trace> [--frames] [--replay]
+//   analysis runs headless, --replay additionally re-executes the capture in a window and reports frame times
+int main(int argc, char** argv)
+{
+  if (argc < 2)
+  {
+    Logger::Instance(std::cerr).Log() << "[ERROR] Usage : TraceTool <trace> [--frames] [--replay]";
+    return EXIT_FAILURE;
+  }
+
+  bool perFrame = false;
+  bool replay   = false;
+  for (int i = 2; i < argc; ++i)
+  {
+    std::string option{ argv[i] };
+    if (option == "--frames")
+    {
+      perFrame = true;
+    }
+    else if (option == "--replay")
+    {
+      replay = true;
+    }
+    else
+    {
+      Logger::Instance(std::cerr).Log() << "[ERROR] Unknown option : " << option;
+      return EXIT_FAILURE;
+    }
+  }
+
+  std::unique_ptr<Window> window{};
+  std::unique_ptr<TraceReplayer> replayer{};
+  try
+  {
+    if (replay)
+    {
+      window = std::make_unique<Window>("TraceTool", 800, 600);
+      window->Initialize();
+      replayer = std::make_unique<TraceReplayer>(*window);
+    }
+
+    TraceReader reader{ argv[1] };
+    Logger::Instance(std::cout).Log() << "[TRACE] " << argv[1] << " : " << reader.GetSize() << " B";
+
+    TraceAnalyzer analyzer{};
+    TraceRecord record{};
+    while (reader.Next(record))
+    {
+      analyzer.Process(record);
+      if (replayer && !window->ShouldClose())
+      {
+        record.cursor = 0;
+        replayer->Process(record);
+      }
+    }
+
+    analyzer.Report(perFrame);
+    if (replayer)
+    {
+      replayer->Report();
+      replayer->Dispose();
+    }
+  }
+  catch (const std::exception& err)
+  {
+    Logger::Instance(std::cerr).Log() << err.what();
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,257 @@
+#include "TraceAnalyzer.h"
+
+#include <algorithm>
+#include <iostream>
+#include <iomanip>
+
+#include <GL/glew.h>
+
+#include "Core/Draw.h"
+
+#include "Logging/Logger.h"
+
+namespace {
+  enum class BindingKind : std::uint64_t {
+    PROGRAM,
+    VERTEX_ARRAY,
+    BUFFER,
+    ACTIVE_TEXTURE,
+    TEXTURE,
+    SAMPLER
+  };
+
+  std::uint64_t BindingKey(BindingKind kind, std::uint64_t index = 0)
+  {
+    return static_cast<std::uint64_t>(kind) << 56 | index;
+  }
+}
+
+void TraceAnalyzer::Process(TraceRecord& record)
+{
+  switch (record.type)
+  {
+  case TraceRecordType::FRAME:
+    m_Frames.push_back(m_Current);
+    m_Current = FrameStatistics{};
+    break;
+  case TraceRecordType::CALL_SITE:
+  {
+    std::uint32_t id = record.Read<std::uint32_t>();
+    CallSite& callSite = m_CallSites[id];
+    callSite.line = record.Read<std::int32_t>();
+    callSite.file = record.ReadString();
+    callSite.text = record.ReadString();
+    break;
+  }
+  case TraceRecordType::CALL:
+    ++m_Current.calls;
+    ++m_CallSites[record.Read<std::uint32_t>()].count;
+    break;
+  case TraceRecordType::USE_PROGRAM:
+  {
+    bool issued = record.Read<std::uint8_t>() != 0;
+    m_Program = record.Read<std::uint32_t>();
+    ChangeState(BindingKey(BindingKind::PROGRAM), m_Program, issued);
+    break;
+  }
+  case TraceRecordType::BIND_VERTEX_ARRAY:
+  {
+    bool issued = record.Read<std::uint8_t>() != 0;
+    ChangeState(BindingKey(BindingKind::VERTEX_ARRAY), record.Read<std::uint32_t>(), issued);
+    break;
+  }
+  case TraceRecordType::BIND_BUFFER:
+  {
+    bool issued = record.Read<std::uint8_t>() != 0;
+    std::uint32_t target = record.Read<std::uint32_t>();
+    ChangeState(BindingKey(BindingKind::BUFFER, target), record.Read<std::uint32_t>(), issued);
+    break;
+  }
+  case TraceRecordType::ACTIVE_TEXTURE:
+  {
+    bool issued = record.Read<std::uint8_t>() != 0;
+    ChangeState(BindingKey(BindingKind::ACTIVE_TEXTURE), record.Read<std::uint32_t>(), issued);
+    break;
+  }
+  case TraceRecordType::BIND_TEXTURE:
+  {
+    bool issued = record.Read<std::uint8_t>() != 0;
+    std::uint64_t unit   = record.Read<std::uint32_t>();
+    std::uint64_t target = record.Read<std::uint32_t>();
+    ChangeState(BindingKey(BindingKind::TEXTURE, unit << 32 | target), record.Read<std::uint32_t>(), issued);
+    break;
+  }
+  case TraceRecordType::BIND_SAMPLER:
+  {
+    bool issued = record.Read<std::uint8_t>() != 0;
+    std::uint32_t unit = record.Read<std::uint32_t>();
+    ChangeState(BindingKey(BindingKind::SAMPLER, unit), record.Read<std::uint32_t>(), issued);
+    break;
+  }
+  case TraceRecordType::BUFFER_DATA:
+    record.ReadBytes(3 * sizeof(std::uint32_t));
+    m_Current.bufferUploadBytes += static_cast<std::size_t>(record.Read<std::uint64_t>());
+    break;
+  case TraceRecordType::TEXTURE_LEVEL:
+    record.ReadBytes(6 * sizeof(std::uint32_t));
+    m_Current.textureUploadBytes += static_cast<std::size_t>(record.Read<std::uint64_t>());
+    break;
+  case TraceRecordType::UNIFORM:
+  {
+    std::uint32_t location = record.Read<std::uint32_t>();
+    std::vector<unsigned char> value{ std::begin(record.payload) + record.cursor, std::end(record.payload) };
+
+    ++m_Current.uniforms;
+    auto& stored = m_Uniforms[{ m_Program, location }];
+    if (stored == value)
+    {
+      ++m_Current.redundantUniforms;
+    }
+    stored = std::move(value);
+    break;
+  }
+  case TraceRecordType::DRAW:
+    record.ReadBytes(4 * sizeof(std::uint32_t) + sizeof(std::int64_t));
+    ++m_Current.draws;
+    m_Current.instances += record.Read<std::int32_t>();
+    break;
+  case TraceRecordType::MULTI_DRAW_INDIRECT:
+  {
+    record.ReadBytes(2 * sizeof(std::uint32_t));
+    std::int32_t drawCount = record.Read<std::int32_t>();
+    record.Read<std::int64_t>();
+
+    ++m_Current.draws;
+    m_Current.indirectCommands += drawCount;
+    for (std::int32_t i = 0; i < drawCount; ++i)
+    {
+      m_Current.instances += record.Read<DrawElementsIndirectCommand>().instanceCount;
+    }
+    break;
+  }
+  default:
+    break;
+  }
+}
+
+void TraceAnalyzer::ChangeState(std::uint64_t key, std::uint32_t value, bool issued)
+{
+  ++m_Current.stateChanges;
+  if (!ChangeBinding(m_Requested, key, value))
+  {
+    ++m_Current.redundantStateChanges;
+  }
+
+  if (issued)
+  {
+    ++m_Current.issuedStateChanges;
+    if (!ChangeBinding(m_Issued, key, value))
+    {
+      ++m_Current.redundantIssuedStateChanges;
+    }
+  }
+}
+
+bool TraceAnalyzer::ChangeBinding(std::map<std::uint64_t, std::uint32_t>& bindings, std::uint64_t key, std::uint32_t value)
+{
+  auto it = bindings.find(key);
+  if (it != std::end(bindings) && it->second == value)
+  {
+    return false;
+  }
+
+  bindings[key] = value;
+  if (key == BindingKey(BindingKind::VERTEX_ARRAY))
+  {
+    // element array binding is vertex array state
+    bindings.erase(BindingKey(BindingKind::BUFFER, GL_ELEMENT_ARRAY_BUFFER));
+  }
+  return true;
+}
+
+std::vector<TraceAnalyzer::FrameStatistics> TraceAnalyzer::GetFrames() const
+{
+  std::vector<FrameStatistics> frames{ m_Frames };
+  if (m_Current.calls || m_Current.draws || m_Current.stateChanges)
+  {
+    frames.push_back(m_Current);
+  }
+  return frames;
+}
+
+std::vector<TraceAnalyzer::CallSite> TraceAnalyzer::GetCallSites() const
+{
+  std::vector<CallSite> callSites{};
+  for (const auto& callSite : m_CallSites)
+  {
+    callSites.push_back(callSite.second);
+  }
+
+  std::sort(
+    std::begin(callSites),
+    std::end(callSites),
+    [](const CallSite& lhs, const CallSite& rhs) -> bool
+    {
+      return lhs.count > rhs.count;
+    }
+  );
+  return callSites;
+}
+
+void TraceAnalyzer::Report(bool perFrame, std::size_t topCallSites) const
+{
+  std::vector<FrameStatistics> frames = GetFrames();
+
+  FrameStatistics total{};
+  for (std::size_t i = 0; i < frames.size(); ++i)
+  {
+    const FrameStatistics& frame = frames[i];
+    total.calls                       += frame.calls;
+    total.draws                       += frame.draws;
+    total.instances                   += frame.instances;
+    total.indirectCommands            += frame.indirectCommands;
+    total.stateChanges                += frame.stateChanges;
+    total.redundantStateChanges       += frame.redundantStateChanges;
+    total.issuedStateChanges          += frame.issuedStateChanges;
+    total.redundantIssuedStateChanges += frame.redundantIssuedStateChanges;
+    total.uniforms                    += frame.uniforms;
+    total.redundantUniforms           += frame.redundantUniforms;
+    total.bufferUploadBytes           += frame.bufferUploadBytes;
+    total.textureUploadBytes          += frame.textureUploadBytes;
+
+    if (perFrame)
+    {
+      Logger::Instance(std::cout).Log() << "[TRACE] frame " << i
+                                        << " calls: " << frame.calls
+                                        << " draws: " << frame.draws
+                                        << " state: " << frame.stateChanges << " (" << frame.redundantStateChanges << " redundant, "
+                                        << frame.issuedStateChanges << " reached GL)"
+                                        << " uniforms: " << frame.uniforms << " (" << frame.redundantUniforms << " redundant)"
+                                        << " upload: " << (frame.bufferUploadBytes + frame.textureUploadBytes) << " B";
+    }
+  }
+
+  std::size_t frameCount = std::max<std::size_t>(frames.size(), 1);
+  Logger::Instance(std::cout).Log() << "[TRACE] frames : " << frames.size();
+  Logger::Instance(std::cout).Log() << "[TRACE] calls / frame : " << total.calls / frameCount << " (" << total.calls << " total)";
+  Logger::Instance(std::cout).Log() << "[TRACE] draws / frame : " << total.draws / frameCount << ", instances : " << total.instances
+                                    << ", multi-draw indirect commands : " << total.indirectCommands;
+  Logger::Instance(std::cout).Log() << "[TRACE] state changes requested / frame : " << total.stateChanges / frameCount
+                                    << ", redundant : " << total.redundantStateChanges << " of " << total.stateChanges;
+  Logger::Instance(std::cout).Log() << "[TRACE] state changes reaching GL / frame : " << total.issuedStateChanges / frameCount
+                                    << ", redundant : " << total.redundantIssuedStateChanges << " of " << total.issuedStateChanges;
+  Logger::Instance(std::cout).Log() << "[TRACE] uniform updates / frame : " << total.uniforms / frameCount
+                                    << ", redundant : " << total.redundantUniforms << " of " << total.uniforms;
+  Logger::Instance(std::cout).Log() << "[TRACE] uploaded : " << total.bufferUploadBytes << " B buffer, " << total.textureUploadBytes << " B texture";
+
+  std::vector<CallSite> callSites = GetCallSites();
+  if (!callSites.empty())
+  {
+    Logger::Instance(std::cout).Log() << "[TRACE] top CALL sites (expression text only, not replayed) :";
+  }
+  for (std::size_t i = 0; i < std::min(topCallSites, callSites.size()); ++i)
+  {
+    const CallSite& callSite = callSites[i];
+    Logger::Instance(std::cout).Log() << "[TRACE] " << std::setw(10) << callSite.count << "  " << callSite.text << "  (" << callSite.file << ":" << callSite.line << ")";
+  }
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <map>
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+#include "Trace/TraceReader.h"
+
+// headless pass over a capture, no GL context required
+class TraceAnalyzer {
+public:
+  struct FrameStatistics {
+    std::size_t calls                 = 0;
+    std::size_t draws                 = 0;
+    std::size_t instances             = 0;
+    std::size_t indirectCommands      = 0;
+    // binds as requested from GLStateCache, and the subset that reached GL
+    std::size_t stateChanges                = 0;
+    std::size_t redundantStateChanges       = 0;
+    std::size_t issuedStateChanges          = 0;
+    std::size_t redundantIssuedStateChanges = 0;
+    std::size_t uniforms              = 0;
+    std::size_t redundantUniforms     = 0;
+    std::size_t bufferUploadBytes     = 0;
+    std::size_t textureUploadBytes    = 0;
+  };
+
+  struct CallSite {
+    std::string text{};
+    std::string file{};
+    int line          = 0;
+    std::size_t count = 0;
+  };
+
+  void Process(TraceRecord& record);
+
+  // frame statistics of all completed frames, anything after the last frame marker is reported as a trailing frame
+  std::vector<FrameStatistics> GetFrames() const;
+  std::vector<CallSite> GetCallSites() const;
+
+  void Report(bool perFrame, std::size_t topCallSites = TraceAnalyzer::defaultTopCallSites) const;
+
+private:
+  void ChangeState(std::uint64_t key, std::uint32_t value, bool issued);
+  static bool ChangeBinding(std::map<std::uint64_t, std::uint32_t>& bindings, std::uint64_t key, std::uint32_t value);
+
+  static constexpr std::size_t defaultTopCallSites = 10;
+
+  std::vector<FrameStatistics> m_Frames{};
+  FrameStatistics m_Current{};
+  std::map<std::uint32_t, CallSite> m_CallSites{};
+
+  // shadows keyed by binding point, of every requested bind and of the binds that reached GL
+  std::map<std::uint64_t, std::uint32_t> m_Requested{};
+  std::map<std::uint64_t, std::uint32_t> m_Issued{};
+  std::uint32_t m_Program = 0;
+  std::map<std::pair<std::uint32_t, std::uint32_t>, std::vector<unsigned char>> m_Uniforms{};
+};
@@ -0,0 +1,448 @@
+#include "TraceReplayer.h"
+
+#include <algorithm>
+#include <sstream>
+#include <iostream>
+
+#include <GL/glew.h>
+#include <GLFW/glfw3.h>
+
+#include "Core/Core.h"
+#include "Core/Draw.h"
+#include "Core/Window.h"
+
+#include "Logging/Logger.h"
+
+TraceReplayer::TraceReplayer(Window& window) :
+  m_Window{ window }
+{
+  // the capture does not record fixed function state, match the Sandbox defaults
+  CALL(glEnable(GL_DEPTH_TEST));
+  m_FrameStart = glfwGetTime();
+}
+
+TraceReplayer::~TraceReplayer()
+{
+  Dispose();
+}
+
+void TraceReplayer::Process(TraceRecord& record)
+{
+  switch (record.type)
+  {
+  case TraceRecordType::FRAME:
+  {
+    CALL(glFinish());
+    double now = glfwGetTime();
+    m_FrameTimes.push_back((now - m_FrameStart) * 1000.0);
+    m_FrameStart = now;
+
+    CheckFrameErrors();
+    m_Window.SwapBuffers();
+    glfwPollEvents();
+    break;
+  }
+  case TraceRecordType::USE_PROGRAM:
+  case TraceRecordType::BIND_VERTEX_ARRAY:
+  case TraceRecordType::BIND_BUFFER:
+  case TraceRecordType::ACTIVE_TEXTURE:
+  case TraceRecordType::BIND_TEXTURE:
+  case TraceRecordType::BIND_SAMPLER:
+    // binds the state cache skipped are only there for analysis
+    if (record.Read<std::uint8_t>())
+    {
+      Bind(record);
+    }
+    break;
+  case TraceRecordType::BUFFER_DATA:
+  {
+    unsigned int buffer = MapBuffer(record.Read<std::uint32_t>());
+    record.Read<std::uint32_t>();
+    unsigned int usage  = record.Read<std::uint32_t>();
+    std::size_t  size   = static_cast<std::size_t>(record.Read<std::uint64_t>());
+    bool hasData        = record.Read<std::uint8_t>() != 0;
+
+    // uploaded through the copy target so no recorded binding is disturbed
+    int previous = 0;
+    CALL(glGetIntegerv(GL_COPY_WRITE_BUFFER_BINDING, &previous));
+    CALL(glBindBuffer(GL_COPY_WRITE_BUFFER, buffer));
+    CALL(glBufferData(GL_COPY_WRITE_BUFFER, size, hasData ? record.ReadBytes(size) : nullptr, usage));
+    CALL(glBindBuffer(GL_COPY_WRITE_BUFFER, previous));
+    break;
+  }
+  case TraceRecordType::TEXTURE_STORAGE:
+  {
+    std::uint32_t capture       = record.Read<std::uint32_t>();
+    unsigned int target         = record.Read<std::uint32_t>();
+    int levels                  = record.Read<std::int32_t>();
+    unsigned int internalFormat = record.Read<std::uint32_t>();
+    int width                   = record.Read<std::int32_t>();
+    int height                  = record.Read<std::int32_t>();
+
+    unsigned int texture = 0;
+    CALL(glGenTextures(1, &texture));
+    m_Textures[capture]       = texture;
+    m_TextureTargets[capture] = target;
+
+    int previous = 0;
+    CALL(glGetIntegerv(TextureBindingQuery(target), &previous));
+    CALL(glBindTexture(target, texture));
+    CALL(glTexStorage2D(target, levels, internalFormat, width, height));
+    CALL(glBindTexture(target, previous));
+    break;
+  }
+  case TraceRecordType::TEXTURE_LEVEL:
+  {
+    std::uint32_t capture = record.Read<std::uint32_t>();
+    int level             = record.Read<std::int32_t>();
+    int width             = record.Read<std::int32_t>();
+    int height            = record.Read<std::int32_t>();
+    unsigned int format   = record.Read<std::uint32_t>();
+    unsigned int dataType = record.Read<std::uint32_t>();
+    std::size_t size      = static_cast<std::size_t>(record.Read<std::uint64_t>());
+    if (!size)
+    {
+      break;
+    }
+
+    unsigned int target = m_TextureTargets.at(capture);
+    int previous = 0;
+    CALL(glGetIntegerv(TextureBindingQuery(target), &previous));
+    CALL(glBindTexture(target, MapTexture(capture)));
+    CALL(glPixelStorei(GL_UNPACK_ALIGNMENT, 1));
+    CALL(glTexSubImage2D(target, level, 0, 0, width, height, format, dataType, record.ReadBytes(size)));
+    CALL(glPixelStorei(GL_UNPACK_ALIGNMENT, 4));
+    CALL(glBindTexture(target, previous));
+    break;
+  }
+  case TraceRecordType::GENERATE_MIPMAP:
+  {
+    std::uint32_t capture = record.Read<std::uint32_t>();
+    unsigned int target = m_TextureTargets.at(capture);
+    int previous = 0;
+    CALL(glGetIntegerv(TextureBindingQuery(target), &previous));
+    CALL(glBindTexture(target, MapTexture(capture)));
+    CALL(glGenerateMipmap(target));
+    CALL(glBindTexture(target, previous));
+    break;
+  }
+  case TraceRecordType::SAMPLER:
+  {
+    std::uint32_t capture = record.Read<std::uint32_t>();
+    std::uint32_t count   = record.Read<std::uint32_t>();
+
+    unsigned int sampler = 0;
+    CALL(glGenSamplers(1, &sampler));
+    for (std::uint32_t i = 0; i < count; ++i)
+    {
+      int parameter = record.Read<std::int32_t>();
+      int value     = record.Read<std::int32_t>();
+      CALL(glSamplerParameteri(sampler, parameter, value));
+    }
+    m_Samplers[capture] = sampler;
+    break;
+  }
+  case TraceRecordType::SHADER_SOURCE:
+  {
+    std::uint32_t capture = record.Read<std::uint32_t>();
+    unsigned int type     = record.Read<std::uint32_t>();
+    std::string source    = record.ReadString();
+    const char* csource   = source.c_str();
+
+    CALL(unsigned int shader = glCreateShader(type));
+    CALL(glShaderSource(shader, 1, &csource, nullptr));
+    CALL(glCompileShader(shader));
+    m_Shaders[capture] = shader;
+    break;
+  }
+  case TraceRecordType::PROGRAM_LINK:
+  {
+    std::uint32_t capture = record.Read<std::uint32_t>();
+    std::uint32_t count   = record.Read<std::uint32_t>();
+
+    CALL(unsigned int program = glCreateProgram());
+    for (std::uint32_t i = 0; i < count; ++i)
+    {
+      CALL(glAttachShader(program, m_Shaders.at(record.Read<std::uint32_t>())));
+    }
+    CALL(glLinkProgram(program));
+
+    int linkStatus = 0;
+    CALL(glGetProgramiv(program, GL_LINK_STATUS, &linkStatus));
+    if (linkStatus == GL_FALSE)
+    {
+      std::ostringstream outStream{};
+      outStream << "[ERROR::TRACE] Could not link replayed program " << capture;
+      throw std::exception{ outStream.str().c_str() };
+    }
+    m_Programs[capture] = program;
+    break;
+  }
+  case TraceRecordType::VERTEX_ATTRIBUTE:
+  {
+    unsigned int vertexArray = MapVertexArray(record.Read<std::uint32_t>());
+    unsigned int location    = record.Read<std::uint32_t>();
+    std::uint32_t buffer     = record.Read<std::uint32_t>();
+    std::int64_t offset      = record.Read<std::int64_t>();
+    int stride               = record.Read<std::int32_t>();
+    int size                 = record.Read<std::int32_t>();
+    unsigned int type        = record.Read<std::uint32_t>();
+    bool normalized          = record.Read<std::uint8_t>() != 0;
+    bool integer             = record.Read<std::uint8_t>() != 0;
+    unsigned int divisor     = record.Read<std::uint32_t>();
+    if (!buffer)
+    {
+      break;
+    }
+
+    int previousVertexArray = 0;
+    int previousBuffer      = 0;
+    CALL(glGetIntegerv(GL_VERTEX_ARRAY_BINDING, &previousVertexArray));
+    CALL(glGetIntegerv(GL_ARRAY_BUFFER_BINDING, &previousBuffer));
+
+    const void* pointer = reinterpret_cast<const void*>(offset);
+    CALL(glBindVertexArray(vertexArray));
+    CALL(glBindBuffer(GL_ARRAY_BUFFER, MapBuffer(buffer)));
+    if (integer)
+    {
+      CALL(glVertexAttribIPointer(location, size, type, stride, pointer));
+    }
+    else
+    {
+      CALL(glVertexAttribPointer(location, size, type, normalized ? GL_TRUE : GL_FALSE, stride, pointer));
+    }
+    CALL(glVertexAttribDivisor(location, divisor));
+    CALL(glEnableVertexAttribArray(location));
+
+    CALL(glBindBuffer(GL_ARRAY_BUFFER, previousBuffer));
+    CALL(glBindVertexArray(previousVertexArray));
+    break;
+  }
+  case TraceRecordType::INDEX_BUFFER:
+  {
+    unsigned int vertexArray = MapVertexArray(record.Read<std::uint32_t>());
+    unsigned int buffer      = MapBuffer(record.Read<std::uint32_t>());
+
+    int previous = 0;
+    CALL(glGetIntegerv(GL_VERTEX_ARRAY_BINDING, &previous));
+    CALL(glBindVertexArray(vertexArray));
+    CALL(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, buffer));
+    CALL(glBindVertexArray(previous));
+    break;
+  }
+  case TraceRecordType::UNIFORM:
+  {
+    int location          = static_cast<int>(record.Read<std::uint32_t>());
+    TraceUniformType type = record.Read<TraceUniformType>();
+    int count             = record.Read<std::int32_t>();
+    const void* value     = record.ReadBytes(record.payload.size() - record.cursor);
+
+    switch (type)
+    {
+    case TraceUniformType::INT:            CALL(glUniform1iv(location, count, static_cast<const int*>(value)));                     break;
+    case TraceUniformType::FLOAT:          CALL(glUniform1fv(location, count, static_cast<const float*>(value)));                   break;
+    case TraceUniformType::VEC3:           CALL(glUniform3fv(location, count, static_cast<const float*>(value)));                   break;
+    case TraceUniformType::MAT4:           CALL(glUniformMatrix4fv(location, count, GL_FALSE, static_cast<const float*>(value)));   break;
+    case TraceUniformType::MAT4_TRANSPOSE: CALL(glUniformMatrix4fv(location, count, GL_TRUE, static_cast<const float*>(value)));    break;
+    }
+    break;
+  }
+  case TraceRecordType::DRAW:
+  {
+    unsigned int mode         = record.Read<std::uint32_t>();
+    int first                 = record.Read<std::int32_t>();
+    int count                 = record.Read<std::int32_t>();
+    unsigned int indexType    = record.Read<std::uint32_t>();
+    const void* indices       = reinterpret_cast<const void*>(record.Read<std::int64_t>());
+    int instances             = record.Read<std::int32_t>();
+    int baseVertex            = record.Read<std::int32_t>();
+    unsigned int baseInstance = record.Read<std::uint32_t>();
+
+    if (indexType && baseInstance)
+    {
+      CALL(glDrawElementsInstancedBaseVertexBaseInstance(mode, count, indexType, indices, instances, baseVertex, baseInstance));
+    }
+    else if (indexType)
+    {
+      CALL(glDrawElementsInstancedBaseVertex(mode, count, indexType, indices, instances, baseVertex));
+    }
+    else
+    {
+      CALL(glDrawArraysInstanced(mode, first, count, instances));
+    }
+    break;
+  }
+  case TraceRecordType::MULTI_DRAW_INDIRECT:
+  {
+    unsigned int mode       = record.Read<std::uint32_t>();
+    unsigned int indexType  = record.Read<std::uint32_t>();
+    int drawCount           = record.Read<std::int32_t>();
+    const void* indirect    = reinterpret_cast<const void*>(record.Read<std::int64_t>());
+
+    // the commands were uploaded by a captured BUFFER_DATA and the indirect buffer bound by a captured bind,
+    // one call keeps gl_DrawID and the per command baseInstance exactly as the capture issued them
+    CALL(glMultiDrawElementsIndirect(mode, indexType, indirect, drawCount, sizeof(DrawElementsIndirectCommand)));
+    break;
+  }
+  default:
+    break;
+  }
+}
+
+void TraceReplayer::Bind(TraceRecord& record)
+{
+  switch (record.type)
+  {
+  case TraceRecordType::USE_PROGRAM:
+    CALL(glUseProgram(MapProgram(record.Read<std::uint32_t>())));
+    break;
+  case TraceRecordType::BIND_VERTEX_ARRAY:
+    CALL(glBindVertexArray(MapVertexArray(record.Read<std::uint32_t>())));
+    break;
+  case TraceRecordType::BIND_BUFFER:
+  {
+    unsigned int target = record.Read<std::uint32_t>();
+    CALL(glBindBuffer(target, MapBuffer(record.Read<std::uint32_t>())));
+    break;
+  }
+  case TraceRecordType::ACTIVE_TEXTURE:
+    CALL(glActiveTexture(GL_TEXTURE0 + record.Read<std::uint32_t>()));
+    break;
+  case TraceRecordType::BIND_TEXTURE:
+  {
+    // issued binds go to the active unit, the recorded unit only keys the analysis
+    record.Read<std::uint32_t>();
+    unsigned int target = record.Read<std::uint32_t>();
+    CALL(glBindTexture(target, MapTexture(record.Read<std::uint32_t>())));
+    break;
+  }
+  case TraceRecordType::BIND_SAMPLER:
+  {
+    unsigned int unit = record.Read<std::uint32_t>();
+    CALL(glBindSampler(unit, MapSampler(record.Read<std::uint32_t>())));
+    break;
+  }
+  default:
+    break;
+  }
+}
+
+void TraceReplayer::Report() const
+{
+  if (m_FrameTimes.empty())
+  {
+    return;
+  }
+
+  std::vector<double> sorted{ m_FrameTimes };
+  std::sort(std::begin(sorted), std::end(sorted));
+
+  double sum = 0.0;
+  for (double time : sorted)
+  {
+    sum += time;
+  }
+
+  Logger::Instance(std::cout).Log() << "[TRACE] replay frame ms, avg: " << sum / sorted.size()
+                                    << " median: " << sorted[sorted.size() / 2]
+                                    << " max: " << sorted.back();
+}
+
+void TraceReplayer::Dispose()
+{
+  for (const auto& program : m_Programs)
+  {
+    CALL(glDeleteProgram(program.second));
+  }
+  for (const auto& shader : m_Shaders)
+  {
+    CALL(glDeleteShader(shader.second));
+  }
+  for (const auto& sampler : m_Samplers)
+  {
+    CALL(glDeleteSamplers(1, &sampler.second));
+  }
+  for (const auto& texture : m_Textures)
+  {
+    CALL(glDeleteTextures(1, &texture.second));
+  }
+  for (const auto& vertexArray : m_VertexArrays)
+  {
+    CALL(glDeleteVertexArrays(1, &vertexArray.second));
+  }
+  for (const auto& buffer : m_Buffers)
+  {
+    CALL(glDeleteBuffers(1, &buffer.second));
+  }
+
+  m_Programs.clear();
+  m_Shaders.clear();
+  m_Samplers.clear();
+  m_Textures.clear();
+  m_TextureTargets.clear();
+  m_VertexArrays.clear();
+  m_Buffers.clear();
+}
+
+unsigned int TraceReplayer::MapBuffer(std::uint32_t capture)
+{
+  if (!capture)
+  {
+    return 0;
+  }
+
+  auto it = m_Buffers.find(capture);
+  if (it == std::end(m_Buffers))
+  {
+    unsigned int buffer = 0;
+    CALL(glGenBuffers(1, &buffer));
+    it = m_Buffers.emplace(capture, buffer).first;
+  }
+  return it->second;
+}
+
+unsigned int TraceReplayer::MapVertexArray(std::uint32_t capture)
+{
+  if (!capture)
+  {
+    return 0;
+  }
+
+  auto it = m_VertexArrays.find(capture);
+  if (it == std::end(m_VertexArrays))
+  {
+    unsigned int vertexArray = 0;
+    CALL(glGenVertexArrays(1, &vertexArray));
+    it = m_VertexArrays.emplace(capture, vertexArray).first;
+  }
+  return it->second;
+}
+
+unsigned int TraceReplayer::MapTexture(std::uint32_t capture) const
+{
+  auto it = m_Textures.find(capture);
+  return it == std::end(m_Textures) ? 0 : it->second;
+}
+
+unsigned int TraceReplayer::MapProgram(std::uint32_t capture) const
+{
+  auto it = m_Programs.find(capture);
+  return it == std::end(m_Programs) ? 0 : it->second;
+}
+
+unsigned int TraceReplayer::MapSampler(std::uint32_t capture) const
+{
+  auto it = m_Samplers.find(capture);
+  return it == std::end(m_Samplers) ? 0 : it->second;
+}
+
+unsigned int TraceReplayer::TextureBindingQuery(unsigned int target)
+{
+  switch (target)
+  {
+  case GL_TEXTURE_CUBE_MAP:   return GL_TEXTURE_BINDING_CUBE_MAP;
+  case GL_TEXTURE_3D:         return GL_TEXTURE_BINDING_3D;
+  case GL_TEXTURE_2D_ARRAY:   return GL_TEXTURE_BINDING_2D_ARRAY;
+  default:                    return GL_TEXTURE_BINDING_2D;
+  }
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <unordered_map>
+
+#include "Trace/TraceReader.h"
+
+class Window;
+
+// re-executes the typed records of a capture against the current context, CALL site records carry no arguments and are skipped,
+// capture object names are mapped to names created on replay
+class TraceReplayer {
+public:
+  TraceReplayer(Window& window);
+  ~TraceReplayer();
+
+  void Process(TraceRecord& record);
+
+  inline const std::vector<double>& GetFrameTimes() const {
+    return m_FrameTimes;
+  }
+
+  void Report() const;
+
+  void Dispose();
+
+  TraceReplayer(const TraceReplayer&) = delete;
+  TraceReplayer& operator=(const TraceReplayer&) = delete;
+
+private:
+  void Bind(TraceRecord& record);
+
+  unsigned int MapBuffer(std::uint32_t capture);
+  unsigned int MapVertexArray(std::uint32_t capture);
+  unsigned int MapTexture(std::uint32_t capture) const;
+  unsigned int MapProgram(std::uint32_t capture) const;
+  unsigned int MapSampler(std::uint32_t capture) const;
+
+  static unsigned int TextureBindingQuery(unsigned int target);
+
+  Window& m_Window;
+  double m_FrameStart = 0.0;
+  std::vector<double> m_FrameTimes{};
+
+  std::unordered_map<std::uint32_t, unsigned int> m_Buffers{};
+  std::unordered_map<std::uint32_t, unsigned int> m_VertexArrays{};
+  std::unordered_map<std::uint32_t, unsigned int> m_Textures{};
+  std::unordered_map<std::uint32_t, unsigned int> m_TextureTargets{};
+  std::unordered_map<std::uint32_t, unsigned int> m_Samplers{};
+  std::unordered_map<std::uint32_t, unsigned int> m_Shaders{};
+  std::unordered_map<std::uint32_t, unsigned int> m_Programs{};
+};